@@ -0,0 +1,172 @@
+#pragma once
+
+#include <chrono>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include <fmt/format.h>
+#include <rll/stdint.h>
+#include <rll/global/platform_definitions.h>
+
+#if defined(RLL_ARCH_X86_64) || defined(RLL_ARCH_X86_32)
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  else
+#    include <x86intrin.h>
+#  endif
+#  define RLL_BENCH_TSC
+#endif
+
+namespace rll::bench {
+  /**
+   * @brief Reads the time stamp counter.
+   * @details Counts reference cycles at a constant rate on current x86 CPUs, so cycles per byte are
+   * comparable across runs on one machine, but not across turbo settings. Returns `0` where no
+   * counter is available.
+   */
+  [[nodiscard]] inline u64 cycles() noexcept {
+#if defined(RLL_BENCH_TSC)
+    return __rdtsc();
+#else
+    return 0;
+#endif
+  }
+
+  /**
+   * @brief Keeps the compiler from discarding the computation of @p value.
+   */
+  template <typename T>
+  inline void keep(T const& value) noexcept {
+#if defined(_MSC_VER)
+    auto volatile sink = reinterpret_cast<char const volatile*>(&value);  // NOLINT
+    static_cast<void>(sink);
+#else
+    asm volatile("" : : "r,m"(value) : "memory");
+#endif
+  }
+
+  struct measurement {
+    std::string suite;
+    std::string name;
+    std::string mode;
+    u64 size = 0;        ///< Message size in bytes.
+    u64 bytes = 0;       ///< Bytes processed per iteration.
+    u64 iterations = 0;  ///< Iterations in the fastest sample.
+    f64 seconds = 0;     ///< Duration of the fastest sample.
+    u64 cycles = 0;      ///< Time stamp counter ticks of the fastest sample.
+
+    [[nodiscard]] f64 gigabytes_per_second() const noexcept {
+      return seconds > 0 ? static_cast<f64>(bytes * iterations) / seconds / 1e9 : 0.0;
+    }
+
+    [[nodiscard]] f64 cycles_per_byte() const noexcept {
+      auto const total = bytes * iterations;
+      return total > 0 ? static_cast<f64>(cycles) / static_cast<f64>(total) : 0.0;
+    }
+  };
+
+  struct options {
+    std::chrono::duration<f64> min_time {0.25};  ///< Minimum duration of each measurement.
+    std::size_t samples = 5;                     ///< Samples per measurement; the fastest counts.
+    u64 max_size = u64(64) << 20;                ///< Largest message size.
+    std::string filter;                          ///< Only run names containing this string.
+  };
+
+  class runner {
+   public:
+    explicit runner(options opts)
+      : options_(std::move(opts)) {}
+
+    [[nodiscard]] options const& opts() const noexcept { return this->options_; }
+
+    [[nodiscard]] std::vector<measurement> const& results() const noexcept {
+      return this->results_;
+    }
+
+    [[nodiscard]] bool enabled(std::string_view const name) const noexcept {
+      return this->options_.filter.empty()
+          or name.find(this->options_.filter) != std::string_view::npos;
+    }
+
+    /**
+     * @brief Measures @p fn, which processes @p bytes bytes per call.
+     * @details The iteration count is doubled until one sample takes `min_time / samples`; the
+     * fastest of `samples` samples is recorded.
+     */
+    template <typename F>
+    void measure(
+      std::string_view const suite,
+      std::string_view const name,
+      std::string_view const mode,
+      u64 const size,
+      u64 const bytes,
+      F&& fn
+    ) {
+      if(not this->enabled(name))
+        return;
+      using clock = std::chrono::steady_clock;
+      auto const target = this->options_.min_time / static_cast<f64>(this->options_.samples);
+      auto res = measurement();
+      res.suite = suite;
+      res.name = name;
+      res.mode = mode;
+      res.size = size;
+      res.bytes = bytes;
+      auto iterations = u64(1);
+      for(;;) {
+        auto const start = clock::now();
+        for(auto i = u64(0); i < iterations; i++)
+          fn();
+        if(clock::now() - start >= target or iterations >= (u64(1) << 40))
+          break;
+        iterations *= 2;
+      }
+
+      res.iterations = iterations;
+      res.seconds = std::numeric_limits<f64>::max();
+      for(auto sample = std::size_t(0); sample < this->options_.samples; sample++) {
+        auto const start = clock::now();
+        auto const start_cycles = cycles();
+        for(auto i = u64(0); i < iterations; i++)
+          fn();
+        auto const elapsed_cycles = cycles() - start_cycles;
+        auto const elapsed = std::chrono::duration<f64>(clock::now() - start).count();
+        if(elapsed < res.seconds) {
+          res.seconds = elapsed;
+          res.cycles = elapsed_cycles;
+        }
+      }
+      fmt::print(
+        stderr,
+        "{:<10} {:<14} {:<12} {:>10} B {:>9.3f} GB/s {:>8.2f} cycles/B\n",
+        res.suite,
+        res.name,
+        res.mode,
+        res.size,
+        res.gigabytes_per_second(),
+        res.cycles_per_byte()
+      );
+      this->results_.push_back(std::move(res));
+    }
+
+   private:
+    options options_;
+    std::vector<measurement> results_;
+  };
+
+  /**
+   * @brief Message sizes from 16 B to @p max_size in steps of four.
+   */
+  [[nodiscard]] inline std::vector<u64> message_sizes(u64 const max_size) {
+    auto res = std::vector<u64>();
+    for(auto size = u64(16); size <= max_size; size *= 4)
+      res.push_back(size);
+    return res;
+  }
+
+  void crypto_suite(runner& run);
+  void uuid_suite(runner& run);
+  void string_suite(runner& run);
+}  // namespace rll::bench
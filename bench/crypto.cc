@@ -0,0 +1,71 @@
+#include "bench.h"
+
+#include <filesystem>
+#include <string>
+#include <rll/crypto.h>
+#include <rll/io/filedevice.h>
+
+namespace rll::bench {
+  void crypto_suite(runner& run) {
+    auto const sizes = message_sizes(run.opts().max_size);
+    auto data = std::string(sizes.back(), '\0');
+    for(auto i = std::size_t(0); i < data.size(); i++)
+      data[i] = static_cast<char>(i * 131 + (i >> 13));
+    auto const view = std::string_view(data);
+
+    // single stream
+    for(auto const size : sizes) {
+      auto const message = view.substr(0, size);
+      run.measure("crypto", "md5", "single", size, size, [&] {
+        auto hasher = crypto::md5_engine();
+        hasher.update(message.data(), message.size());
+        keep(hasher.hash());
+      });
+      run.measure("crypto", "sha1", "single", size, size, [&] {
+        auto hasher = crypto::sha1_engine();
+        hasher.update(message.data(), message.size());
+        keep(hasher.hash());
+      });
+      run.measure("crypto", "sha256", "single", size, size, [&] {
+        auto hasher = crypto::sha256_engine();
+        hasher.update(message.data(), message.size());
+        keep(hasher.hash());
+      });
+      run.measure("crypto", "crc32c", "single", size, size, [&] {
+        keep(crypto::crc32c::compute(message));
+      });
+      run.measure("crypto", "fast_hash64", "single", size, size, [&] {
+        keep(crypto::fast_hash64(message));
+      });
+    }
+
+    // multi-buffer: one full batch of equally sized messages per call
+    auto const lanes = crypto::md5_batch_lanes();
+    auto digests = std::vector<crypto::md5::digest_type>(lanes);
+    for(auto const size : sizes) {
+      auto const messages = std::vector<std::string_view>(lanes, view.substr(0, size));
+      run.measure("crypto", "md5", "multi_buffer", size, size * lanes, [&] {
+        crypto::md5_batch(messages.data(), digests.data(), messages.size());
+        keep(digests.front());
+      });
+    }
+
+    // file-backed: open, map and hash
+    if(not run.enabled("md5"))
+      return;
+    auto const path = std::filesystem::temp_directory_path() / "rolly-bench-crypto.bin";
+    for(auto const size : sizes) {
+      if(not io::filedevice(path).try_write(view.substr(0, size)))
+        break;
+      if(auto const probe = crypto::hash_file(path, crypto::hash_algorithm::md5); not probe) {
+        fmt::print(stderr, "rolly-bench: skipping file-backed md5: {}\n", probe.error());
+        break;
+      }
+      run.measure("crypto", "md5", "file", size, size, [&] {
+        keep(crypto::hash_file(path, crypto::hash_algorithm::md5).value().digest.front());
+      });
+    }
+    auto ec = std::error_code();
+    std::filesystem::remove(path, ec);
+  }
+}  // namespace rll::bench
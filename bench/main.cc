@@ -0,0 +1,138 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <fmt/format.h>
+#include <rll/global/version_definitions.h>
+
+#include "bench.h"
+
+namespace {
+  using namespace rll;
+
+  void print_usage() {
+    fmt::print(
+      stderr,
+      "usage: rolly-bench [options]\n"
+      "  --suite <name>      suite to run (crypto, uuid, string); all by default\n"
+      "  --filter <text>     only run benchmarks whose name contains <text>\n"
+      "  --max-size <bytes>  largest message size (default 67108864)\n"
+      "  --min-time <sec>    minimum time per measurement (default 0.25)\n"
+      "  --output <file>     write JSON to <file> instead of stdout\n"
+    );
+  }
+
+  std::string escape(std::string_view const str) {
+    auto res = std::string();
+    for(auto const c : str) {
+      if(c == '"' or c == '\\')
+        res.push_back('\\');
+      res.push_back(c);
+    }
+    return res;
+  }
+
+  std::string to_json(bench::runner const& run) {
+    auto out = fmt::memory_buffer();
+    auto it = std::back_inserter(out);
+    fmt::format_to(it, "{{\n  \"library\": \"rolly\",\n");
+    fmt::format_to(it, "  \"version\": \"{}\",\n", RLL_VERSION_STRING);
+    fmt::format_to(
+      it,
+      "  \"timestamp\": {},\n",
+      std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+      )
+        .count()
+    );
+    fmt::format_to(it, "  \"cycle_counter\": {},\n", bench::cycles() != 0);
+    fmt::format_to(it, "  \"results\": [");
+    auto first = true;
+    for(auto const& m : run.results()) {
+      fmt::format_to(
+        it,
+        "{}\n    {{\"suite\": \"{}\", \"name\": \"{}\", \"mode\": \"{}\", \"size\": {}, "
+        "\"bytes\": {}, \"iterations\": {}, \"seconds\": {:.9f}, \"cycles\": {}, "
+        "\"gb_per_s\": {:.4f}, \"cycles_per_byte\": {:.4f}}}",
+        first ? "" : ",",
+        escape(m.suite),
+        escape(m.name),
+        escape(m.mode),
+        m.size,
+        m.bytes,
+        m.iterations,
+        m.seconds,
+        m.cycles,
+        m.gigabytes_per_second(),
+        m.cycles_per_byte()
+      );
+      first = false;
+    }
+    fmt::format_to(it, "\n  ]\n}}\n");
+    return fmt::to_string(out);
+  }
+}  // namespace
+
+int main(int argc, char** argv) {
+  auto opts = bench::options();
+  auto suite = std::string_view();
+  auto output = std::string_view();
+  for(auto i = 1; i < argc; i++) {
+    auto const arg = std::string_view(argv[i]);  // NOLINT(*-pointer-arithmetic)
+    if(arg == "--help" or arg == "-h") {
+      print_usage();
+      return EXIT_SUCCESS;
+    }
+    if(i + 1 >= argc) {
+      print_usage();
+      return EXIT_FAILURE;
+    }
+    auto const* value = argv[++i];  // NOLINT(*-pointer-arithmetic)
+    if(arg == "--suite")
+      suite = value;
+    else if(arg == "--filter")
+      opts.filter = value;
+    else if(arg == "--max-size")
+      opts.max_size = std::strtoull(value, nullptr, 10);
+    else if(arg == "--min-time")
+      opts.min_time = std::chrono::duration<f64>(std::strtod(value, nullptr));
+    else if(arg == "--output")
+      output = value;
+    else {
+      print_usage();
+      return EXIT_FAILURE;
+    }
+  }
+  if(opts.max_size < 16) {
+    fmt::print(stderr, "rolly-bench: --max-size must be at least 16\n");
+    return EXIT_FAILURE;
+  }
+
+  if(not suite.empty() and suite != "crypto" and suite != "uuid" and suite != "string") {
+    fmt::print(stderr, "rolly-bench: unknown suite '{}'\n", suite);
+    return EXIT_FAILURE;
+  }
+  auto run = bench::runner(opts);
+  if(suite.empty() or suite == "crypto")
+    bench::crypto_suite(run);
+  if(suite.empty() or suite == "uuid")
+    bench::uuid_suite(run);
+  if(suite.empty() or suite == "string")
+    bench::string_suite(run);
+
+  auto const json = to_json(run);
+  if(output.empty()) {
+    fmt::print("{}", json);
+    return EXIT_SUCCESS;
+  }
+  auto* file = std::fopen(std::string(output).c_str(), "wb");
+  if(file == nullptr) {
+    fmt::print(stderr, "rolly-bench: can not open '{}'\n", output);
+    return EXIT_FAILURE;
+  }
+  fmt::print(file, "{}", json);
+  std::fclose(file);
+  return EXIT_SUCCESS;
+}
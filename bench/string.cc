@@ -0,0 +1,109 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <cctype>
+#include <string>
+#include <vector>
+#include <rll/string_pool.h>
+#include <rll/string_util.h>
+
+namespace rll::bench {
+  namespace {
+    /// Second field of a log line.
+    std::string_view sensor_name(std::string_view const line) {
+      auto fields = split_view(line, ',').begin();
+      return ++fields == split_view::iterator() ? std::string_view() : *fields;
+    }
+  }  // namespace
+
+  void string_suite(runner& run) {
+    // line-oriented sensor log: "<timestamp>,<sensor>,<value>,<value>\n"
+    auto log = std::string();
+    for(auto i = u64(0); log.size() < run.opts().max_size; i++)
+      log += fmt::format("{},sensor-{},{}.{},{}\n", 1700000000000 + i, i % 17, i % 1000, i % 7, i);
+    log.resize(run.opts().max_size);
+    auto const view = std::string_view(log);
+    auto pool = string_pool();
+
+    for(auto const size : message_sizes(run.opts().max_size)) {
+      auto const text = view.substr(0, size);
+      run.measure("string", "split_by", "vector", size, size, [&] {
+        auto fields = std::size_t();
+        for(auto const& line : split_by(text, '\n'))
+          fields += split_by(line, ',').size();
+        keep(fields);
+      });
+      run.measure("string", "split_by", "view", size, size, [&] {
+        auto fields = std::size_t();
+        for(auto const line : split_view(text, '\n'))
+          for(auto const field : split_view(line, ','))
+            fields += field.size();
+        keep(fields);
+      });
+      run.measure("string", "count", "simd", size, size, [&] { keep(count(text, '\n')); });
+      run.measure("string", "line_offsets", "simd", size, size, [&] {
+        keep(line_offsets(text).size());
+      });
+      run.measure("string", "line_offsets", "threads", size, size, [&] {
+        keep(line_offsets(text, 0).size());
+      });
+      run.measure("string", "find_first_of", "std", size, size, [&] {
+        keep(text.find_first_of("#|"));
+      });
+      run.measure("string", "find_first_of", "simd", size, size, [&] {
+        keep(find_first_of(text, "#|"));
+      });
+      run.measure("string", "to_lower", "std", size, size, [&] {
+        auto str = std::string(text);
+        std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+        keep(str.data());
+      });
+      run.measure("string", "to_lower", "simd", size, size, [&] { keep(to_lower(text).data()); });
+      run.measure("string", "iequals", "simd", size, size, [&] {
+        keep(iequals(text, view.substr(0, size)));
+      });
+      run.measure("string", "ihash", "simd", size, size, [&] { keep(ihash()(text)); });
+      run.measure("string", "names", "string", size, size, [&] {
+        auto names = std::vector<std::string>();
+        for(auto const line : split_view(text, '\n'))
+          names.emplace_back(sensor_name(line));
+        keep(names.data());
+      });
+      run.measure("string", "names", "pool", size, size, [&] {
+        auto names = std::vector<interned_string>();
+        for(auto const line : split_view(text, '\n'))
+          names.push_back(pool.intern(sensor_name(line)));
+        keep(names.data());
+      });
+      // re-emits every line as a tab-separated row with a derived column
+      run.measure("string", "rows", "format", size, size, [&] {
+        auto out = std::size_t(0);
+        for(auto const line : split_view(text, '\n')) {
+          auto row = std::string();
+          for(auto const& field : split_by(line, ','))
+            row += field + "\t";
+          row += fmt::format("{}\n", line.size());
+          out += row.size();
+        }
+        keep(out);
+      });
+      run.measure("string", "rows", "builder", size, size, [&] {
+        auto out = std::size_t(0);
+        auto row = string_builder();
+        for(auto const line : split_view(text, '\n')) {
+          row.clear();
+          row.join(split_view(line, ','), "\t").format_to("\t{}\n", line.size());
+          out += row.size();
+        }
+        keep(out);
+      });
+      run.measure("string", "split", "vector", size, size, [&] { keep(split(text).size()); });
+      run.measure("string", "split", "view", size, size, [&] {
+        auto words = std::size_t();
+        for(auto const word : whitespace_split_view(text))
+          words += word.size();
+        keep(words);
+      });
+    }
+  }
+}  // namespace rll::bench
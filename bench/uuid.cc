@@ -0,0 +1,84 @@
+#include "bench.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <rll/uuid.h>
+#include <rll/uuid_generator.h>
+#include <rll/uuid_map.h>
+
+namespace rll::bench {
+  namespace {
+    /// Fills a fresh map with @p keys, then looks up present and absent keys.
+    template <typename Map>
+    void map_benchmarks(
+      runner& run,
+      std::string_view const mode,
+      std::vector<uuid> const& keys,
+      std::vector<uuid> const& missing
+    ) {
+      auto const size = u64(keys.size() * sizeof(uuid));
+      run.measure("uuid", "map_insert", mode, size, size, [&] {
+        auto map = Map();
+        for(auto const& key : keys)
+          map[key] = 1;
+        keep(map.size());
+      });
+      auto map = Map();
+      for(auto const& key : keys)
+        map[key] = 1;
+      run.measure("uuid", "map_find", mode, size, size, [&] {
+        auto found = u64();
+        for(auto const& key : keys)
+          found += map.find(key)->second;
+        keep(found);
+      });
+      run.measure("uuid", "map_miss", mode, size, size, [&] {
+        auto found = std::size_t();
+        for(auto const& key : missing)
+          found += map.count(key);
+        keep(found);
+      });
+    }
+  }  // namespace
+
+  void uuid_suite(runner& run) {
+    constexpr auto count = std::size_t(1024);
+    constexpr auto length = uuid::short_guid_string_length;
+    constexpr auto bytes = u64(count * length);
+    auto const ids = uuid_generator(std::array<u8, 32>()).generate_n(count);
+    auto text = std::string(bytes, '\0');
+    auto parsed = std::vector<uuid>(count);
+
+    run.measure("uuid", "to_chars", "single", length, bytes, [&] {
+      auto* out = text.data();
+      for(auto const& id : ids)
+        out = id.to_chars(out);
+      keep(text.front());
+    });
+    run.measure("uuid", "to_chars", "batch", length, bytes, [&] {
+      uuid::to_chars_n(ids.data(), ids.size(), text.data());
+      keep(text.front());
+    });
+    run.measure("uuid", "to_string", "single", length, bytes, [&] {
+      for(auto const& id : ids)
+        keep(id.to_string());
+    });
+    run.measure("uuid", "from_chars", "single", length, bytes, [&] {
+      for(auto i = std::size_t(0); i < count; i++)
+        keep(uuid::from_chars(std::string_view(text).substr(i * length, length), parsed[i]));
+    });
+    run.measure("uuid", "from_chars", "batch", length, bytes, [&] {
+      keep(uuid::from_chars_n(text.data(), count, parsed.data()));
+    });
+
+    auto gen = uuid_generator(std::array<u8, 32>());
+    for(auto elements = std::size_t(1024); elements * sizeof(uuid) <= run.opts().max_size;
+        elements *= 16) {
+      auto const keys = gen.generate_n(elements);
+      auto const missing = gen.generate_n(elements);
+      map_benchmarks<uuid_map<u64>>(run, "uuid_map", keys, missing);
+      map_benchmarks<std::unordered_map<uuid, u64>>(run, "unordered_map", keys, missing);
+    }
+  }
+}  // namespace rll::bench
@@ -16,12 +16,14 @@ class RollyRecipe(ConanFile):
     options = {
         "shared": [True, False],
         "test": [True, False],
+        "bench": [True, False],
         "export": [True, False],
         "export_folder_name": ["ANY"],
     }
     default_options = {
         "shared": True,
         "test": False,
+        "bench": False,
         "export": False,
         "export_folder_name": "export",
     }
@@ -36,8 +38,6 @@ class RollyRecipe(ConanFile):
         self.requires("fmt/10.2.1", transitive_headers=True, transitive_libs=True)
         self.requires("spdlog/1.13.0", transitive_headers=True, transitive_libs=True)
         self.requires("ipaddress/1.1.0", transitive_headers=True, transitive_libs=True)
-        if self.settings.os != "Windows":
-            self.requires("libuuid/1.0.3")
         if self.options.test:
             self.requires("catch2/[=3.7.1]")
             self.requires(
@@ -61,6 +61,7 @@ class RollyRecipe(ConanFile):
         tc = CMakeToolchain(self)
         tc.cache_variables["BUILD_SHARED_LIBS"] = self.options.shared
         tc.cache_variables["ROLLY_TESTS"] = self.options.test
+        tc.cache_variables["ROLLY_BENCHMARKS"] = self.options.bench
         tc.generate()
 
         if self.options.export:
@@ -127,8 +128,10 @@ class RollyRecipe(ConanFile):
         self.cpp_info.set_property("cmake_target_name", "rolly::rolly")
         self.cpp_info.libs = ["rolly"]
         self.cpp_info.requires = ["fmt::fmt", "spdlog::spdlog", "ipaddress::ipaddress"]
-        if self.settings.os != "Windows":
-            self.cpp_info.requires.append("libuuid::libuuid")
+        if self.settings.os == "Windows":
+            self.cpp_info.system_libs.append("bcrypt")
+        if self.settings.os in ["Linux", "FreeBSD"]:
+            self.cpp_info.system_libs.append("pthread")
         if self.options.test:
             self.cpp_info.requires.append("catch2::catch2")
             self.cpp_info.requires.append("tomlplusplus::tomlplusplus")
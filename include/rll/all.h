@@ -6,6 +6,7 @@
 #include <rll/crypto.h>
 #include <rll/directories.h>
 #include <rll/fixed_string.h>
+#include <rll/inline_string.h>
 #include <rll/functional.h>
 #include <rll/global.h>
 #include <rll/library.h>
@@ -20,6 +21,7 @@
 #include <rll/serialization.h>
 #include <rll/source_location.h>
 #include <rll/stdint.h>
+#include <rll/string_pool.h>
 #include <rll/string_util.h>
 #include <rll/traits.h>
 #include <rll/type_traits.h>
@@ -27,3 +29,5 @@
 #include <rll/u128.h>
 #include <rll/utility.h>
 #include <rll/uuid.h>
+#include <rll/uuid_generator.h>
+#include <rll/uuid_map.h>
@@ -3,6 +3,7 @@
 #include <array>
 #include <algorithm>
 #include <cstdint>
+#include <limits>
 #include <rll/global.h>
 #include <rll/concepts/num.h>
 
@@ -131,6 +132,37 @@ namespace rll {
     return x + 1;
   }
 
+  /**
+   * @brief Returns the number of consecutive 0 bits, starting from the least significant bit.
+   * @details This is the backport of <tt>std::countr_zero</tt>.
+   * @tparam T Type of the value. Must be an unsigned integral type of at most 64 bits.
+   * @param x Value.
+   * @return The number of trailing 0 bits, or the width of @p T if the value is 0.
+   * @sa https://en.cppreference.com/w/cpp/numeric/countr_zero
+   */
+  template <typename T, typename = std::enable_if_t<std::is_unsigned_v<T>>>
+  [[nodiscard]] constexpr int countr_zero(T x) noexcept {
+    static_assert(sizeof(T) <= 8, "T must be at most 64 bits wide");
+    if(x == 0)
+      return std::numeric_limits<T>::digits;
+#if defined(RLL_COMPILER_MSVC)
+    auto index = 0UL;
+    if constexpr(sizeof(T) > 4) {
+      if(static_cast<std::uint32_t>(x) == 0) {
+        _BitScanForward(&index, static_cast<std::uint32_t>(static_cast<std::uint64_t>(x) >> 32U));
+        return static_cast<int>(index) + 32;
+      }
+    }
+    _BitScanForward(&index, static_cast<std::uint32_t>(x));
+    return static_cast<int>(index);
+#else
+    if constexpr(sizeof(T) > sizeof(unsigned))
+      return __builtin_ctzll(x);
+    else
+      return __builtin_ctz(x);
+#endif
+  }
+
   /**
    * @brief Endianness.
    * @details This is the backport of <tt>std::endian</tt>.
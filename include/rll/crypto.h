@@ -1,4 +1,13 @@
 #pragma once
 
 #include <rll/crypto/basic_hasher.h>
+#include <rll/crypto/constexpr_md5.h>
+#include <rll/crypto/crc.h>
+#include <rll/crypto/fast_hash.h>
+#include <rll/crypto/hash_file.h>
+#include <rll/crypto/hmac.h>
 #include <rll/crypto/md5.h>
+#include <rll/crypto/md5_batch.h>
+#include <rll/crypto/sha1.h>
+#include <rll/crypto/sha256.h>
+#include <rll/crypto/static_hasher.h>
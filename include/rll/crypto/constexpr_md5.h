@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <string_view>
+#include <rll/fixed_string.h>
+#include <rll/stdint.h>
+#include <rll/uuid.h>
+#include <rll/crypto/md5.h>
+
+namespace rll::crypto {
+  namespace detail {
+    // NOLINTBEGIN(*-magic-numbers)
+    inline constexpr std::array<u32, 64> md5_constants = {
+      0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613,
+      0xfd469501, 0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193,
+      0xa679438e, 0x49b40821, 0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d,
+      0x02441453, 0xd8a1e681, 0xe7d3fbc8, 0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed,
+      0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a, 0xfffa3942, 0x8771f681, 0x6d9d6122,
+      0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70, 0x289b7ec6, 0xeaa127fa,
+      0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665, 0xf4292244,
+      0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+      0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb,
+      0xeb86d391
+    };
+
+    inline constexpr std::array<u8, 16> md5_shifts = {
+      7, 12, 17, 22, 5, 9, 14, 20, 4, 11, 16, 23, 6, 10, 15, 21
+    };
+
+    /// Byte @p pos of the padded message: data, 0x80, zeros, little-endian bit length.
+    [[nodiscard]] constexpr ___inline___ u8 md5_padded_byte(
+      std::string_view const data,
+      std::size_t const pos,
+      std::size_t const total
+    ) {
+      if(pos < data.size())
+        return static_cast<u8>(data[pos]);
+      if(pos == data.size())
+        return 0x80;
+      if(auto const bits = static_cast<u64>(data.size()) * 8; pos >= total - 8)
+        return static_cast<u8>(bits >> (8 * (pos - (total - 8))));
+      return 0;
+    }
+
+    [[nodiscard]] constexpr ___inline___ md5::digest_type
+      md5_constexpr(std::string_view const data) {
+      auto state = std::array<u32, 4> {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+      auto const total = (data.size() + 8) / 64 * 64 + 64;
+      for(auto block = std::size_t(0); block < total; block += 64) {
+        auto words = std::array<u32, 16>();
+        for(auto i = std::size_t(0); i < 64; i++) {
+          auto const byte = static_cast<u32>(md5_padded_byte(data, block + i, total));
+          words[i / 4] |= byte << (8 * (i % 4));
+        }
+
+        auto a = state[0];
+        auto b = state[1];
+        auto c = state[2];
+        auto d = state[3];
+        for(auto i = std::size_t(0); i < 64; i++) {
+          auto f = u32();
+          auto g = std::size_t();
+          switch(i / 16) {
+            case 0: f = d ^ (b & (c ^ d)); g = i; break;
+            case 1: f = c ^ (d & (b ^ c)); g = (5 * i + 1) % 16; break;
+            case 2: f = b ^ c ^ d; g = (3 * i + 5) % 16; break;
+            default: f = c ^ (b | ~d); g = (7 * i) % 16; break;
+          }
+          auto const x = a + f + md5_constants[i] + words[g];
+          auto const s = md5_shifts[(i / 16) * 4 + i % 4];
+          a = d;
+          d = c;
+          c = b;
+          b += (x << s) | (x >> (32 - s));
+        }
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+      }
+
+      auto digest = md5::digest_type();
+      for(auto i = std::size_t(0); i < digest.size(); i++)
+        digest[i] = static_cast<u8>(state[i / 4] >> (8 * (i % 4)));
+      return digest;
+    }
+    // NOLINTEND(*-magic-numbers)
+  }  // namespace detail
+
+  /**
+   * @brief Computes the MD5 digest of a string at compile time.
+   * @details Gives the same digest as @ref md5. Intended for deriving stable identifiers from
+   * literals without any startup cost; use @ref md5 or @ref md5_engine for runtime data.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * constexpr auto id = rll::crypto::md5_uuid("telemetry.frame");
+   * switch(rll::crypto::md5_u64(name)) {
+   *   case rll::crypto::md5_u64("telemetry.frame"): break;
+   * }
+   * @endcode
+   * @param data String to hash.
+   * @return MD5 digest.
+   */
+  [[nodiscard]] constexpr ___inline___ md5::digest_type
+    md5_digest(std::string_view const data) {
+    return detail::md5_constexpr(data);
+  }
+
+  /**
+   * @brief Computes the MD5 digest of a string at compile time as @ref uuid.
+   * @details Equal to `md5::hash_uuid()` for the same input.
+   */
+  [[nodiscard]] constexpr ___inline___ uuid md5_uuid(std::string_view const data) {
+    return uuid(detail::md5_constexpr(data));
+  }
+
+  /**
+   * @brief First eight bytes of the MD5 digest as little-endian integer.
+   * @details Usable as `case` label and as non-type template argument.
+   */
+  [[nodiscard]] constexpr ___inline___ u64 md5_u64(std::string_view const data) {
+    auto const digest = detail::md5_constexpr(data);
+    auto res = u64();
+    for(auto i = std::size_t(0); i < sizeof(u64); i++)
+      res |= static_cast<u64>(digest[i]) << (8 * i);
+    return res;
+  }
+
+  /**
+   * @brief Computes the MD5 digest of a @ref fixed_string at compile time.
+   */
+  template <std::size_t N>
+  [[nodiscard]] constexpr ___inline___ md5::digest_type md5_digest(fixed_string<N> const& str) {
+    return md5_digest(std::string_view(str.data(), str.size()));
+  }
+
+  /**
+   * @brief Computes the MD5 digest of a @ref fixed_string at compile time as @ref uuid.
+   */
+  template <std::size_t N>
+  [[nodiscard]] constexpr ___inline___ uuid md5_uuid(fixed_string<N> const& str) {
+    return md5_uuid(std::string_view(str.data(), str.size()));
+  }
+
+  /**
+   * @brief First eight bytes of the MD5 digest of a @ref fixed_string.
+   */
+  template <std::size_t N>
+  [[nodiscard]] constexpr ___inline___ u64 md5_u64(fixed_string<N> const& str) {
+    return md5_u64(std::string_view(str.data(), str.size()));
+  }
+}  // namespace rll::crypto
+
+namespace rll {
+  inline namespace literals {
+    /**
+     * @brief Literal operator for compile-time MD5 uuids.
+     * @details `"name"_md5` is equal to `crypto::md5_uuid("name")`.
+     */
+    constexpr ___inline___ uuid operator""_md5(char const* str, std::size_t const size) {
+      return crypto::md5_uuid(std::string_view(str, size));
+    }
+  }  // namespace literals
+}  // namespace rll
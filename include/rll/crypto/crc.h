@@ -0,0 +1,144 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <rll/stdint.h>
+#include <rll/global/definitions.h>
+#include <rll/crypto/static_hasher.h>
+
+namespace rll::crypto {
+  /**
+   * @brief CRC-32C (Castagnoli) checksum.
+   * @details Streaming checksum for record framing and corruption detection. Uses the SSE4.2
+   * `crc32` instruction or the ARMv8 CRC extension when available, with three interleaved streams
+   * merged by carry-less multiplication (PCLMUL) for large buffers, and slicing-by-8 tables
+   * otherwise. Not suitable against deliberate tampering.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * auto crc = rll::crypto::crc32c();
+   * crc << header.size << std::string_view(payload);
+   * auto const checksum = crc.hash();
+   * @endcode
+   * @see crc64
+   */
+  class RLL_API crc32c : public static_hasher<crc32c> {
+   public:
+    using value_type = u32;
+
+    inline static constexpr std::size_t digest_size = sizeof(value_type);
+
+    constexpr ___inline___ crc32c() noexcept = default;
+
+    /**
+     * @brief Continues from a previously computed checksum.
+     */
+    constexpr ___inline___ explicit crc32c(value_type const crc) noexcept
+      : crc_(crc) {}
+
+    ___inline___ void update(char const* data, std::size_t const len) noexcept {
+      this->crc_ = crc32c::extend(this->crc_, data, len);
+    }
+
+    constexpr ___inline___ void reset() noexcept { this->crc_ = 0; }
+
+    [[nodiscard]] constexpr ___inline___ value_type hash() const noexcept { return this->crc_; }
+
+    /**
+     * @brief Returns the checksum as eight lowercase hex digits.
+     */
+    [[nodiscard]] std::string hash_string() const;
+
+    /**
+     * @brief Returns the checksum of the concatenation of the data hashed by @p crc and @p data.
+     */
+    [[nodiscard]] static value_type
+      extend(value_type crc, void const* data, std::size_t len) noexcept;
+
+    /**
+     * @brief Computes the checksum of @p data.
+     */
+    [[nodiscard]] static ___inline___ value_type compute(std::string_view const data) noexcept {
+      return crc32c::extend(0, data.data(), data.size());
+    }
+
+    /**
+     * @brief Combines checksums of two adjacent chunks.
+     * @details Allows chunks to be checksummed in parallel.
+     * @param crc_a Checksum of the first chunk.
+     * @param crc_b Checksum of the second chunk.
+     * @param len_b Length of the second chunk in bytes.
+     * @return Checksum of the first chunk followed by the second.
+     */
+    [[nodiscard]] static value_type
+      combine(value_type crc_a, value_type crc_b, u64 len_b) noexcept;
+
+    /**
+     * @brief Returns whether the hardware-accelerated implementation is used on this CPU.
+     */
+    [[nodiscard]] static bool accelerated() noexcept;
+
+   private:
+    value_type crc_ = 0;
+  };
+
+  /**
+   * @brief CRC-64/XZ (ECMA-182 polynomial, reflected) checksum.
+   * @details Same interface as @ref crc32c. Computed with slicing-by-8 tables. Use it where 32 bits
+   * are not enough to keep the chance of undetected corruption low, e.g. for very large files.
+   * @see crc32c
+   */
+  class RLL_API crc64 : public static_hasher<crc64> {
+   public:
+    using value_type = u64;
+
+    inline static constexpr std::size_t digest_size = sizeof(value_type);
+
+    constexpr ___inline___ crc64() noexcept = default;
+
+    /**
+     * @brief Continues from a previously computed checksum.
+     */
+    constexpr ___inline___ explicit crc64(value_type const crc) noexcept
+      : crc_(crc) {}
+
+    ___inline___ void update(char const* data, std::size_t const len) noexcept {
+      this->crc_ = crc64::extend(this->crc_, data, len);
+    }
+
+    constexpr ___inline___ void reset() noexcept { this->crc_ = 0; }
+
+    [[nodiscard]] constexpr ___inline___ value_type hash() const noexcept { return this->crc_; }
+
+    /**
+     * @brief Returns the checksum as sixteen lowercase hex digits.
+     */
+    [[nodiscard]] std::string hash_string() const;
+
+    /**
+     * @brief Returns the checksum of the concatenation of the data hashed by @p crc and @p data.
+     */
+    [[nodiscard]] static value_type
+      extend(value_type crc, void const* data, std::size_t len) noexcept;
+
+    /**
+     * @brief Computes the checksum of @p data.
+     */
+    [[nodiscard]] static ___inline___ value_type compute(std::string_view const data) noexcept {
+      return crc64::extend(0, data.data(), data.size());
+    }
+
+    /**
+     * @brief Combines checksums of two adjacent chunks.
+     * @param crc_a Checksum of the first chunk.
+     * @param crc_b Checksum of the second chunk.
+     * @param len_b Length of the second chunk in bytes.
+     * @return Checksum of the first chunk followed by the second.
+     */
+    [[nodiscard]] static value_type
+      combine(value_type crc_a, value_type crc_b, u64 len_b) noexcept;
+
+   private:
+    value_type crc_ = 0;
+  };
+}  // namespace rll::crypto
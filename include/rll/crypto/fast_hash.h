@@ -0,0 +1,331 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <rll/global/definitions.h>
+#include <rll/stdint.h>
+#include <rll/u128.h>
+#include <rll/crypto/static_hasher.h>
+
+namespace rll::crypto {
+  namespace detail {
+    inline constexpr std::array<u64, 4> fast_hash_secret = {
+      0xa0761d6478bd642fULL,
+      0xe7037ed1a0b428dbULL,
+      0x8ebc6af09c88c6e3ULL,
+      0x589965cc75374cc3ULL
+    };
+
+    /// Multiplies `a` by `b` and replaces them with the lower and upper halves of the product.
+    constexpr ___inline___ void fast_mum(u64& a, u64& b) noexcept {
+#if defined(__SIZEOF_INT128__)
+      auto const r = static_cast<unsigned __int128>(a) * b;
+      a = static_cast<u64>(r);
+      b = static_cast<u64>(r >> 64);
+#else
+      auto const al = a & 0xFFFFFFFFULL;
+      auto const ah = a >> 32;
+      auto const bl = b & 0xFFFFFFFFULL;
+      auto const bh = b >> 32;
+      auto const ll = al * bl;
+      auto const lh = al * bh;
+      auto const hl = ah * bl;
+      auto const mid = (ll >> 32) + (lh & 0xFFFFFFFFULL) + (hl & 0xFFFFFFFFULL);
+      a = (mid << 32) | (ll & 0xFFFFFFFFULL);
+      b = ah * bh + (lh >> 32) + (hl >> 32) + (mid >> 32);
+#endif
+    }
+
+    [[nodiscard]] constexpr ___inline___ u64 fast_mix(u64 a, u64 b) noexcept {
+      fast_mum(a, b);
+      return a ^ b;
+    }
+
+    /// Whether the caller runs at compile time. Conservatively `true` when the compiler cannot say.
+    [[nodiscard]] constexpr ___inline___ bool fast_hash_constant_evaluated() noexcept {
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1925)
+      return __builtin_is_constant_evaluated();
+#else
+      return true;
+#endif
+    }
+
+    // little-endian reads: a plain load at run time, byte-wise in constant expressions
+    template <typename T>
+    [[nodiscard]] constexpr ___inline___ u64 fast_read(char const* p) noexcept {
+      if(not fast_hash_constant_evaluated()) {
+        auto r = T();
+        std::memcpy(&r, p, sizeof(T));
+#if RLL_ENDIAN == RLL_BIG_ENDIAN
+        if constexpr(sizeof(T) == 8)
+          r = ___rolly_byteswap64(r);
+        else
+          r = ___rolly_byteswap32(r);
+#endif
+        return r;
+      }
+      auto r = u64();
+      for(auto i = std::size_t(0); i < sizeof(T); ++i)
+        r |= static_cast<u64>(static_cast<u8>(p[i])) << (8 * i);  // NOLINT(*-pointer-arithmetic)
+      return r;
+    }
+
+    [[nodiscard]] constexpr ___inline___ u64 fast_read64(char const* p) noexcept {
+      return fast_read<u64>(p);
+    }
+
+    [[nodiscard]] constexpr ___inline___ u64 fast_read32(char const* p) noexcept {
+      return fast_read<u32>(p);
+    }
+
+    constexpr ___inline___ void
+      fast_copy(char* dst, char const* src, std::size_t const n) noexcept {
+      if(not fast_hash_constant_evaluated()) {
+        if(n > 0)
+          std::memcpy(dst, src, n);
+        return;
+      }
+      for(auto i = std::size_t(0); i < n; ++i)
+        dst[i] = src[i];  // NOLINT(*-pointer-arithmetic)
+    }
+
+    /// Branch-light read of 1 to 16 bytes into two words (overlapping reads, no loops).
+    constexpr ___inline___ void
+      fast_read_small(char const* p, std::size_t const len, u64& a, u64& b) noexcept {
+      // NOLINTBEGIN(*-pointer-arithmetic)
+      if(len >= 4) {
+        auto const shift = (len >> 3) << 2;
+        a = (fast_read32(p) << 32) | fast_read32(p + shift);
+        b = (fast_read32(p + len - 4) << 32) | fast_read32(p + len - 4 - shift);
+      } else if(len > 0) {
+        a = (static_cast<u64>(static_cast<u8>(p[0])) << 16)
+          | (static_cast<u64>(static_cast<u8>(p[len >> 1])) << 8)
+          | static_cast<u64>(static_cast<u8>(p[len - 1]));
+        b = 0;
+      } else {
+        a = 0;
+        b = 0;
+      }
+      // NOLINTEND(*-pointer-arithmetic)
+    }
+
+    struct fast_hash_state {
+      std::array<u64, 4> lanes;
+      u64 seed;
+      bool striped;
+
+      constexpr explicit fast_hash_state(u64 const s) noexcept
+        : lanes()
+        , seed(s ^ fast_mix(s ^ fast_hash_secret[0], fast_hash_secret[1]))
+        , striped(false) {}
+
+      /// Absorbs `count` 64-byte stripes: four independent multiply lanes of 16 bytes each.
+      constexpr ___inline___ void stripes(char const* p, std::size_t count) noexcept {
+        if(not this->striped) {
+          for(auto i = std::size_t(0); i < 4; ++i)
+            this->lanes[i] = this->seed ^ fast_hash_secret[i];
+          this->striped = true;
+        }
+        // locals keep the lanes in registers: stores through `lanes` could alias `p`
+        auto l0 = this->lanes[0];
+        auto l1 = this->lanes[1];
+        auto l2 = this->lanes[2];
+        auto l3 = this->lanes[3];
+        // NOLINTBEGIN(*-pointer-arithmetic)
+        for(; count > 0; --count, p += 64) {
+          l0 = fast_mix(fast_read64(p) ^ fast_hash_secret[0], fast_read64(p + 8) ^ l0);
+          l1 = fast_mix(fast_read64(p + 16) ^ fast_hash_secret[1], fast_read64(p + 24) ^ l1);
+          l2 = fast_mix(fast_read64(p + 32) ^ fast_hash_secret[2], fast_read64(p + 40) ^ l2);
+          l3 = fast_mix(fast_read64(p + 48) ^ fast_hash_secret[3], fast_read64(p + 56) ^ l3);
+        }
+        // NOLINTEND(*-pointer-arithmetic)
+        this->lanes = {l0, l1, l2, l3};
+      }
+
+      /**
+       * Finalizes with the last 1..64 unprocessed bytes (or the whole input when it is 16 bytes or
+       * less) and the total length. Writes the two final words to `a` and `b`.
+       */
+      constexpr ___inline___ void
+        finish(char const* p, std::size_t i, u64 const total, u64& a, u64& b) const noexcept {
+        auto s = this->seed;
+        if(this->striped)
+          s = (this->lanes[0] ^ this->lanes[1]) ^ (this->lanes[2] ^ this->lanes[3]);
+        if(total > 16) {
+          // NOLINTBEGIN(*-pointer-arithmetic)
+          for(; i > 16; i -= 16, p += 16)
+            s = fast_mix(fast_read64(p) ^ fast_hash_secret[1], fast_read64(p + 8) ^ s);
+          // NOLINTEND(*-pointer-arithmetic)
+        }
+        fast_read_small(p, i, a, b);
+        a ^= fast_hash_secret[1];
+        b ^= s;
+        fast_mum(a, b);
+        a ^= total;
+      }
+    };
+
+    [[nodiscard]] constexpr ___inline___ u64 fast_final64(u64 const a, u64 const b) noexcept {
+      return fast_mix(a ^ fast_hash_secret[0], b ^ fast_hash_secret[1]);
+    }
+
+    [[nodiscard]] constexpr ___inline___ u128 fast_final128(u64 const a, u64 const b) noexcept {
+      return {
+        fast_mix(a ^ fast_hash_secret[2], b ^ fast_hash_secret[3]),
+        fast_mix(a ^ fast_hash_secret[0], b ^ fast_hash_secret[1])
+      };
+    }
+
+    constexpr ___inline___ void
+      fast_hash_words(char const* p, std::size_t len, u64 const seed, u64& a, u64& b) noexcept {
+      auto state = fast_hash_state(seed);
+      auto const total = static_cast<u64>(len);
+      if(len > 64) {
+        auto const count = (len - 1) / 64;
+        state.stripes(p, count);
+        p += count * 64;  // NOLINT(*-pointer-arithmetic)
+        len -= count * 64;
+      }
+      state.finish(p, len, total, a, b);
+    }
+  }  // namespace detail
+
+  /**
+   * @brief Fast non-cryptographic 64-bit hash of a byte range.
+   * @details Multiply-mix hash in the wyhash family. Large inputs are consumed in 64-byte stripes
+   * by four independent lanes; inputs of 16 bytes or less take a branch-light path with no loops.
+   * Usable in constant expressions.
+   * @warning Not suitable for anything security related: collisions can be constructed.
+   * @param data Data to hash.
+   * @param seed Optional seed.
+   * @return 64-bit hash value.
+   * @see fast_hasher
+   */
+  [[nodiscard]] constexpr ___inline___ u64
+    fast_hash64(std::string_view const data, u64 const seed = 0) noexcept {
+    auto a = u64();
+    auto b = u64();
+    detail::fast_hash_words(data.data(), data.size(), seed, a, b);
+    return detail::fast_final64(a, b);
+  }
+
+  /**
+   * @brief Fast non-cryptographic 128-bit hash of a byte range.
+   * @details Same construction as @ref fast_hash64 with a wider finalization. The lower half is
+   * equal to @ref fast_hash64 of the same input and seed.
+   * @param data Data to hash.
+   * @param seed Optional seed.
+   * @return 128-bit hash value.
+   */
+  [[nodiscard]] constexpr ___inline___ u128
+    fast_hash128(std::string_view const data, u64 const seed = 0) noexcept {
+    auto a = u64();
+    auto b = u64();
+    detail::fast_hash_words(data.data(), data.size(), seed, a, b);
+    return detail::fast_final128(a, b);
+  }
+
+  /**
+   * @brief Mixes `value` into `seed`. Intended for combining hashes of struct members.
+   * @details Unlike `seed ^ value`, the result depends on the order of combination.
+   */
+  [[nodiscard]] constexpr ___inline___ u64
+    fast_hash_combine(u64 const seed, u64 const value) noexcept {
+    return detail::fast_mix(
+      seed ^ detail::fast_hash_secret[0],
+      value ^ detail::fast_hash_secret[1]
+    );
+  }
+
+  /**
+   * @brief Streaming version of @ref fast_hash64 and @ref fast_hash128.
+   * @details Value type with no heap allocation and no virtual calls. Feeding the data in any
+   * number of chunks gives the same result as hashing it at once. The hasher can be copied to
+   * fork a common prefix.
+   * @warning Not suitable for anything security related.
+   */
+  class fast_hasher : public static_hasher<fast_hasher> {
+   public:
+    inline static constexpr std::size_t stripe_size = 64;
+
+    constexpr ___inline___ explicit fast_hasher(u64 const seed = 0) noexcept
+      : seed_(seed)
+      , state_(seed) {}
+
+    /**
+     * @brief Appends data to the hasher. See @ref static_hasher for the front-ends.
+     */
+    constexpr ___inline___ void update(char const* p, std::size_t len) noexcept {
+      this->total_ += len;
+      // NOLINTBEGIN(*-pointer-arithmetic)
+      if(this->buffer_size_ > 0) {
+        auto const take = std::min(len, stripe_size - this->buffer_size_);
+        detail::fast_copy(this->buffer_.data() + this->buffer_size_, p, take);
+        this->buffer_size_ += take;
+        p += take;
+        len -= take;
+        if(len == 0)
+          return;
+        this->state_.stripes(this->buffer_.data(), 1);
+        this->buffer_size_ = 0;
+      }
+      // the last 1..64 bytes always stay buffered for finalization
+      if(len > stripe_size) {
+        auto const count = (len - 1) / stripe_size;
+        this->state_.stripes(p, count);
+        p += count * stripe_size;
+        len -= count * stripe_size;
+      }
+      detail::fast_copy(this->buffer_.data(), p, len);
+      // NOLINTEND(*-pointer-arithmetic)
+      this->buffer_size_ = len;
+    }
+
+    /**
+     * @brief Resets the hasher to its initial state, keeping the seed.
+     */
+    constexpr ___inline___ void reset() noexcept { *this = fast_hasher(this->seed_); }
+
+    /**
+     * @brief Returns the 64-bit hash of all appended data. Does not modify the hasher.
+     */
+    [[nodiscard]] constexpr ___inline___ u64 hash() const noexcept {
+      auto a = u64();
+      auto b = u64();
+      this->state_.finish(this->buffer_.data(), this->buffer_size_, this->total_, a, b);
+      return detail::fast_final64(a, b);
+    }
+
+    /**
+     * @brief Returns the 128-bit hash of all appended data. Does not modify the hasher.
+     */
+    [[nodiscard]] constexpr ___inline___ u128 hash128() const noexcept {
+      auto a = u64();
+      auto b = u64();
+      this->state_.finish(this->buffer_.data(), this->buffer_size_, this->total_, a, b);
+      return detail::fast_final128(a, b);
+    }
+
+   private:
+    u64 seed_;
+    detail::fast_hash_state state_;
+    u64 total_ = 0;
+    std::size_t buffer_size_ = 0;
+    std::array<char, stripe_size> buffer_ = {};
+  };
+}  // namespace rll::crypto
+
+namespace rll {
+  inline namespace literals {
+    /**
+     * @brief Literal operator for compile-time @ref crypto::fast_hash64 values.
+     * @details Usable as `case` label: `case "telemetry.frame"_hash64:`.
+     */
+    constexpr ___inline___ u64 operator""_hash64(char const* str, std::size_t const size) noexcept {
+      return crypto::fast_hash64(std::string_view(str, size));
+    }
+  }  // namespace literals
+}  // namespace rll
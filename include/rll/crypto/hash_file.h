@@ -0,0 +1,90 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <vector>
+#include <rll/result.h>
+#include <rll/stdint.h>
+#include <rll/global/definitions.h>
+#ifndef Q_MOC_RUN
+#  include <filesystem>
+#endif
+
+namespace rll::crypto {
+  /**
+   * @brief Digest algorithms supported by @ref hash_file.
+   */
+  enum class hash_algorithm {
+    md5,     ///< MD5. Sequential.
+    sha1,    ///< SHA-1. Sequential.
+    sha256,  ///< SHA-256. Sequential.
+
+    /**
+     * @brief 128-bit tree hash built from @ref fast_hash128, split across threads.
+     * @details The file is cut into @ref hash_file_chunk_size chunks; each chunk is hashed with
+     * its index as seed and the chunk digests are hashed again with the file size as seed. The
+     * result does not depend on the number of threads. Not cryptographic.
+     */
+    fast_tree,
+
+    /**
+     * @brief @ref crc32c checksum, split across threads.
+     * @details Chunks are checksummed in parallel and joined with @ref crc32c::combine, so the
+     * result equals the checksum of the whole file. Digest is the big-endian checksum.
+     */
+    crc32c,
+
+    /**
+     * @brief @ref crc64 checksum, split across threads like @ref hash_algorithm::crc32c.
+     */
+    crc64
+  };
+
+  /**
+   * @brief Chunk size of the parallel algorithms (@ref hash_algorithm::fast_tree and the CRCs).
+   */
+  inline constexpr std::size_t hash_file_chunk_size = 1U << 20U;
+
+  /**
+   * @brief Result of @ref hash_file.
+   */
+  struct file_digest {
+    hash_algorithm algorithm = hash_algorithm::md5;  ///< Algorithm used.
+    std::vector<u8> digest;                         ///< Raw digest bytes.
+    u64 size = 0;                                   ///< Number of bytes hashed.
+    std::chrono::nanoseconds elapsed {};            ///< Wall time spent hashing.
+    std::size_t threads = 1;                        ///< Number of threads used.
+
+    /**
+     * @brief Returns the digest as lowercase hex string.
+     */
+    [[nodiscard]] RLL_API std::string to_string() const;
+
+    /**
+     * @brief Returns the hashing throughput in bytes per second.
+     */
+    [[nodiscard]] RLL_API f64 throughput() const noexcept;
+  };
+
+  /**
+   * @brief Computes the digest of a file.
+   * @details The file is memory-mapped and fed to the hasher directly, without reading it into
+   * an intermediate buffer. Tree-capable algorithms are split across @p threads workers.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * auto const res = rll::crypto::hash_file("recording.bin", rll::crypto::hash_algorithm::sha256);
+   * if(res)
+   *   fmt::print("{} ({:.1f} MB/s)\n", res->to_string(), res->throughput() / 1e6);
+   * @endcode
+   * @param path Path to the file.
+   * @param algorithm Digest algorithm.
+   * @param threads Maximum number of threads. `0` uses all hardware threads.
+   * @return Digest and statistics, or an error if the file can not be mapped.
+   */
+  [[nodiscard]] RLL_API result<file_digest> hash_file(
+    std::filesystem::path const& path,
+    hash_algorithm algorithm,
+    std::size_t threads = 0
+  ) noexcept;
+}  // namespace rll::crypto
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <rll/stdint.h>
+#include <rll/global/definitions.h>
+#include <rll/crypto/md5.h>
+#include <rll/crypto/sha1.h>
+#include <rll/crypto/sha256.h>
+#include <rll/crypto/static_hasher.h>
+
+namespace rll::crypto {
+  namespace detail {
+    /**
+     * @brief Overwrites @p len bytes at @p data with zeroes.
+     * @details The stores go through a volatile pointer, so the compiler cannot drop them as dead
+     * even though the memory is not read again.
+     */
+    inline void secure_zero(void* data, std::size_t const len) noexcept {
+      auto* bytes = static_cast<u8 volatile*>(data);
+      for(auto i = std::size_t(0); i < len; i++)
+        bytes[i] = 0;  // NOLINT(*-pointer-arithmetic)
+    }
+  }  // namespace detail
+
+  /**
+   * @brief Keyed-hash message authentication code (RFC 2104) over a block hash engine.
+   * @details The key is processed once on construction: the engine states after absorbing the
+   * inner and outer key pads are kept, so each message costs only its own blocks plus one outer
+   * block instead of re-hashing both pads. Copying an instance is a plain copy of these states
+   * and is the cheap way to authenticate many messages with one key.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * auto const key = rll::crypto::hmac_sha256(secret);
+   * auto mac = key;
+   * mac << header.sequence << std::string_view(payload);
+   * auto const tag = mac.hash();
+   * if(not key.verify(packet, received_tag))
+   *   return error("bad packet signature");
+   * @endcode
+   * @tparam Engine Statically dispatched hash engine, e.g. @ref sha256_engine.
+   * @see hmac_md5, hmac_sha1, hmac_sha256
+   */
+  template <typename Engine>
+  class hmac : public static_hasher<hmac<Engine>> {
+   public:
+    using engine_type = Engine;
+    using digest_type = typename Engine::digest_type;
+
+    inline static constexpr std::size_t block_size = Engine::block_size;
+    inline static constexpr std::size_t digest_size = Engine::digest_size;
+
+    /**
+     * @brief Precomputes the key schedule for @p key.
+     */
+    explicit hmac(std::string_view const key) noexcept
+      : hmac(key.data(), key.size()) {}
+
+    /**
+     * @brief Precomputes the key schedule for @p len bytes of key material at @p key.
+     */
+    hmac(void const* key, std::size_t const len) noexcept {
+      auto block = std::array<u8, block_size>();
+      if(len > block_size) {
+        auto shortened = Engine();
+        shortened.update(static_cast<char const*>(key), len);
+        auto digest = shortened.hash();
+        std::copy(digest.begin(), digest.end(), block.begin());
+        detail::secure_zero(digest.data(), digest.size());
+      } else if(len > 0)
+        std::copy_n(static_cast<u8 const*>(key), len, block.begin());
+
+      auto pad = std::array<char, block_size>();
+      for(auto i = std::size_t(0); i < block_size; i++)
+        pad[i] = static_cast<char>(block[i] ^ 0x36U);
+      this->inner_pad_.update(pad.data(), pad.size());
+      for(auto i = std::size_t(0); i < block_size; i++)
+        pad[i] = static_cast<char>(block[i] ^ 0x5CU);
+      this->outer_pad_.update(pad.data(), pad.size());
+      this->inner_ = this->inner_pad_;
+
+      // the key material must not outlive the call on the stack
+      detail::secure_zero(block.data(), block.size());
+      detail::secure_zero(pad.data(), pad.size());
+    }
+
+    ___inline___ void update(char const* data, std::size_t const len) noexcept {
+      this->inner_.update(data, len);
+    }
+
+    /**
+     * @brief Discards the message appended so far. The key is kept.
+     */
+    ___inline___ void reset() noexcept { this->inner_ = this->inner_pad_; }
+
+    /**
+     * @brief Returns the authentication code of the message appended so far.
+     */
+    [[nodiscard]] digest_type hash() const noexcept { return this->finish(this->inner_); }
+
+    /**
+     * @brief Returns the authentication code as lowercase hex string.
+     */
+    [[nodiscard]] std::string hash_string() const {
+      auto const digest = this->hash();
+      auto res = std::string();
+      res.reserve(2 * digest.size());
+      for(auto const byte : digest) {
+        res.push_back("0123456789abcdef"[byte >> 4U]);
+        res.push_back("0123456789abcdef"[byte & 0xFU]);
+      }
+      return res;
+    }
+
+    /**
+     * @brief Returns the authentication code of @p message, independent of the appended data.
+     */
+    [[nodiscard]] digest_type sign(std::string_view const message) const noexcept {
+      auto inner = this->inner_pad_;
+      inner.update(message.data(), message.size());
+      return this->finish(inner);
+    }
+
+    /**
+     * @brief Signs @p count messages with the same key.
+     * @param messages Pointer to the first of @p count messages.
+     * @param digests Pointer to the first of @p count digests to write results to.
+     * @param count Number of messages.
+     */
+    void sign_many(
+      std::string_view const* messages,
+      digest_type* digests,
+      std::size_t const count
+    ) const noexcept {
+      for(auto i = std::size_t(0); i < count; i++)
+        digests[i] = this->sign(messages[i]);  // NOLINT(*-pointer-arithmetic)
+    }
+
+    /**
+     * @brief Signs many messages with the same key.
+     * @return Digests in the same order as @p messages.
+     */
+    [[nodiscard]] std::vector<digest_type>
+      sign_many(std::vector<std::string_view> const& messages) const {
+      auto res = std::vector<digest_type>(messages.size());
+      this->sign_many(messages.data(), res.data(), messages.size());
+      return res;
+    }
+
+    /**
+     * @brief Checks @p mac against the authentication code of @p message.
+     * @details The comparison takes the same time wherever the first mismatch is.
+     */
+    [[nodiscard]] bool verify(std::string_view const message, digest_type const& mac)
+      const noexcept {
+      auto const expected = this->sign(message);
+      auto diff = u8();
+      for(auto i = std::size_t(0); i < expected.size(); i++)
+        diff |= static_cast<u8>(expected[i] ^ mac[i]);
+      return diff == 0;
+    }
+
+   private:
+    [[nodiscard]] digest_type finish(Engine const& inner) const noexcept {
+      auto const inner_digest = inner.hash();
+      auto outer = this->outer_pad_;
+      auto const* bytes = reinterpret_cast<char const*>(inner_digest.data());  // NOLINT
+      outer.update(bytes, inner_digest.size());
+      return outer.hash();
+    }
+
+    Engine inner_pad_;
+    Engine outer_pad_;
+    Engine inner_;
+  };
+
+  using hmac_md5 = hmac<md5_engine>;        ///< HMAC-MD5.
+  using hmac_sha1 = hmac<sha1_engine>;      ///< HMAC-SHA1.
+  using hmac_sha256 = hmac<sha256_engine>;  ///< HMAC-SHA256.
+}  // namespace rll::crypto
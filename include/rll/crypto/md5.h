@@ -3,10 +3,67 @@
 #include <array>
 #include <rll/stdint.h>
 #include <rll/uuid.h>
-#include <rll/traits/pimpl.h>
 #include <rll/crypto/basic_hasher.h>
+#include <rll/crypto/static_hasher.h>
 
 namespace rll::crypto {
+  /**
+   * @brief Statically dispatched MD5 (RFC 1321).
+   * @details Value type holding the whole hash state. Buffering is inline; only completed blocks
+   * call into the library. The engine is trivially copyable: hash a shared header once, then copy
+   * the engine and continue each copy with its own record.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * auto header = rll::crypto::md5_engine();
+   * header << std::string_view(common_header);
+   * for(auto const& record : records) {
+   *   auto hasher = header;
+   *   hasher << std::string_view(record);
+   *   digests.push_back(hasher.hash());
+   * }
+   * @endcode
+   * @see md5
+   */
+  class RLL_API md5_engine : public static_hasher<md5_engine> {
+   public:
+    using digest_type = std::array<u8, 16>;
+    using state_type = std::array<u32, 4>;
+
+    inline static constexpr std::size_t block_size = 64;
+    inline static constexpr std::size_t digest_size = 16;
+
+    ___inline___ md5_engine() noexcept { this->reset(); }
+
+    ___inline___ void update(char const* data, std::size_t const len) noexcept {
+      this->buffer_.absorb(this->state_, data, len, &md5_engine::compress);
+    }
+
+    ___inline___ void reset() noexcept {
+      this->buffer_.clear();
+      this->state_ = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+    }
+
+    [[nodiscard]] digest_type hash() const noexcept;
+    [[nodiscard]] uuid hash_uuid() const noexcept;
+
+    /**
+     * @brief Runs the compression function over `count` consecutive blocks.
+     */
+    static void compress(state_type& state, u8 const* blocks, std::size_t count) noexcept;
+
+   private:
+    state_type state_ = {};
+    detail::block_buffer<block_size> buffer_;
+  };
+
+  /**
+   * @brief MD5 hasher (RFC 1321).
+   * @details Holds a @ref md5_engine inline, so construction does not allocate and copies fork the
+   * current state.
+   * @warning MD5 is broken against deliberate collisions. Use it for identifiers and checksums
+   * only.
+   */
   class RLL_API md5 : public basic_hasher {
    public:
     using digest_type = std::array<u8, 16>;
@@ -14,12 +71,12 @@ namespace rll::crypto {
     inline static constexpr std::size_t block_size = 64;
     inline static constexpr std::size_t digest_size = 16;
 
-    md5();
-    md5(md5 const&) = delete;
-    md5(md5&&) noexcept = delete;
-    md5& operator=(md5 const&) = delete;
-    md5& operator=(md5&&) noexcept = delete;
-    ~md5() override;
+    md5() = default;
+    md5(md5 const&) = default;
+    md5(md5&&) noexcept = default;
+    md5& operator=(md5 const&) = default;
+    md5& operator=(md5&&) noexcept = default;
+    ~md5() override = default;
 
     basic_hasher& append(std::string const& str) override;
     basic_hasher& append(std::string_view str) override;
@@ -31,7 +88,14 @@ namespace rll::crypto {
     [[nodiscard]] digest_type hash() const;
     [[nodiscard]] uuid hash_uuid() const;
 
+    /**
+     * @brief Returns the underlying engine holding the hash state.
+     */
+    [[nodiscard]] ___inline___ md5_engine const& engine() const noexcept {
+      return this->engine_;
+    }
+
    private:
-    DECLARE_PRIVATE_AS(md5_private)
+    md5_engine engine_;
   };
 }  // namespace rll::crypto
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <string_view>
+#include <vector>
+#include <rll/crypto/md5.h>
+
+namespace rll::crypto {
+  /**
+   * @brief Computes MD5 digests of many independent messages at once.
+   * @details Messages are scheduled over 4 (SSE2, NEON), 8 (AVX2) or 16 (AVX-512) SIMD lanes. The
+   * instruction set is selected at runtime. Each lane yields exactly the same digest as @ref md5
+   * would for the same message. Lanes are refilled as soon as their message is finished, so
+   * messages of different lengths can be mixed freely.
+   *
+   * This pays off for many short messages. A single long message is hashed faster by @ref md5.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * auto const records = std::vector<std::string_view> {"alpha", "beta", "gamma"};
+   * auto const digests = rll::crypto::md5_batch(records);
+   * @endcode
+   * @param messages Pointer to the first of @p count messages.
+   * @param digests Pointer to the first of @p count digests to write results to.
+   * @param count Number of messages.
+   * @see md5_batch_lanes
+   */
+  RLL_API void md5_batch(
+    std::string_view const* messages,
+    md5::digest_type* digests,
+    std::size_t count
+  ) noexcept;
+
+  /**
+   * @brief Computes MD5 digests of many independent messages at once.
+   * @param messages Messages to hash.
+   * @return Digests in the same order as @p messages.
+   */
+  [[nodiscard]] RLL_API std::vector<md5::digest_type> md5_batch(
+    std::vector<std::string_view> const& messages
+  );
+
+  /**
+   * @brief Number of messages @ref md5_batch hashes in parallel on the current CPU.
+   */
+  [[nodiscard]] RLL_API std::size_t md5_batch_lanes() noexcept;
+}  // namespace rll::crypto
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <rll/stdint.h>
+#include <rll/crypto/basic_hasher.h>
+#include <rll/crypto/static_hasher.h>
+
+namespace rll::crypto {
+  /**
+   * @brief Statically dispatched SHA-1.
+   * @details Value type holding the whole hash state. Buffering is inline; completed blocks go to
+   * the same accelerated compression function as @ref sha1.
+   * @see sha1
+   */
+  class RLL_API sha1_engine : public static_hasher<sha1_engine> {
+   public:
+    using digest_type = std::array<u8, 20>;
+    using state_type = std::array<u32, 5>;
+
+    inline static constexpr std::size_t block_size = 64;
+    inline static constexpr std::size_t digest_size = 20;
+
+    ___inline___ sha1_engine() noexcept { this->reset(); }
+
+    ___inline___ void update(char const* data, std::size_t const len) noexcept {
+      this->buffer_.absorb(this->state_, data, len, &sha1_engine::compress);
+    }
+
+    ___inline___ void reset() noexcept {
+      this->buffer_.clear();
+      this->state_ = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476, 0xc3d2e1f0};
+    }
+
+    [[nodiscard]] digest_type hash() const noexcept;
+
+    /**
+     * @brief Runs the compression function over `count` consecutive blocks.
+     */
+    static void compress(state_type& state, u8 const* blocks, std::size_t count) noexcept;
+
+   private:
+    state_type state_ = {};
+    detail::block_buffer<block_size> buffer_;
+  };
+
+  /**
+   * @brief SHA-1 hasher (FIPS 180-4).
+   * @details Uses Intel SHA extensions or ARMv8 cryptography extensions when the CPU supports
+   * them, and a portable implementation otherwise. The state is stored inline; copies are
+   * independent.
+   * @warning SHA-1 is not collision resistant. Prefer @ref sha256 for new integrity checks.
+   */
+  class RLL_API sha1 : public basic_hasher {
+   public:
+    using digest_type = std::array<u8, 20>;
+
+    inline static constexpr std::size_t block_size = 64;
+    inline static constexpr std::size_t digest_size = 20;
+
+    sha1() = default;
+    sha1(sha1 const&) = default;
+    sha1(sha1&&) noexcept = default;
+    sha1& operator=(sha1 const&) = default;
+    sha1& operator=(sha1&&) noexcept = default;
+    ~sha1() override = default;
+
+    basic_hasher& append(std::string const& str) override;
+    basic_hasher& append(std::string_view str) override;
+    basic_hasher& append(void const* str, std::size_t len) override;
+
+    void reset() override;
+
+    [[nodiscard]] std::string hash_string() const override;
+    [[nodiscard]] digest_type hash() const;
+
+    /**
+     * @brief Returns whether the hardware-accelerated implementation is used on this CPU.
+     */
+    [[nodiscard]] static bool accelerated() noexcept;
+
+    /**
+     * @brief Returns the underlying engine holding the hash state.
+     */
+    [[nodiscard]] ___inline___ sha1_engine const& engine() const noexcept {
+      return this->engine_;
+    }
+
+   private:
+    sha1_engine engine_;
+  };
+}  // namespace rll::crypto
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <rll/stdint.h>
+#include <rll/crypto/basic_hasher.h>
+#include <rll/crypto/static_hasher.h>
+
+namespace rll::crypto {
+  /**
+   * @brief Statically dispatched SHA-256.
+   * @details Value type holding the whole hash state. Buffering is inline; completed blocks go to
+   * the same accelerated compression function as @ref sha256.
+   * @see sha256
+   */
+  class RLL_API sha256_engine : public static_hasher<sha256_engine> {
+   public:
+    using digest_type = std::array<u8, 32>;
+    using state_type = std::array<u32, 8>;
+
+    inline static constexpr std::size_t block_size = 64;
+    inline static constexpr std::size_t digest_size = 32;
+
+    ___inline___ sha256_engine() noexcept { this->reset(); }
+
+    ___inline___ void update(char const* data, std::size_t const len) noexcept {
+      this->buffer_.absorb(this->state_, data, len, &sha256_engine::compress);
+    }
+
+    ___inline___ void reset() noexcept {
+      this->buffer_.clear();
+      this->state_ = {
+        0x6a09e667,
+        0xbb67ae85,
+        0x3c6ef372,
+        0xa54ff53a,
+        0x510e527f,
+        0x9b05688c,
+        0x1f83d9ab,
+        0x5be0cd19,
+      };
+    }
+
+    [[nodiscard]] digest_type hash() const noexcept;
+
+    /**
+     * @brief Runs the compression function over `count` consecutive blocks.
+     */
+    static void compress(state_type& state, u8 const* blocks, std::size_t count) noexcept;
+
+   private:
+    state_type state_ = {};
+    detail::block_buffer<block_size> buffer_;
+  };
+
+  /**
+   * @brief SHA-256 hasher (FIPS 180-4).
+   * @details Uses Intel SHA extensions or ARMv8 cryptography extensions when the CPU supports
+   * them, and a portable implementation otherwise. The state is stored inline; copies are
+   * independent.
+   */
+  class RLL_API sha256 : public basic_hasher {
+   public:
+    using digest_type = std::array<u8, 32>;
+
+    inline static constexpr std::size_t block_size = 64;
+    inline static constexpr std::size_t digest_size = 32;
+
+    sha256() = default;
+    sha256(sha256 const&) = default;
+    sha256(sha256&&) noexcept = default;
+    sha256& operator=(sha256 const&) = default;
+    sha256& operator=(sha256&&) noexcept = default;
+    ~sha256() override = default;
+
+    basic_hasher& append(std::string const& str) override;
+    basic_hasher& append(std::string_view str) override;
+    basic_hasher& append(void const* str, std::size_t len) override;
+
+    void reset() override;
+
+    [[nodiscard]] std::string hash_string() const override;
+    [[nodiscard]] digest_type hash() const;
+
+    /**
+     * @brief Returns whether the hardware-accelerated implementation is used on this CPU.
+     */
+    [[nodiscard]] static bool accelerated() noexcept;
+
+    /**
+     * @brief Returns the underlying engine holding the hash state.
+     */
+    [[nodiscard]] ___inline___ sha256_engine const& engine() const noexcept {
+      return this->engine_;
+    }
+
+   private:
+    sha256_engine engine_;
+  };
+}  // namespace rll::crypto
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <array>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <rll/global/definitions.h>
+#include <rll/stdint.h>
+
+namespace rll::crypto {
+  /**
+   * @brief Statically dispatched hasher interface.
+   * @details CRTP counterpart of @ref basic_hasher. `Derived` implements
+   * `update(char const* data, std::size_t len)`, `reset()` and `hash()`; this base adds the
+   * `append`, `append_raw` and `operator<<` front-ends on top of `update`. Nothing is virtual, so
+   * a chain of `append_raw` calls over struct fields inlines into the caller.
+   *
+   * Example:
+   * @code {.cpp}
+   * auto hasher = rll::crypto::md5_engine();
+   * hasher << point.x << point.y << std::string_view(name);
+   * auto const digest = hasher.hash();
+   * @endcode
+   * @tparam Derived Hasher implementation.
+   * @see basic_hasher
+   */
+  template <typename Derived>
+  class static_hasher {
+   public:
+    /**
+     * @brief Appends a string to the hasher.
+     */
+    constexpr ___inline___ Derived& append(std::string_view const str) noexcept {
+      this->derived().update(str.data(), str.size());
+      return this->derived();
+    }
+
+    /**
+     * @brief Appends raw bytes to the hasher.
+     */
+    ___inline___ Derived& append(void const* data, std::size_t const len) noexcept {
+      this->derived().update(static_cast<char const*>(data), len);
+      return this->derived();
+    }
+
+    /**
+     * @brief Appends the object representation of a trivial value.
+     */
+    template <
+      typename T,
+      typename = std::enable_if_t<std::is_standard_layout_v<T> and std::is_trivial_v<T>>>
+    ___inline___ Derived& append_raw(T const& value) noexcept {
+      return this->append(&value, sizeof(T));
+    }
+
+    constexpr ___inline___ Derived& operator<<(std::string_view const str) noexcept {
+      return this->append(str);
+    }
+
+    template <
+      typename T,
+      typename = std::enable_if_t<
+        std::is_standard_layout_v<T> and std::is_trivial_v<T>
+        and not std::is_convertible_v<T, std::string_view> and not std::is_pointer_v<T>>>
+    ___inline___ Derived& operator<<(T const& value) noexcept {
+      return this->append_raw(value);
+    }
+
+   protected:
+    constexpr static_hasher() noexcept = default;
+
+   private:
+    [[nodiscard]] constexpr ___inline___ Derived& derived() noexcept {
+      return static_cast<Derived&>(*this);
+    }
+  };
+
+  namespace detail {
+    /**
+     * @brief Input buffering for Merkle-Damgard block hashes.
+     * @details Appends shorter than the free space of the buffer are a copy and an add; only
+     * completed blocks reach the out-of-line compression function.
+     */
+    template <std::size_t BlockSize>
+    struct block_buffer {
+      std::array<u8, BlockSize> data = {};
+      std::size_t size = 0;
+      u64 num_bytes = 0;
+
+      constexpr ___inline___ void clear() noexcept {
+        this->size = 0;
+        this->num_bytes = 0;
+      }
+
+      /**
+       * @brief Appends `len` bytes. `compress(state, blocks, count)` consumes whole blocks.
+       */
+      template <typename State, typename Compress>
+      ___inline___ void
+        absorb(State& state, char const* in, std::size_t len, Compress compress) noexcept {
+        this->num_bytes += len;
+        // whole blocks on an empty buffer go straight to the compressor, without the copy
+        if(this->size == 0 and len >= BlockSize) {
+          this->absorb_blocks(state, reinterpret_cast<u8 const*>(in), len, compress);  // NOLINT
+          return;
+        }
+        if(len < BlockSize - this->size) {
+          if(len > 0)
+            std::memcpy(this->data.data() + this->size, in, len);
+          this->size += len;
+          return;
+        }
+        this->absorb_blocks(state, reinterpret_cast<u8 const*>(in), len, compress);  // NOLINT
+      }
+
+     private:
+      template <typename State, typename Compress>
+      void absorb_blocks(State& state, u8 const* in, std::size_t len, Compress compress) noexcept {
+        // NOLINTBEGIN(*-pointer-arithmetic)
+        if(this->size > 0) {
+          auto const take = BlockSize - this->size;
+          std::memcpy(this->data.data() + this->size, in, take);
+          compress(state, this->data.data(), 1);
+          in += take;
+          len -= take;
+        }
+        if(auto const blocks = len / BlockSize; blocks > 0) {
+          compress(state, in, blocks);
+          in += blocks * BlockSize;
+          len -= blocks * BlockSize;
+        }
+        std::memcpy(this->data.data(), in, len);
+        this->size = len;
+        // NOLINTEND(*-pointer-arithmetic)
+      }
+    };
+  }  // namespace detail
+}  // namespace rll::crypto
@@ -7,6 +7,7 @@
 #include <fmt/format.h>
 #include <rll/math.h>
 #include <rll/stdint.h>
+#include <rll/crypto/fast_hash.h>
 #include <rll/concepts/num.h>
 #include <rll/concepts/any_of.h>
 #include <rll/euclid/size2d.h>
@@ -689,7 +690,7 @@ namespace std {
   template <typename T>
   struct hash<rll::point2d<T>> {
     size_t operator()(rll::point2d<T> const& b) const {
-      return std::hash<T> {}(b.x()) xor std::hash<T> {}(b.y());
+      return rll::crypto::fast_hash_combine(std::hash<T> {}(b.x()), std::hash<T> {}(b.y()));
     }
   };
 }  // namespace std
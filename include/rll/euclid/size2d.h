@@ -7,6 +7,7 @@
 #include <fmt/format.h>
 #include <rll/concepts/num.h>
 #include <rll/stdint.h>
+#include <rll/crypto/fast_hash.h>
 
 #if defined(RLL_QT_GUI)
 #  include <qsize.h>
@@ -632,7 +633,7 @@ namespace std {
   template <typename T>
   struct hash<rll::size2d<T>> {
     size_t operator()(rll::size2d<T> const& b) const {
-      return std::hash<T> {}(b.x()) xor std::hash<T> {}(b.y());
+      return rll::crypto::fast_hash_combine(std::hash<T> {}(b.x()), std::hash<T> {}(b.y()));
     }
   };
 }  // namespace std
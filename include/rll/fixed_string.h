@@ -2,8 +2,10 @@
 
 #include <array>
 #include <string>
+#include <string_view>
 #include <rll/global/definitions.h>
 #include <rll/stdint.h>
+#include <rll/crypto/fast_hash.h>
 #include <rll/impl/char_reader.h>
 
 namespace rll {
@@ -581,3 +583,20 @@ namespace rll {
   fixed_string(char32_t const (&)[N]) -> fixed_string<N - 1>;
   fixed_string() -> fixed_string<0>;
 }  // namespace rll
+
+namespace std {
+  /**
+   * @brief Hashes a <tt>fixed_string</tt>.
+   * @tparam N Capacity of the <tt>fixed_string</tt>.
+   * @relates rll::fixed_string
+   * @sa http://en.cppreference.com/w/cpp/utility/hash
+   */
+  template <std::size_t N>
+  struct hash<rll::fixed_string<N>> {
+    constexpr std::size_t operator()(rll::fixed_string<N> const& str) const noexcept {
+      return static_cast<std::size_t>(
+        rll::crypto::fast_hash64(std::string_view(str.begin(), str.length))
+      );
+    }
+  };
+}  // namespace std
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <fmt/format.h>
+#include <rll/global/definitions.h>
+#include <rll/stdint.h>
+#include <rll/crypto/fast_hash.h>
+
+namespace rll {
+  /**
+   * @brief String of up to @p N characters stored inline.
+   * @details Runtime counterpart of @ref fixed_string: the characters and the length live in the
+   * object itself, so it never allocates and stays trivially copyable. Record types can hold
+   * short names in it and still be serialized with `memcpy`. The length is stored in the smallest
+   * unsigned type that fits @p N, the character array is sized so that the object has no padding,
+   * and the bytes past the end of the string are always zero, so two equal strings have the same
+   * object representation.
+   *
+   * Operations that would exceed the capacity throw `std::length_error`, as `std::string` does
+   * past its `max_size()`.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * struct record {
+   *   rll::inline_string<15> sensor;
+   *   double value;
+   * };
+   * auto r = record {"sensor-7", 21.5};
+   * r.sensor += "b";
+   * @endcode
+   * @tparam N Maximum number of characters.
+   */
+  template <std::size_t N>
+  class inline_string {
+   public:
+    using value_type = char;
+    using size_type = std::conditional_t<(N < 256), u8, std::conditional_t<(N < 65'536), u16, u32>>;
+    using pointer = char*;
+    using const_pointer = char const*;
+    using reference = char&;
+    using const_reference = char const&;
+    using iterator = pointer;
+    using const_iterator = const_pointer;
+
+    static constexpr auto max_length = N;
+
+    constexpr inline_string() noexcept = default;
+
+    /**
+     * @brief Constructs the string from a string literal whose length is checked at compile time.
+     * @details As with @ref fixed_string, the string ends at the first null character.
+     */
+    template <std::size_t M>
+    constexpr inline_string(char const (&str)[M]) noexcept {  // NOLINT(*-explicit-*, *-c-arrays)
+      static_assert(M - 1 <= N, "string literal does not fit into inline_string");
+      this->assign_unchecked(str, std::char_traits<char>::length(str));
+    }
+
+    /**
+     * @brief Constructs the string from @p str.
+     * @throws std::length_error If @p str is longer than @p N.
+     */
+    constexpr explicit inline_string(std::string_view const str) { this->assign(str); }
+
+    /**
+     * @brief Replaces the contents with @p str.
+     * @throws std::length_error If @p str is longer than @p N.
+     */
+    constexpr inline_string& assign(std::string_view const str) {
+      if(str.size() > N)
+        throw std::length_error("rll::inline_string: string does not fit");
+      auto const old_size = this->size_;
+      this->assign_unchecked(str.data(), str.size());
+      for(auto i = str.size(); i < old_size; ++i)
+        this->data_[i] = '\0';
+      return *this;
+    }
+
+    /**
+     * @brief Appends @p str.
+     * @throws std::length_error If the result would be longer than @p N.
+     */
+    constexpr inline_string& append(std::string_view const str) {
+      if(str.size() > N - this->size_)
+        throw std::length_error("rll::inline_string: string does not fit");
+      for(auto i = std::size_t(0); i < str.size(); ++i)
+        this->data_[this->size_ + i] = str[i];
+      this->size_ = static_cast<size_type>(this->size_ + str.size());
+      return *this;
+    }
+
+    /**
+     * @brief Appends @p c.
+     * @throws std::length_error If the string is full.
+     */
+    constexpr void push_back(char const c) {
+      if(this->size_ == N)
+        throw std::length_error("rll::inline_string: string does not fit");
+      this->data_[this->size_++] = c;
+    }
+
+    /**
+     * @brief Removes the last character. The string must not be empty.
+     */
+    constexpr void pop_back() noexcept { this->data_[--this->size_] = '\0'; }
+
+    constexpr void clear() noexcept {
+      for(auto i = std::size_t(0); i < this->size_; ++i)
+        this->data_[i] = '\0';
+      this->size_ = 0;
+    }
+
+    constexpr inline_string& operator+=(std::string_view const str) { return this->append(str); }
+
+    constexpr inline_string& operator+=(char const c) {
+      this->push_back(c);
+      return *this;
+    }
+
+    [[nodiscard]] constexpr ___inline___ std::size_t size() const noexcept { return this->size_; }
+
+    [[nodiscard]] constexpr ___inline___ std::size_t length() const noexcept {
+      return this->size_;
+    }
+
+    [[nodiscard]] constexpr ___inline___ bool empty() const noexcept { return this->size_ == 0; }
+
+    [[nodiscard]] static constexpr std::size_t capacity() noexcept { return N; }
+
+    [[nodiscard]] static constexpr std::size_t max_size() noexcept { return N; }
+
+    /**
+     * @brief Characters of the string, null-terminated.
+     */
+    [[nodiscard]] constexpr ___inline___ const_pointer data() const noexcept { return this->data_; }
+
+    [[nodiscard]] constexpr ___inline___ pointer data() noexcept { return this->data_; }
+
+    [[nodiscard]] constexpr ___inline___ const_pointer c_str() const noexcept {
+      return this->data_;
+    }
+
+    [[nodiscard]] constexpr ___inline___ iterator begin() noexcept { return this->data_; }
+
+    [[nodiscard]] constexpr ___inline___ iterator end() noexcept {
+      return this->data_ + this->size_;  // NOLINT(*-pointer-arithmetic)
+    }
+
+    [[nodiscard]] constexpr ___inline___ const_iterator begin() const noexcept {
+      return this->data_;
+    }
+
+    [[nodiscard]] constexpr ___inline___ const_iterator end() const noexcept {
+      return this->data_ + this->size_;  // NOLINT(*-pointer-arithmetic)
+    }
+
+    [[nodiscard]] constexpr ___inline___ reference operator[](std::size_t const n) noexcept {
+      return this->data_[n];  // NOLINT(*-constant-array-index)
+    }
+
+    [[nodiscard]] constexpr ___inline___ const_reference operator[](std::size_t const n
+    ) const noexcept {
+      return this->data_[n];  // NOLINT(*-constant-array-index)
+    }
+
+    [[nodiscard]] constexpr ___inline___ const_reference front() const noexcept {
+      return this->data_[0];
+    }
+
+    [[nodiscard]] constexpr ___inline___ const_reference back() const noexcept {
+      return this->data_[this->size_ - 1];  // NOLINT(*-constant-array-index)
+    }
+
+    [[nodiscard]] constexpr ___inline___ std::string_view view() const noexcept {
+      return {this->data_, this->size_};
+    }
+
+    [[nodiscard]] constexpr ___inline___ operator std::string_view() const noexcept {  // NOLINT
+      return this->view();
+    }
+
+    [[nodiscard]] std::string str() const { return std::string(this->view()); }
+
+    /**
+     * @brief Compares the string with @p other lexicographically.
+     * @return Negative value if less, zero if equal, positive value if greater.
+     */
+    [[nodiscard]] constexpr ___inline___ int compare(std::string_view const other) const noexcept {
+      return this->view().compare(other);
+    }
+
+    /**
+     * @brief Hash of the characters; the same as `std::hash` of a @ref fixed_string with the
+     * same characters.
+     */
+    [[nodiscard]] constexpr ___inline___ std::size_t hash() const noexcept {
+      return static_cast<std::size_t>(crypto::fast_hash64(this->view()));
+    }
+
+    constexpr void swap(inline_string& other) noexcept {
+      auto const tmp = *this;
+      *this = other;
+      other = tmp;
+    }
+
+    [[nodiscard]] friend constexpr bool
+      operator==(inline_string const& lhs, std::string_view const rhs) noexcept {
+      return lhs.view() == rhs;
+    }
+
+    [[nodiscard]] friend constexpr bool
+      operator!=(inline_string const& lhs, std::string_view const rhs) noexcept {
+      return lhs.view() != rhs;
+    }
+
+    [[nodiscard]] friend constexpr bool
+      operator==(std::string_view const lhs, inline_string const& rhs) noexcept {
+      return lhs == rhs.view();
+    }
+
+    [[nodiscard]] friend constexpr bool
+      operator!=(std::string_view const lhs, inline_string const& rhs) noexcept {
+      return lhs != rhs.view();
+    }
+
+   private:
+    constexpr void assign_unchecked(char const* str, std::size_t const size) noexcept {
+      for(auto i = std::size_t(0); i < size; ++i)
+        this->data_[i] = str[i];  // NOLINT(*-pointer-arithmetic)
+      this->size_ = static_cast<size_type>(size);
+    }
+
+    /// The characters and the terminator, rounded up so that no padding precedes the length.
+    static constexpr auto storage_size =
+      (N + 1 + sizeof(size_type) - 1) / sizeof(size_type) * sizeof(size_type);
+    static_assert(storage_size % alignof(size_type) == 0);
+
+    char data_[storage_size] = {};  // NOLINT(*-avoid-c-arrays)
+    size_type size_ = 0;
+  };
+
+  /**
+   * @brief Compares the contents of two inline strings for equality.
+   * @relates inline_string
+   */
+  template <std::size_t N1, std::size_t N2>
+  [[nodiscard]] constexpr ___inline___ bool
+    operator==(inline_string<N1> const& lhs, inline_string<N2> const& rhs) noexcept {
+    return lhs.view() == rhs.view();
+  }
+
+  template <std::size_t N1, std::size_t N2>
+  [[nodiscard]] constexpr ___inline___ bool
+    operator!=(inline_string<N1> const& lhs, inline_string<N2> const& rhs) noexcept {
+    return lhs.view() != rhs.view();
+  }
+
+  /**
+   * @brief Compares the contents of two inline strings lexicographically.
+   * @relates inline_string
+   */
+  template <std::size_t N1, std::size_t N2>
+  [[nodiscard]] constexpr ___inline___ bool
+    operator<(inline_string<N1> const& lhs, inline_string<N2> const& rhs) noexcept {
+    return lhs.view() < rhs.view();
+  }
+
+  template <std::size_t N1, std::size_t N2>
+  [[nodiscard]] constexpr ___inline___ bool
+    operator>(inline_string<N1> const& lhs, inline_string<N2> const& rhs) noexcept {
+    return rhs < lhs;
+  }
+
+  template <std::size_t N1, std::size_t N2>
+  [[nodiscard]] constexpr ___inline___ bool
+    operator<=(inline_string<N1> const& lhs, inline_string<N2> const& rhs) noexcept {
+    return not (rhs < lhs);
+  }
+
+  template <std::size_t N1, std::size_t N2>
+  [[nodiscard]] constexpr ___inline___ bool
+    operator>=(inline_string<N1> const& lhs, inline_string<N2> const& rhs) noexcept {
+    return not (lhs < rhs);
+  }
+
+  template <std::size_t N>
+  inline_string(char const (&)[N]) -> inline_string<N - 1>;  // NOLINT(*-avoid-c-arrays)
+}  // namespace rll
+
+namespace std {
+  /**
+   * @brief Hashes an <tt>inline_string</tt>.
+   * @tparam N Capacity of the <tt>inline_string</tt>.
+   * @relates rll::inline_string
+   */
+  template <std::size_t N>
+  struct hash<rll::inline_string<N>> {
+    constexpr std::size_t operator()(rll::inline_string<N> const& str) const noexcept {
+      return str.hash();
+    }
+  };
+}  // namespace std
+
+/**
+ * @brief Specialization of the `fmt::formatter` for the rll::inline_string class.
+ */
+template <std::size_t N>
+struct [[maybe_unused]] fmt::formatter<rll::inline_string<N>> : formatter<std::string_view> {
+  template <typename FormatContext>
+  auto format(rll::inline_string<N> const& str, FormatContext& ctx) const {
+    return formatter<std::string_view>::format(str.view(), ctx);
+  }
+};
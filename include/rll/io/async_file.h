@@ -0,0 +1,204 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <vector>
+#include <rll/global/export.h>
+#include <rll/result.h>
+#include <rll/stdint.h>
+#include <rll/traits/pimpl.h>
+#ifndef Q_MOC_RUN
+#  include <filesystem>
+#endif
+
+namespace rll::io {
+  /**
+   * @brief How an @ref async_file is opened.
+   */
+  enum class open_mode {
+    read,       ///< Read only. The file must exist.
+    write,      ///< Write only. The file is created if missing and never truncated.
+    read_write  ///< Read and write. The file is created if missing and never truncated.
+  };
+
+  /**
+   * @brief Mechanism an @ref async_file performs its operations with.
+   */
+  enum class async_backend {
+    io_uring,    ///< Linux io_uring: operations are queued to the kernel in batches.
+    thread_pool  ///< Worker threads doing positional reads and writes.
+  };
+
+  /**
+   * @brief Tuning parameters of an @ref async_file.
+   */
+  struct async_options {
+    /// Operations in flight at once; submitting more blocks until earlier ones complete.
+    u32 queue_depth = 64;
+
+    /// Worker threads of the thread pool backend.
+    u32 threads = 2;
+
+    /// Use io_uring when the kernel provides it. When disabled, or when io_uring is unavailable
+    /// (old kernel, seccomp filter, not Linux), the thread pool backend is used.
+    bool io_uring = true;
+  };
+
+  /**
+   * @brief File with asynchronous positional reads and writes.
+   * @details Operations are submitted without waiting for the disk, so a thread that has to meet
+   * a deadline can hand its buffers off and carry on. Each operation reads or writes the whole
+   * buffer at an explicit offset and reports the number of bytes transferred, which is only
+   * smaller than requested when a read reaches the end of the file.
+   *
+   * On Linux the operations are queued to the kernel through io_uring, and a whole batch costs a
+   * single system call. Elsewhere, or when io_uring is not available, they run on a small
+   * thread pool. @ref backend tells which one is in use.
+   *
+   * Completions are reported on an internal thread, either through a callback or a
+   * `std::future`. Callbacks must not throw and should return quickly; they may submit further
+   * operations. Buffers must stay valid until their operation completes, and operations on
+   * overlapping ranges are not ordered with respect to each other. The destructor waits for all
+   * operations in flight. Move-only.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * auto file = rll::io::async_file::open("scans.bin", rll::io::open_mode::write).value();
+   * file.write(offset, scan.data(), scan.size(), [](rll::result<std::size_t> res) {
+   *   if(not res)
+   *     report_lost_scan(res.error());
+   * });
+   * @endcode
+   */
+  class RLL_API async_file {
+   public:
+    /**
+     * @brief Completion callback. Receives the number of bytes transferred or the error.
+     */
+    using completion = std::function<void(result<std::size_t>)>;
+
+    /**
+     * @brief Read or write that is part of a batch passed to @ref submit.
+     */
+    struct operation {
+      enum class kind {
+        read,
+        write
+      };
+
+      kind type = kind::read;
+      u64 offset = 0;
+      void* data = nullptr;
+      std::size_t size = 0;
+      completion done;
+
+      [[nodiscard]] static operation
+        read(u64 offset, void* buffer, std::size_t size, completion done) noexcept {
+        return {kind::read, offset, buffer, size, std::move(done)};
+      }
+
+      [[nodiscard]] static operation
+        write(u64 offset, void const* data, std::size_t size, completion done) noexcept {
+        return {kind::write, offset, const_cast<void*>(data), size, std::move(done)};  // NOLINT
+      }
+    };
+
+    /**
+     * @brief Memory region passed to @ref register_buffers.
+     */
+    struct buffer {
+      void* data = nullptr;
+      std::size_t size = 0;
+    };
+
+    /**
+     * @brief Opens the file at @p path.
+     * @param path File to open. A created file gets @ref filedevice::write_permissions.
+     * @param mode Access mode.
+     * @param options Queue depth and backend selection.
+     */
+    [[nodiscard]] static result<async_file> open(
+      std::filesystem::path const& path,
+      open_mode mode,
+      async_options const& options = {}
+    ) noexcept;
+
+    async_file(async_file const&) = delete;
+    async_file(async_file&&) noexcept;
+    async_file& operator=(async_file const&) = delete;
+    async_file& operator=(async_file&&) noexcept;
+    ~async_file();
+
+    [[nodiscard]] async_backend backend() const noexcept;
+
+    /**
+     * @brief Current size of the file.
+     */
+    [[nodiscard]] result<u64> size() const noexcept;
+
+    /**
+     * @brief Submits all operations of @p batch at once.
+     * @details With io_uring this is a single system call for up to
+     * @ref async_options::queue_depth operations. Blocks while the queue is full.
+     * @return An error if the batch could not be accepted; none of its callbacks is called then.
+     * Every accepted operation completes exactly once through its callback, with an error if it
+     * could not be performed.
+     */
+    [[nodiscard]] result<> submit(std::vector<operation> batch) noexcept;
+
+    /**
+     * @brief Reads @p size bytes at @p offset into @p buffer and calls @p done when finished.
+     */
+    [[nodiscard]] result<>
+      read(u64 offset, void* buffer, std::size_t size, completion done) noexcept;
+
+    /**
+     * @brief Writes @p size bytes of @p data at @p offset and calls @p done when finished.
+     */
+    [[nodiscard]] result<>
+      write(u64 offset, void const* data, std::size_t size, completion done) noexcept;
+
+    /**
+     * @brief Reads @p size bytes at @p offset into @p buffer.
+     * @return Future of the number of bytes read. Submission errors are reported through it too.
+     */
+    [[nodiscard]] std::future<result<std::size_t>>
+      read(u64 offset, void* buffer, std::size_t size);
+
+    /**
+     * @brief Writes @p size bytes of @p data at @p offset.
+     * @return Future of the number of bytes written. Submission errors are reported through it
+     * too.
+     */
+    [[nodiscard]] std::future<result<std::size_t>>
+      write(u64 offset, void const* data, std::size_t size);
+
+    /**
+     * @brief Registers long-lived I/O buffers with the kernel.
+     * @details With io_uring, operations whose memory lies inside a registered buffer skip
+     * mapping and pinning the pages on every call. Replaces earlier registrations and waits for
+     * the operations in flight first. Does nothing with the thread pool backend.
+     * @note Registered memory is locked and counts against `RLIMIT_MEMLOCK`.
+     */
+    [[nodiscard]] result<> register_buffers(std::vector<buffer> const& buffers) noexcept;
+
+    /**
+     * @brief Releases the buffers registered with @ref register_buffers.
+     */
+    void unregister_buffers() noexcept;
+
+    /**
+     * @brief Waits until every submitted operation has completed and its callback has returned.
+     * @warning Must not be called from a completion callback.
+     */
+    void drain() noexcept;
+
+   private:
+    struct impl;
+
+    explicit async_file(std::unique_ptr<impl> i) noexcept;
+
+    pimpl<impl> impl_;
+  };
+}  // namespace rll::io
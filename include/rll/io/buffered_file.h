@@ -0,0 +1,186 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <rll/global/export.h>
+#include <rll/optional.h>
+#include <rll/result.h>
+#include <rll/stdint.h>
+#include <rll/traits/pimpl.h>
+#ifndef Q_MOC_RUN
+#  include <filesystem>
+#endif
+
+namespace rll::io {
+  /**
+   * @brief Buffering parameters of a @ref file_reader or @ref file_writer.
+   */
+  struct stream_options {
+    /// Size of the buffer, which is also the size of each system call.
+    std::size_t buffer_size = std::size_t(1) << 20U;
+
+    /// Evict the processed part of the file from the page cache as the stream moves on, so that
+    /// streaming a file larger than memory does not push everything else out of the cache.
+    /// Written data is also handed to the disk in buffer-sized steps instead of in one burst.
+    /// Only has an effect on Linux.
+    bool drop_behind = false;
+  };
+
+  /**
+   * @brief How a @ref file_writer treats an existing file.
+   */
+  enum class write_mode {
+    truncate,  ///< Replace the contents.
+    append     ///< Write after the existing contents.
+  };
+
+  /**
+   * @brief Buffered sequential reader for files of any size.
+   * @details Unlike @ref filedevice::read, which loads the whole file, the reader holds one buffer
+   * of @ref stream_options::buffer_size bytes and refills it as the file is consumed. The views
+   * returned by @ref next_chunk and @ref next_line point into that buffer, so reading a file does
+   * not allocate after the reader is opened. The buffer only grows when a single line is longer
+   * than it. Move-only.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * auto reader = rll::io::file_reader::open("recording.csv").value();
+   * while(auto const line = reader.next_line().value())
+   *   consume(*line);
+   * @endcode
+   */
+  class RLL_API file_reader {
+   public:
+    /**
+     * @brief Opens the file at @p path for reading.
+     */
+    [[nodiscard]] static result<file_reader>
+      open(std::filesystem::path const& path, stream_options const& options = {}) noexcept;
+
+    file_reader(file_reader const&) = delete;
+    file_reader(file_reader&&) noexcept;
+    file_reader& operator=(file_reader const&) = delete;
+    file_reader& operator=(file_reader&&) noexcept;
+    ~file_reader();
+
+    /**
+     * @brief Copies the next @p size bytes into @p buffer.
+     * @details Requests of at least the buffer size are read directly into @p buffer.
+     * @return Number of bytes read, smaller than @p size only at the end of the file.
+     */
+    [[nodiscard]] result<std::size_t> read_chunk(void* buffer, std::size_t size) noexcept;
+
+    /**
+     * @brief Returns the next block of the file, at most the buffer size long.
+     * @details The view stays valid until the next call on the reader. It is empty at the end of
+     * the file.
+     */
+    [[nodiscard]] result<std::string_view> next_chunk() noexcept;
+
+    /**
+     * @brief Returns the next line, without its newline character.
+     * @details The view stays valid until the next call on the reader. As with `std::getline`,
+     * a last line without a newline is returned, but there is no empty line after a final
+     * newline, and a `'\r'` before the newline is kept.
+     * @return The line, or nothing at the end of the file.
+     */
+    [[nodiscard]] result<optional<std::string_view>> next_line() noexcept;
+
+    /**
+     * @brief Offset in the file of the next byte to be returned.
+     */
+    [[nodiscard]] u64 position() const noexcept;
+
+    /**
+     * @brief Moves to @p offset in the file, discarding the buffered data.
+     */
+    [[nodiscard]] result<> seek(u64 offset) noexcept;
+
+    /**
+     * @brief Current size of the file.
+     */
+    [[nodiscard]] result<u64> size() const noexcept;
+
+   private:
+    struct impl;
+
+    explicit file_reader(std::unique_ptr<impl> i) noexcept;
+
+    pimpl<impl> impl_;
+  };
+
+  /**
+   * @brief Buffered sequential writer for files of any size.
+   * @details Counterpart of @ref file_reader. Small writes are collected in a buffer of
+   * @ref stream_options::buffer_size bytes and written when it is full; writes of at least the
+   * buffer size go to the file directly. Nothing is allocated after the writer is opened.
+   *
+   * The destructor writes out the buffer but cannot report errors, so @ref close should be called
+   * when they matter. Move-only.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * auto writer = rll::io::file_writer::open("export.csv").value();
+   * for(auto const& row : rows)
+   *   if(auto const res = writer.write(row); not res)
+   *     return res;
+   * return writer.close();
+   * @endcode
+   */
+  class RLL_API file_writer {
+   public:
+    /**
+     * @brief Opens the file at @p path for writing.
+     * @details Missing parent directories are created, and a new file gets
+     * @ref filedevice::write_permissions.
+     */
+    [[nodiscard]] static result<file_writer> open(
+      std::filesystem::path const& path,
+      write_mode mode = write_mode::truncate,
+      stream_options const& options = {}
+    ) noexcept;
+
+    file_writer(file_writer const&) = delete;
+    file_writer(file_writer&&) noexcept;
+    file_writer& operator=(file_writer const&) = delete;
+    file_writer& operator=(file_writer&&) noexcept;
+    ~file_writer();
+
+    /**
+     * @brief Appends @p data to the file.
+     */
+    [[nodiscard]] result<> write(std::string_view data) noexcept;
+
+    /**
+     * @brief Appends @p size bytes of @p data to the file.
+     */
+    [[nodiscard]] result<> write(void const* data, std::size_t size) noexcept;
+
+    /**
+     * @brief Hands the buffered data to the operating system.
+     */
+    [[nodiscard]] result<> flush() noexcept;
+
+    /**
+     * @brief Flushes the buffer and waits until the data has reached the storage device.
+     */
+    [[nodiscard]] result<> sync() noexcept;
+
+    /**
+     * @brief Flushes the buffer and closes the file. Further writes fail.
+     */
+    [[nodiscard]] result<> close() noexcept;
+
+    /**
+     * @brief Size of the file including the buffered data.
+     */
+    [[nodiscard]] u64 position() const noexcept;
+
+   private:
+    struct impl;
+
+    explicit file_writer(std::unique_ptr<impl> i) noexcept;
+
+    pimpl<impl> impl_;
+  };
+}  // namespace rll::io
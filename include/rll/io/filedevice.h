@@ -1,8 +1,11 @@
 #pragma once
 
+#include <algorithm>
 #include <utility>
 #include <fstream>
 #include <rll/result.h>
+#include <rll/global/export.h>
+#include <rll/io/mapped_file.h>
 #ifndef Q_MOC_RUN
 #  include <filesystem>
 #endif
@@ -12,6 +15,18 @@ namespace rll {
    * @brief IO-related functions and classes.
    */
   namespace io {
+    /**
+     * @brief How much of an atomic write must reach storage before it returns.
+     * @details With any level, an atomic write replaces the target as a whole, so readers and
+     * a crashed process never see a half-written file. The levels differ in what survives a
+     * power loss or kernel crash.
+     */
+    enum class durability {
+      none,  ///< Nothing is synced; after a power loss the file may be old, new or empty.
+      data,  ///< The new contents are synced before the rename; the file is old or new.
+      full   ///< The directory is synced too, so the rename itself survives a power loss.
+    };
+
     class filedevice {
      public:
       static constexpr auto write_permissions = std::filesystem::perms::owner_read
@@ -40,6 +55,18 @@ namespace rll {
 
       [[nodiscard]] std::string read() const { return filedevice::read_from(this->path()); }
 
+      /**
+       * @brief Maps the file into memory instead of reading it into a string.
+       * @details Preferred for large files: nothing is copied, and pages are loaded on first
+       * access.
+       * @param hint Expected access pattern.
+       * @see mapped_file
+       */
+      [[nodiscard]] result<mapped_file> map(access_hint const hint = access_hint::sequential
+      ) const noexcept {
+        return mapped_file::open(this->path(), hint);
+      }
+
       [[nodiscard]] result<std::string> try_read() const noexcept {
         return filedevice::try_read_from(this->path());
       }
@@ -52,13 +79,35 @@ namespace rll {
         return filedevice::try_write_to(this->path(), content);
       }
 
+      /**
+       * @brief Replaces the file with @p content atomically.
+       * @see try_write_atomic_to
+       */
+      void write_atomic(std::string_view content, durability level = durability::data) const
+        noexcept(false) {
+        filedevice::write_atomic_to(this->path(), content, level);
+      }
+
+      /**
+       * @brief Replaces the file with @p content atomically.
+       * @see try_write_atomic_to
+       */
+      [[nodiscard]] result<>
+        try_write_atomic(std::string_view content, durability level = durability::data)
+          const noexcept {
+        return filedevice::try_write_atomic_to(this->path(), content, level);
+      }
+
       [[nodiscard]] static std::string read_from(std::filesystem::path const& path) {
         auto handle = std::ifstream(path);
         if(not handle.is_open())
           throw std::runtime_error(
             "failed to open file handle for reading at " + path.generic_string()
           );
-        return {(std::istreambuf_iterator<char>(handle)), std::istreambuf_iterator<char>()};
+        auto res = std::string();
+        if(not filedevice::read_all(handle, path, res))
+          throw std::runtime_error("failed to read from file at " + path.generic_string());
+        return res;
       }
 
       [[nodiscard]] static result<std::string> try_read_from(
@@ -67,9 +116,10 @@ namespace rll {
         auto handle = std::ifstream(path);
         if(not handle.is_open())
           return error("failed to open file handle for reading at \'{}\'", path.generic_string());
-        return ok<std::string>(
-          {(std::istreambuf_iterator<char>(handle)), std::istreambuf_iterator<char>()}
-        );
+        auto res = std::string();
+        if(not filedevice::read_all(handle, path, res))
+          return error("failed to read from file at \'{}\'", path.generic_string());
+        return ok<std::string>(std::move(res));
       }
 
       static void write_to(std::filesystem::path const& path, std::string_view content) noexcept(
@@ -79,12 +129,13 @@ namespace rll {
 
         if(not fs::exists(path.parent_path()))
           fs::create_directories(path.parent_path());
+        auto const created = not fs::exists(path);
         auto handle = std::ofstream(path);
         if(not handle.is_open())
           throw std::runtime_error(
             "failed to open file handle for writing at " + path.generic_string()
           );
-        if(fs::exists(path))
+        if(created)
           fs::permissions(path, filedevice::write_permissions);
         handle << content;
         if(not handle.good())
@@ -97,10 +148,11 @@ namespace rll {
 
         if(not fs::exists(path.parent_path()))
           fs::create_directories(path.parent_path());
+        auto const created = not fs::exists(path);
         auto handle = std::ofstream(path);
         if(not handle.is_open())
           return error("failed to open file handle for writing at \'{}\'", path.generic_string());
-        if(fs::exists(path))
+        if(created)
           fs::permissions(path, filedevice::write_permissions);
         handle << content;
         if(not handle.good())
@@ -108,7 +160,56 @@ namespace rll {
         return ok();
       }
 
+      static void write_atomic_to(
+        std::filesystem::path const& path,
+        std::string_view content,
+        durability level = durability::data
+      ) noexcept(false) {
+        if(auto const res = filedevice::try_write_atomic_to(path, content, level); not res)
+          throw std::runtime_error(res.error());
+      }
+
+      /**
+       * @brief Replaces the file at @p path with @p content atomically.
+       * @details Unlike @ref try_write_to, which truncates the file in place, the content is
+       * written to a temporary file next to the target and then renamed over it. A crash at any
+       * point leaves either the old or the new file, never a torn one. Permissions are taken
+       * from the file being replaced, or are @ref write_permissions for a new file, and no
+       * `.bak` copy is needed.
+       * @param path File to replace; missing parent directories are created.
+       * @param content New contents.
+       * @param level What must be synced to storage before returning.
+       */
+      [[nodiscard]] RLL_API static result<> try_write_atomic_to(
+        std::filesystem::path const& path,
+        std::string_view content,
+        durability level = durability::data
+      ) noexcept;
+
      private:
+      /**
+       * Reads the rest of @p handle into @p out in bulk: one read of the file size, then blocks
+       * for whatever the size did not account for (a growing file, or a pseudo-file that
+       * reports a size of zero).
+       */
+      [[nodiscard]] static bool
+        read_all(std::ifstream& handle, std::filesystem::path const& path, std::string& out) {
+        constexpr auto block = std::streamsize(64) << 10U;
+        auto ec = std::error_code();
+        auto const size = std::filesystem::file_size(path, ec);
+        // one more byte than expected, so that a file of the expected size ends in one read
+        auto chunk = ec ? block : static_cast<std::streamsize>(size) + 1;
+        auto used = std::size_t(0);
+        while(handle) {
+          out.resize(used + static_cast<std::size_t>(chunk));
+          handle.read(out.data() + used, chunk);  // NOLINT(*-pointer-arithmetic)
+          used += static_cast<std::size_t>(handle.gcount());
+          chunk = std::max(chunk, block);
+        }
+        out.resize(used);
+        return not handle.bad();
+      }
+
       std::filesystem::path path_;
     };
   }  // namespace io
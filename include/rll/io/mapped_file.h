@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <rll/global/export.h>
+#include <rll/result.h>
+#include <rll/stdint.h>
+#ifndef Q_MOC_RUN
+#  include <filesystem>
+#endif
+
+namespace rll::io {
+  /**
+   * @brief Expected access pattern of a @ref mapped_file, passed to the OS as a paging hint.
+   */
+  enum class access_hint {
+    normal,      ///< No hint.
+    sequential,  ///< Read front to back: pages are read ahead aggressively and dropped early.
+    random,      ///< Read in no particular order: read-ahead is disabled.
+    will_need    ///< The whole file will be read soon: it is paged in in the background.
+  };
+
+  /**
+   * @brief Read-only memory mapping of a whole file.
+   * @details The file is paged in on demand instead of being copied into a buffer, so a large
+   * recording costs no extra memory and can be scanned as soon as it is opened. The mapping is
+   * released when the object is destroyed. Move-only. An empty file yields an empty view without
+   * creating a mapping.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * auto const file = rll::io::mapped_file::open("recording.csv");
+   * if(file)
+   *   for(auto const line : rll::split_view(file->view(), '\n'))
+   *     consume(line);
+   * @endcode
+   */
+  class RLL_API mapped_file {
+   public:
+    mapped_file() noexcept = default;
+    mapped_file(mapped_file const&) = delete;
+    mapped_file(mapped_file&& other) noexcept;
+    mapped_file& operator=(mapped_file const&) = delete;
+    mapped_file& operator=(mapped_file&& other) noexcept;
+    ~mapped_file();
+
+    /**
+     * @brief Maps the file at @p path.
+     * @param path File to map.
+     * @param hint Expected access pattern.
+     */
+    [[nodiscard]] static result<mapped_file>
+      open(std::filesystem::path const& path, access_hint hint = access_hint::sequential) noexcept;
+
+    /**
+     * @brief Changes the access pattern hint of the whole mapping.
+     * @details On Windows the access pattern is fixed when the file is opened, and only
+     * @ref access_hint::will_need has an effect here.
+     */
+    void advise(access_hint hint) const noexcept;
+
+    [[nodiscard]] u8 const* data() const noexcept { return this->data_; }
+
+    [[nodiscard]] std::size_t size() const noexcept { return this->size_; }
+
+    [[nodiscard]] bool empty() const noexcept { return this->size_ == 0; }
+
+    [[nodiscard]] u8 const* begin() const noexcept { return this->data_; }
+
+    [[nodiscard]] u8 const* end() const noexcept {
+      return this->data_ + this->size_;  // NOLINT(*-pointer-arithmetic)
+    }
+
+    [[nodiscard]] std::string_view view() const noexcept {
+      return {reinterpret_cast<char const*>(this->data_), this->size_};  // NOLINT
+    }
+
+   private:
+    void unmap() noexcept;
+
+    u8 const* data_ = nullptr;
+    std::size_t size_ = 0;
+  };
+}  // namespace rll::io
@@ -1,11 +1,19 @@
 #pragma once
 
 #include <sstream>
+#include <rll/optional.h>
 #include <rll/serialization.h>
 #include <rll/stdint.h>
+#include <rll/crypto/fast_hash.h>
 #include <rll/io/filedevice.h>
 
 namespace rll {
+  /**
+   * @brief Values of type @p T persisted to a file in format @p F.
+   * @details The savefile remembers a hash of the serialized values it last loaded or saved, and
+   * @ref save only touches the disk when the values serialize differently. Closing a savefile
+   * whose values were not changed therefore does no I/O.
+   */
   template <typename F, typename T, typename = std::enable_if_t<is_serializable<T, F>::value>>
   class savefile : public io::filedevice {
    public:
@@ -24,7 +32,7 @@ namespace rll {
 
     /**
      * @brief Closes the savefile.
-     * @details File will be saved automatically on closing.
+     * @details File will be saved automatically on closing if the values have changed.
      */
     virtual ~savefile() noexcept {
       this->save().map_error([&](auto const& err) {
@@ -67,22 +75,42 @@ namespace rll {
       if(not res)
         return error(res.error());
       this->values_ = *res;
+      // the canonical form, so that a file formatted by hand is not rewritten unchanged; without
+      // it, the next save writes unconditionally
+      auto const bytes = this->serialize();
+      this->persisted_hash_ = bytes ? optional<u64>(crypto::fast_hash64(*bytes)) : nullopt;
       return ok();
     }
 
+    /**
+     * @brief Writes the values to the file and refreshes the backup, unless they are unchanged
+     * since they were last loaded or saved.
+     * @details The file is replaced atomically, so a crash while saving leaves the previous
+     * version rather than a truncated one.
+     */
     result<> save() const {
-      auto try_serialize = [this]() -> result<std::string> {
-        auto ss = std::stringstream();
-        auto const res = serializer<T, F, char>::serialize(this->values_, ss);
-        if(not res)
-          return error(res.error());
-        return ok(ss.str());
-      };
-      try_serialize().and_then([this](auto const& str) { return this->try_write(str); }
-      ).and_then([this]() { return this->try_commit(); });
+      auto const bytes = this->serialize();
+      if(not bytes)
+        return unexpected(bytes.error());
+      auto const hash = crypto::fast_hash64(*bytes);
+      if(this->persisted_hash_ == hash)
+        return ok();
+      if(auto const res = this->try_write_atomic(*bytes, io::durability::none); not res)
+        return res;
+      if(auto const res = this->try_commit(); not res)
+        return res;
+      this->persisted_hash_ = hash;
       return ok();
     }
 
+    /**
+     * @brief Returns whether the values differ from what was last loaded or saved.
+     */
+    [[nodiscard]] bool dirty() const {
+      auto const bytes = this->serialize();
+      return not bytes or this->persisted_hash_ != crypto::fast_hash64(*bytes);
+    }
+
     /**
      * @brief Swaps the current savefile with its backup.
      */
@@ -102,9 +130,11 @@ namespace rll {
      */
     [[nodiscard]] result<> try_commit() const noexcept {
       try {
-        if(std::filesystem::exists(this->backing_path()))
-          std::filesystem::remove_all(this->backing_path());
-        std::filesystem::copy(this->path(), this->backing_path());
+        std::filesystem::copy_file(
+          this->path(),
+          this->backing_path(),
+          std::filesystem::copy_options::overwrite_existing
+        );
         return ok();
       } catch(std::exception const& ex) {
         return error("{}", ex.what());
@@ -140,8 +170,16 @@ namespace rll {
     savefile& operator=(savefile&&) = default;
 
    private:
+    [[nodiscard]] result<std::string> serialize() const {
+      auto ss = std::stringstream();
+      if(auto const res = serializer<T, F, char>::serialize(this->values_, ss); not res)
+        return unexpected(res.error());
+      return ss.str();
+    }
+
     T values_;
     std::filesystem::path backing_path_;
     bool valid_;
+    mutable optional<u64> persisted_hash_;
   };
 }  // namespace rll
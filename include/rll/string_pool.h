@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <fmt/format.h>
+#include <rll/global/export.h>
+#include <rll/optional.h>
+#include <rll/stdint.h>
+#include <rll/traits/pimpl.h>
+
+#ifdef _MSC_VER
+#  include <ciso646>
+#endif
+
+namespace rll {
+  class string_pool;
+
+#ifndef DOXYGEN
+  namespace detail {
+    /// Header stored in front of the characters of every interned string.
+    struct interned_header {
+      u32 size;
+      u32 id;
+    };
+  }  // namespace detail
+#endif
+
+  /**
+   * @brief String deduplicated by a @ref string_pool.
+   * @details A single pointer to characters owned by the pool, which stay valid and at the same
+   * address until the pool is destroyed. Equal strings interned into the same pool are the same
+   * object, so equality and hashing compare the pointer instead of the characters. Strings from
+   * different pools are never equal, even if their characters are.
+   *
+   * A default-constructed interned string is the empty string, and is equal to the empty string
+   * of every pool.
+   */
+  class interned_string {
+   public:
+    constexpr interned_string() noexcept = default;
+
+    /**
+     * @brief Characters of the string, null-terminated.
+     */
+    [[nodiscard]] constexpr char const* data() const noexcept {
+      return this->data_ == nullptr ? "" : this->data_;
+    }
+
+    [[nodiscard]] constexpr char const* c_str() const noexcept { return this->data(); }
+
+    [[nodiscard]] std::size_t size() const noexcept { return this->header().size; }
+
+    [[nodiscard]] constexpr bool empty() const noexcept { return this->data_ == nullptr; }
+
+    [[nodiscard]] std::string_view view() const noexcept { return {this->data(), this->size()}; }
+
+    [[nodiscard]] operator std::string_view() const noexcept {  // NOLINT(*-explicit-*)
+      return this->view();
+    }
+
+    [[nodiscard]] std::string str() const { return std::string(this->view()); }
+
+    /**
+     * @brief 32-bit handle of the string in its pool, for compact storage in records.
+     * @details The empty string is always `0`. @ref string_pool::at maps a handle back to the
+     * string.
+     */
+    [[nodiscard]] u32 id() const noexcept { return this->header().id; }
+
+    [[nodiscard]] friend constexpr bool
+      operator==(interned_string const a, interned_string const b) noexcept {
+      return a.data_ == b.data_;
+    }
+
+    [[nodiscard]] friend constexpr bool
+      operator!=(interned_string const a, interned_string const b) noexcept {
+      return a.data_ != b.data_;
+    }
+
+   private:
+    friend class string_pool;
+    friend struct std::hash<interned_string>;
+
+    constexpr explicit interned_string(char const* data) noexcept
+      : data_(data) {}
+
+    [[nodiscard]] detail::interned_header header() const noexcept {
+      auto res = detail::interned_header {0, 0};
+      if(this->data_ == nullptr)
+        return res;
+      // NOLINTNEXTLINE(*-pointer-arithmetic)
+      std::memcpy(&res, this->data_ - sizeof(detail::interned_header), sizeof(res));
+      return res;
+    }
+
+    char const* data_ = nullptr;  // null for the empty string
+  };
+
+  /**
+   * @brief Thread-safe set of deduplicated strings.
+   * @details Each distinct string is copied once into arena blocks owned by the pool and handed
+   * out as an @ref interned_string. Storing the same channel, sensor or unit name in millions of
+   * records then costs one pointer (or one 32-bit @ref interned_string::id) per record instead
+   * of a `std::string`.
+   *
+   * The pool is split into shards chosen by the hash of the string, each with its own lock and
+   * arena, so several threads can intern at once. Looking up a string that is already interned
+   * only takes a shared lock. Strings are never removed; their memory is released with the pool.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * auto pool = rll::string_pool();
+   * auto const unit = pool.intern("m/s");
+   * assert(unit == pool.intern(std::string("m/s")));
+   * assert(pool.at(unit.id()) == unit);
+   * @endcode
+   */
+  class RLL_API string_pool {
+   public:
+    string_pool();
+    ~string_pool();
+
+    string_pool(string_pool const&) = delete;
+    string_pool& operator=(string_pool const&) = delete;
+    string_pool(string_pool&&) noexcept;
+    string_pool& operator=(string_pool&&) noexcept;
+
+    /**
+     * @brief Returns the interned copy of @p str, copying it into the pool on first use.
+     * @throws std::length_error If the pool has run out of 32-bit handles.
+     */
+    [[nodiscard]] interned_string intern(std::string_view str);
+
+    /**
+     * @brief Returns the interned copy of @p str, or nothing if it has not been interned.
+     */
+    [[nodiscard]] optional<interned_string> find(std::string_view str) const;
+
+    /**
+     * @brief Returns the string with the handle @p id.
+     * @throws std::out_of_range If no string of this pool has the handle.
+     */
+    [[nodiscard]] interned_string at(u32 id) const;
+
+    /**
+     * @brief Number of distinct non-empty strings in the pool.
+     */
+    [[nodiscard]] std::size_t size() const;
+
+    /**
+     * @brief Bytes allocated for the characters of the strings, including unused block space.
+     */
+    [[nodiscard]] std::size_t memory_usage() const;
+
+   private:
+    struct impl;
+    pimpl<impl> impl_;
+  };
+}  // namespace rll
+
+/**
+ * @brief Specialization of the `std::hash` for the rll::interned_string class.
+ */
+template <>
+struct std::hash<rll::interned_string> {
+  [[nodiscard]] std::size_t operator()(rll::interned_string const& s) const noexcept {
+    return std::hash<char const*>()(s.data_);
+  }
+};
+
+/**
+ * @brief Specialization of the `fmt::formatter` for the rll::interned_string class.
+ */
+template <>
+struct [[maybe_unused]] fmt::formatter<rll::interned_string> : formatter<std::string_view> {
+  template <typename FormatContext>
+  auto format(rll::interned_string const& s, FormatContext& ctx) const {
+    return formatter<std::string_view>::format(s.view(), ctx);
+  }
+};
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <cstddef>
 #include <cstring>
+#include <iterator>
+#include <memory>
 #include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
+#include <fmt/format.h>
 #include <rll/global/export.h>
 
 #ifdef _MSC_VER
@@ -11,6 +17,189 @@
 #endif
 
 namespace rll {
+  /**
+   * @brief Lazy range of the tokens of a string separated by a delimiter.
+   * @details Tokens are `std::string_view`s into the input, so nothing is copied or allocated;
+   * the input must outlive the range. Empty tokens between two delimiters are kept, but a
+   * trailing empty token (input ending with the delimiter) is not, as with `std::getline`. An
+   * empty input has no tokens.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * for(auto const field : rll::split_view("ts,lat,lon", ','))
+   *   consume(field);
+   * @endcode
+   * @see split_by
+   */
+  class split_view {
+   public:
+    class iterator {
+     public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::string_view;
+      using difference_type = std::ptrdiff_t;
+      using reference = std::string_view const&;
+      using pointer = std::string_view const*;
+
+      iterator() = default;
+
+      [[nodiscard]] reference operator*() const noexcept { return this->token_; }
+
+      [[nodiscard]] pointer operator->() const noexcept { return &this->token_; }
+
+      iterator& operator++() noexcept {
+        this->advance(this->next_);
+        return *this;
+      }
+
+      iterator operator++(int) noexcept {
+        auto res = *this;
+        ++*this;
+        return res;
+      }
+
+      [[nodiscard]] friend bool operator==(iterator const& a, iterator const& b) noexcept {
+        return a.token_.data() == b.token_.data();
+      }
+
+      [[nodiscard]] friend bool operator!=(iterator const& a, iterator const& b) noexcept {
+        return not (a == b);
+      }
+
+     private:
+      friend class split_view;
+
+      iterator(std::string_view const input, char const delimiter) noexcept
+        : end_(input.data() + input.size())  // NOLINT(*-pointer-arithmetic)
+        , delimiter_(delimiter) {
+        this->advance(input.empty() ? nullptr : input.data());
+      }
+
+      // `from` is the start of the next token, or null if the last token had no delimiter
+      void advance(char const* from) noexcept {
+        if(from == nullptr or from == this->end_) {
+          this->token_ = {};
+          return;
+        }
+        auto const size = static_cast<std::size_t>(this->end_ - from);
+        auto const* found = static_cast<char const*>(std::memchr(from, this->delimiter_, size));
+        if(found == nullptr) {
+          this->token_ = std::string_view(from, size);
+          this->next_ = nullptr;
+        } else {
+          this->token_ = std::string_view(from, static_cast<std::size_t>(found - from));
+          this->next_ = found + 1;  // NOLINT(*-pointer-arithmetic)
+        }
+      }
+
+      std::string_view token_;
+      char const* next_ = nullptr;
+      char const* end_ = nullptr;
+      char delimiter_ = 0;
+    };
+
+    using const_iterator = iterator;
+
+    constexpr split_view(std::string_view const input, char const delimiter) noexcept
+      : input_(input)
+      , delimiter_(delimiter) {}
+
+    [[nodiscard]] iterator begin() const noexcept { return {this->input_, this->delimiter_}; }
+
+    [[nodiscard]] iterator end() const noexcept { return {}; }
+
+   private:
+    std::string_view input_;
+    char delimiter_;
+  };
+
+  /**
+   * @brief Lazy range of the whitespace-separated tokens of a string.
+   * @details Tokens are the runs of characters other than `' '`, `'\t'`, `'\n'`, `'\v'`,
+   * `'\f'` and `'\r'`, which is what `operator>>` extracts in the classic locale. Tokens are
+   * `std::string_view`s into the input; nothing is copied or allocated.
+   * @see split
+   */
+  class whitespace_split_view {
+   public:
+    class iterator {
+     public:
+      using iterator_category = std::forward_iterator_tag;
+      using value_type = std::string_view;
+      using difference_type = std::ptrdiff_t;
+      using reference = std::string_view const&;
+      using pointer = std::string_view const*;
+
+      iterator() = default;
+
+      [[nodiscard]] reference operator*() const noexcept { return this->token_; }
+
+      [[nodiscard]] pointer operator->() const noexcept { return &this->token_; }
+
+      iterator& operator++() noexcept {
+        this->advance(this->token_.data() + this->token_.size());  // NOLINT(*-pointer-arithmetic)
+        return *this;
+      }
+
+      iterator operator++(int) noexcept {
+        auto res = *this;
+        ++*this;
+        return res;
+      }
+
+      [[nodiscard]] friend bool operator==(iterator const& a, iterator const& b) noexcept {
+        return a.token_.data() == b.token_.data();
+      }
+
+      [[nodiscard]] friend bool operator!=(iterator const& a, iterator const& b) noexcept {
+        return not (a == b);
+      }
+
+     private:
+      friend class whitespace_split_view;
+
+      explicit iterator(std::string_view const input) noexcept
+        : end_(input.data() + input.size()) {  // NOLINT(*-pointer-arithmetic)
+        this->advance(input.data());
+      }
+
+      [[nodiscard]] static constexpr bool space(char const c) noexcept {
+        return c == ' ' or (c >= '\t' and c <= '\r');
+      }
+
+      // NOLINTBEGIN(*-pointer-arithmetic)
+      void advance(char const* p) noexcept {
+        while(p != this->end_ and space(*p))
+          ++p;
+        if(p == this->end_) {
+          this->token_ = {};
+          return;
+        }
+        auto const* last = p + 1;
+        while(last != this->end_ and not space(*last))
+          ++last;
+        this->token_ = std::string_view(p, static_cast<std::size_t>(last - p));
+      }
+
+      // NOLINTEND(*-pointer-arithmetic)
+
+      std::string_view token_;
+      char const* end_ = nullptr;
+    };
+
+    using const_iterator = iterator;
+
+    constexpr explicit whitespace_split_view(std::string_view const input) noexcept
+      : input_(input) {}
+
+    [[nodiscard]] iterator begin() const noexcept { return iterator(this->input_); }
+
+    [[nodiscard]] iterator end() const noexcept { return {}; }
+
+   private:
+    std::string_view input_;
+  };
+
   [[nodiscard]] RLL_API std::vector<std::string> split(std::string const& input);
 
   [[nodiscard]] RLL_API std::vector<std::string> split(std::string_view input);
@@ -19,8 +208,267 @@ namespace rll {
 
   [[nodiscard]] RLL_API std::vector<std::string> split_by(std::string_view input, char delimiter);
 
+  /**
+   * @brief Returns a copy of @p input with the ASCII letters `A`-`Z` lowered.
+   * @details Independent of the global locale: all other bytes, including the bytes of UTF-8
+   * sequences, are copied unchanged. Converts 16 or 32 bytes per step with SSE2, AVX2 or NEON.
+   */
   [[nodiscard]] RLL_API std::string to_lower(std::string_view input);
 
+  /**
+   * @brief Returns a copy of @p input with the ASCII letters `a`-`z` raised.
+   * @see to_lower(std::string_view)
+   */
+  [[nodiscard]] RLL_API std::string to_upper(std::string_view input);
+
+  /**
+   * @brief Writes @p input with the ASCII letters lowered to @p out, which must have room for
+   * `input.size()` characters. @p out may be `input.data()` to convert in place.
+   * @return Pointer past the last written character.
+   */
+  RLL_API char* to_lower(std::string_view input, char* out) noexcept;
+
+  /**
+   * @brief Writes @p input with the ASCII letters raised to @p out.
+   * @see to_lower(std::string_view, char*)
+   */
+  RLL_API char* to_upper(std::string_view input, char* out) noexcept;
+
+  RLL_API void to_lower_in_place(std::string& str) noexcept;
+
+  RLL_API void to_upper_in_place(std::string& str) noexcept;
+
+  /**
+   * @brief Compares two strings ignoring the case of ASCII letters, without copying them.
+   */
+  [[nodiscard]] RLL_API bool iequals(std::string_view a, std::string_view b) noexcept;
+
+  /**
+   * @brief Hash of a string that ignores the case of ASCII letters, consistent with @ref iequals.
+   * @details Together with @ref iequal_to, keys lookup tables such as HTTP header or protocol
+   * keyword maps without lowering a copy of every key. Both are transparent, so a
+   * `std::string`-keyed table can be searched with a `std::string_view` in C++20.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * auto methods = std::unordered_map<std::string, method, rll::ihash, rll::iequal_to>();
+   * @endcode
+   */
+  struct ihash {
+    using is_transparent = void;
+
+    [[nodiscard]] RLL_API std::size_t operator()(std::string_view input) const noexcept;
+  };
+
+  /**
+   * @brief Equality predicate ignoring the case of ASCII letters.
+   * @see ihash
+   */
+  struct iequal_to {
+    using is_transparent = void;
+
+    [[nodiscard]] bool operator()(std::string_view const a, std::string_view const b)
+      const noexcept {
+      return iequals(a, b);
+    }
+  };
+
+  /**
+   * @brief Finds the first character of @p input at or after @p pos that is one of @p chars.
+   * @details Same result as `input.find_first_of(chars, pos)`, but scans 16 or 32 bytes per step
+   * with SSE2, AVX2 or NEON, selected at run time. Sets of up to eight bytes (and larger sets
+   * whose bytes share at most eight distinct high nibbles, like whitespace and punctuation)
+   * cost the same as a single byte on AVX2 and NEON.
+   * @return Index of the found character, or `std::string_view::npos`.
+   */
+  [[nodiscard]] RLL_API std::size_t
+    find_first_of(std::string_view input, std::string_view chars, std::size_t pos = 0) noexcept;
+
+  /**
+   * @brief Counts the occurrences of @p c in @p input with SSE2, AVX2 or NEON.
+   */
+  [[nodiscard]] RLL_API std::size_t count(std::string_view input, char c) noexcept;
+
+  /**
+   * @brief Returns the offsets of all newline characters (`'\n'`) in @p input, in increasing
+   * order.
+   * @details Line `i` spans `[offsets[i - 1] + 1, offsets[i])`, where the first line starts at 0
+   * and a last line without newline ends at `input.size()`. Large inputs, such as multi-gigabyte
+   * memory-mapped logs, are split into slices that are indexed by @p threads threads in
+   * parallel; no thread gets less than 1 MiB.
+   * @param input Text to index.
+   * @param threads Maximum number of threads; `0` uses one per hardware thread.
+   */
+  [[nodiscard]] RLL_API std::vector<std::size_t>
+    line_offsets(std::string_view input, std::size_t threads = 1);
+
+  /**
+   * @brief Reusable buffer for building strings from many small pieces.
+   * @details Appends, @ref join and @ref format_to write into one growing buffer: the first
+   * `fmt::inline_buffer_size` characters live inside the builder, and the buffer only allocates
+   * when it grows past its capacity. @ref clear keeps the capacity, so a builder reused for every
+   * log line or CSV row stops allocating after the longest one. Memory comes from @p Allocator,
+   * which can be an arena, e.g. `std::pmr::polymorphic_allocator<char>` over a
+   * `std::pmr::monotonic_buffer_resource`.
+   *
+   * The builder converts to `std::string_view`, so the result can be passed to
+   * `io::filedevice::write` or any other consumer without copying it into a `std::string`.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * auto row = rll::string_builder();
+   * for(auto const& r : records) {
+   *   row.clear();
+   *   row.join(r.fields, ",").format_to(",{:.3f}\n", r.value);
+   *   out.write(row);
+   * }
+   * @endcode
+   * @tparam Allocator Allocator of the characters beyond the inline capacity.
+   */
+  template <typename Allocator = std::allocator<char>>
+  class basic_string_builder {
+   public:
+    using allocator_type = Allocator;
+
+    basic_string_builder() = default;
+
+    explicit basic_string_builder(Allocator const& alloc)
+      : buffer_(alloc) {}
+
+    basic_string_builder& append(std::string_view const str) {
+      this->buffer_.append(str.data(), str.data() + str.size());  // NOLINT(*-pointer-arithmetic)
+      return *this;
+    }
+
+    basic_string_builder& append(char const c) {
+      this->buffer_.push_back(c);
+      return *this;
+    }
+
+    basic_string_builder& append(std::size_t const count, char const c) {
+      auto const size = this->buffer_.size();
+      this->buffer_.resize(size + count);
+      std::memset(this->buffer_.data() + size, c, count);  // NOLINT(*-pointer-arithmetic)
+      return *this;
+    }
+
+    basic_string_builder& operator+=(std::string_view const str) { return this->append(str); }
+
+    basic_string_builder& operator+=(char const c) { return this->append(c); }
+
+    /**
+     * @brief Appends the arguments formatted by `fmt`, without a temporary string.
+     */
+    template <typename... Args>
+    basic_string_builder& format_to(fmt::format_string<Args...> format, Args&&... args) {
+      fmt::format_to(fmt::appender(this->buffer_), format, std::forward<Args>(args)...);
+      return *this;
+    }
+
+    /**
+     * @brief Appends the elements of @p range separated by @p separator.
+     * @details If the elements convert to `std::string_view`, a first pass adds up their sizes
+     * and the buffer grows once to the exact size of the result. Other elements are formatted
+     * with `fmt` as by `"{}"`. The range is traversed twice, so it must be a forward range.
+     */
+    template <typename Range>
+    basic_string_builder& join(Range const& range, std::string_view const separator) {
+      using std::begin;
+      using std::end;
+      auto first = begin(range);
+      auto const last = end(range);
+      if(first == last)
+        return *this;
+      if constexpr(std::is_convertible_v<decltype(*first), std::string_view>) {
+        auto total = std::size_t(0);
+        auto count = std::size_t(0);
+        for(auto it = first; it != last; ++it, ++count)
+          total += std::string_view(*it).size();
+        this->reserve(this->size() + total + (count - 1) * separator.size());
+      }
+      this->append_element(*first);
+      for(++first; first != last; ++first) {
+        this->append(separator);
+        this->append_element(*first);
+      }
+      return *this;
+    }
+
+    /**
+     * @brief Makes room for at least @p capacity characters in total.
+     */
+    void reserve(std::size_t const capacity) { this->buffer_.reserve(capacity); }
+
+    /**
+     * @brief Empties the builder, keeping its capacity for the next string.
+     */
+    void clear() noexcept { this->buffer_.clear(); }
+
+    [[nodiscard]] char const* data() const noexcept { return this->buffer_.data(); }
+
+    [[nodiscard]] std::size_t size() const noexcept { return this->buffer_.size(); }
+
+    [[nodiscard]] bool empty() const noexcept { return this->buffer_.size() == 0; }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return this->buffer_.capacity(); }
+
+    [[nodiscard]] std::string_view view() const noexcept {
+      return {this->buffer_.data(), this->buffer_.size()};
+    }
+
+    [[nodiscard]] operator std::string_view() const noexcept {  // NOLINT(*-explicit-*)
+      return this->view();
+    }
+
+    [[nodiscard]] std::string str() const { return std::string(this->view()); }
+
+   private:
+    template <typename T>
+    void append_element(T const& value) {
+      if constexpr(std::is_convertible_v<T const&, std::string_view>)
+        this->append(std::string_view(value));
+      else
+        this->format_to("{}", value);
+    }
+
+    fmt::basic_memory_buffer<char, fmt::inline_buffer_size, Allocator> buffer_;
+  };
+
+  using string_builder = basic_string_builder<>;
+
+  /**
+   * @brief Returns the elements of @p range separated by @p separator.
+   * @details Strings are joined with a single allocation of the exact size of the result.
+   * @see basic_string_builder::join
+   */
+  template <typename Range>
+  [[nodiscard]] std::string join(Range const& range, std::string_view const separator) {
+    using std::begin;
+    using std::end;
+    if constexpr(std::is_convertible_v<decltype(*begin(range)), std::string_view>) {
+      auto total = std::size_t(0);
+      auto count = std::size_t(0);
+      for(auto const& element : range) {
+        total += std::string_view(element).size();
+        count++;
+      }
+      auto res = std::string();
+      if(count == 0)
+        return res;
+      res.reserve(total + (count - 1) * separator.size());
+      auto first = true;
+      for(auto const& element : range) {
+        if(not first)
+          res.append(separator);
+        res.append(std::string_view(element));
+        first = false;
+      }
+      return res;
+    } else {
+      return string_builder().join(range, separator).str();
+    }
+  }
+
   template <typename C>
   bool starts_with(std::basic_string<C> const& input, std::basic_string_view<C> sv) noexcept {
     return sv.size() <= input.size() and std::equal(sv.begin(), sv.end(), input.begin());
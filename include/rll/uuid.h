@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <array>
+#include <chrono>
 #include <iosfwd>
 #include <utility>
 #include <string>
@@ -11,6 +12,7 @@
 #include <rll/global.h>
 #include <rll/stdint.h>
 #include <rll/result.h>
+#include <rll/crypto/fast_hash.h>
 
 namespace rll  // NOLINT(*-concat-nested-namespaces)
 {
@@ -122,6 +124,33 @@ namespace rll  // NOLINT(*-concat-nested-namespaces)
      */
     [[nodiscard]] std::string to_string() const;
 
+    /**
+     * @brief Writes the string representation of the guid to @p out.
+     * @details Writes exactly @ref short_guid_string_length characters in the same form as
+     * @ref to_string. No null terminator is written and nothing is allocated.
+     * @param out Destination buffer of at least @ref short_guid_string_length characters.
+     * @return Pointer past the last written character.
+     */
+    char* to_chars(char* out) const noexcept;
+
+    /**
+     * @brief Writes the string representations of @p count guids.
+     * @details The string of `ids[i]` is written to `out + i * stride`. Characters between the
+     * strings (if @p stride is greater than @ref short_guid_string_length) are left untouched, so
+     * separators can be written before or after the call.
+     * @param ids Guids to format.
+     * @param count Number of guids.
+     * @param out Destination buffer of at least `count * stride` characters.
+     * @param stride Distance between two strings; must not be less than
+     * @ref short_guid_string_length.
+     */
+    static void to_chars_n(
+      uuid const* ids,
+      std::size_t count,
+      char* out,
+      std::size_t stride = short_guid_string_length
+    ) noexcept;
+
     /**
      * @brief Gets the bytes of the guid.
      * @return Constant reference to the array of bytes.
@@ -136,11 +165,32 @@ namespace rll  // NOLINT(*-concat-nested-namespaces)
      */
     [[nodiscard]] constexpr std::array<u8, 16>& bytes_mut() noexcept { return this->bytes_; }
 
+    /**
+     * @brief Returns the RFC 4122 / RFC 9562 version field, e.g. `4` for random uuids.
+     */
+    [[nodiscard]] constexpr u8 version() const noexcept {
+      return static_cast<u8>(this->bytes_[6] >> 4U);
+    }
+
+    /**
+     * @brief Returns the creation time embedded in a version 7 uuid.
+     * @details The timestamp has millisecond precision. The result is meaningless for other
+     * versions.
+     * @see v7
+     */
+    [[nodiscard]] std::chrono::system_clock::time_point timestamp() const noexcept;
+
     /**
      * @brief Hashes the guid to an unsigned 64-bit integer.
+     * @details All 128 bits are mixed with @ref crypto::fast_hash64, so every bit of the result
+     * depends on every byte of the guid.
      * @return Hash value.
      */
-    [[nodiscard]] u64 to_u64() const noexcept;
+    [[nodiscard]] u64 to_u64() const noexcept {
+      return crypto::fast_hash64(
+        std::string_view(reinterpret_cast<char const*>(this->bytes_.data()), this->bytes_.size())
+      );
+    }
 
     /**
      * @brief Checks whether the guid is valid or not.
@@ -156,8 +206,11 @@ namespace rll  // NOLINT(*-concat-nested-namespaces)
      * @param other Other guid.
      * @return `true` if the guids are equal, `false` otherwise.
      */
-    [[nodiscard]] bool operator==(uuid const& other) const noexcept {
-      return this->bytes() == other.bytes();
+    [[nodiscard]] constexpr bool operator==(uuid const& other) const noexcept {
+      for(auto i = std::size_t(0); i < this->bytes_.size(); i++)
+        if(this->bytes_[i] != other.bytes_[i])
+          return false;
+      return true;
     }
 
     /**
@@ -165,7 +218,9 @@ namespace rll  // NOLINT(*-concat-nested-namespaces)
      * @param other Other guid.
      * @return `true` if the guids are __not__ equal, `false` otherwise.
      */
-    [[nodiscard]] bool operator!=(uuid const& other) const noexcept { return not (*this == other); }
+    [[nodiscard]] constexpr bool operator!=(uuid const& other) const noexcept {
+      return not (*this == other);
+    }
 
     /**
      * @brief Array-like less comparator for guid.
@@ -193,11 +248,25 @@ namespace rll  // NOLINT(*-concat-nested-namespaces)
     [[nodiscard]] constexpr static uuid empty() noexcept { return {}; }
 
     /**
-     * @brief Creates a random uuid
+     * @brief Creates a random (version 4) uuid.
+     * @details Uses the per-thread @ref uuid_generator; no system call after the first use in a
+     * thread.
      * @return New random uuid.
      */
     [[nodiscard]] static uuid random() noexcept;
 
+    /**
+     * @brief Creates a time-ordered (version 7, RFC 9562) uuid.
+     * @details The first 48 bits are the Unix time in milliseconds, followed by a 42-bit counter
+     * and 32 random bits. The counter starts at a random value every millisecond and is
+     * incremented for each further uuid of the calling thread, so uuids created by one thread
+     * compare (`operator<`) in creation order, even if the system clock steps back. Uuids of
+     * different threads within the same millisecond are unordered.
+     * @return New time-ordered uuid.
+     * @see timestamp
+     */
+    [[nodiscard]] static uuid v7() noexcept;
+
     /**
      * @brief Tries to parse a guid from a string representation.
      * @param str String representation of the guid.
@@ -205,6 +274,36 @@ namespace rll  // NOLINT(*-concat-nested-namespaces)
      */
     [[nodiscard]] static result<uuid> try_parse(std::string_view str) noexcept;
 
+    /**
+     * @brief Parses a guid without allocating or throwing.
+     * @details Accepts `xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx` and
+     * `{xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx}`. Hex digits may be upper- or lowercase. Unlike
+     * the string constructor, hyphens and braces are validated.
+     * @param str String representation of the guid.
+     * @param out Receives the parsed guid. Left unchanged on failure.
+     * @return `true` if @p str is a valid guid, `false` otherwise.
+     */
+    [[nodiscard]] static bool from_chars(std::string_view str, uuid& out) noexcept;
+
+    /**
+     * @brief Parses @p count guids of @ref short_guid_string_length characters each.
+     * @details The string of `out[i]` is read from `in + i * stride`. Parsing stops at the first
+     * invalid string.
+     * @param in Source buffer of at least `count * stride` characters.
+     * @param count Number of guids.
+     * @param out Destination array of at least @p count guids.
+     * @param stride Distance between two strings; must not be less than
+     * @ref short_guid_string_length.
+     * @return Number of guids parsed, which is the index of the first invalid string or
+     * @p count.
+     */
+    [[nodiscard]] static std::size_t from_chars_n(
+      char const* in,
+      std::size_t count,
+      uuid* out,
+      std::size_t stride = short_guid_string_length
+    ) noexcept;
+
    private:
     std::array<u8, 16> bytes_;
   };
@@ -266,7 +365,7 @@ namespace std {
   template <>
   struct [[maybe_unused]] hash<rll::uuid> {
     [[nodiscard]] std::size_t operator()(rll::uuid const& b) const noexcept {
-      return rll::detail::hash<rll::u64, rll::u64> {}(b.bytes()[0], b.bytes()[1]);
+      return static_cast<std::size_t>(b.to_u64());
     }
   };
 }  // namespace std
@@ -276,4 +375,11 @@ namespace std {
  * @relates rll::uuid
  */
 template <>
-struct [[maybe_unused]] fmt::formatter<rll::uuid> : ostream_formatter {};
+struct [[maybe_unused]] fmt::formatter<rll::uuid> : formatter<std::string_view> {
+  template <typename FormatContext>
+  auto format(rll::uuid const& id, FormatContext& ctx) const -> decltype(ctx.out()) {
+    char buf[rll::uuid::short_guid_string_length];  // NOLINT(*-avoid-c-arrays)
+    id.to_chars(buf);
+    return formatter<std::string_view>::format(std::string_view(buf, sizeof(buf)), ctx);
+  }
+};
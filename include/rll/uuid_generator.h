@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <rll/global.h>
+#include <rll/stdint.h>
+#include <rll/uuid.h>
+
+namespace rll {
+  /**
+   * @brief Fast generator of random (version 4) uuids.
+   * @details Draws uuids from a ChaCha20 keystream with a 256-bit key taken once from the operating
+   * system CSPRNG, so producing an id is a few dozen cycles and never a system call. Keystream is
+   * produced four blocks (sixteen uuids) at a time. Version and variant bits are set as required
+   * by RFC 4122, leaving 122 random bits.
+   *
+   * An instance must not be shared between threads without synchronization; use @ref local for a
+   * per-thread instance, which is what @ref uuid::random uses. Generators seeded from the
+   * operating system pick a fresh key in the child after `fork()`, so parent and child never
+   * return the same ids.
+   *
+   * @ref v7 draws time-ordered uuids from the same keystream.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * auto& gen = rll::uuid_generator::local();
+   * auto const id = gen();
+   * auto ids = std::vector<rll::uuid>(1024);
+   * gen.generate_n(ids.data(), ids.size());
+   * @endcode
+   */
+  class RLL_API uuid_generator {
+   public:
+    /**
+     * @brief Creates a generator keyed from the operating system CSPRNG.
+     */
+    uuid_generator() noexcept;
+
+    /**
+     * @brief Creates a deterministic generator from @p seed.
+     * @details Yields the same sequence for the same seed, which makes it suitable for tests and
+     * reproducible simulations. The key is not replaced after `fork()`.
+     * @param seed ChaCha20 key.
+     */
+    explicit uuid_generator(std::array<u8, 32> const& seed) noexcept;
+
+    /**
+     * @brief Returns the next random uuid.
+     */
+    [[nodiscard]] uuid operator()() noexcept;
+
+    /**
+     * @brief Returns the next time-ordered (version 7) uuid.
+     * @details Monotonic for this generator. See @ref uuid::v7 for the layout.
+     */
+    [[nodiscard]] uuid v7() noexcept;
+
+    /**
+     * @brief Writes @p count random uuids to @p out.
+     * @details Whole batches of sixteen uuids are written straight to @p out without going
+     * through the internal buffer.
+     */
+    void generate_n(uuid* out, std::size_t count) noexcept;
+
+    /**
+     * @brief Returns @p count random uuids.
+     */
+    [[nodiscard]] std::vector<uuid> generate_n(std::size_t count);
+
+    /**
+     * @brief Returns the generator of the calling thread.
+     * @details Created and seeded on first use in each thread.
+     */
+    [[nodiscard]] static uuid_generator& local() noexcept;
+
+   private:
+    static constexpr std::size_t buffered = 16;
+
+    void reseed() noexcept;
+    void refill() noexcept;
+    [[nodiscard]] bool forked() const noexcept;
+
+    std::array<u32, 8> key_ = {};
+    u64 counter_ = 0;
+    u64 fork_generation_ = 0;
+    bool system_seeded_ = false;
+    std::size_t next_ = buffered;
+    std::array<u8, 16 * buffered> buffer_ = {};
+    u64 last_ms_ = 0;
+    u64 sequence_ = 0;
+  };
+}  // namespace rll
@@ -0,0 +1,564 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <rll/bit.h>
+#include <rll/global.h>
+#include <rll/stdint.h>
+#include <rll/uuid.h>
+
+#if defined(RLL_ARCH_X86_64) || defined(__SSE2__)
+#  include <emmintrin.h>
+#  define RLL_UUID_MAP_SSE2
+#endif
+
+namespace rll {
+#ifndef DOXYGEN
+  namespace detail {
+    /**
+     * Sixteen control bytes of a uuid_table. A full slot stores the low 7 bits of its hash, so
+     * one compare finds all candidates of a group.
+     */
+    class uuid_group {
+     public:
+      static constexpr std::size_t width = 16;
+      static constexpr u8 empty = 0x80;
+      static constexpr u8 deleted = 0xFE;
+
+      explicit uuid_group(u8 const* ctrl) noexcept
+#if defined(RLL_UUID_MAP_SSE2)
+        : ctrl_(_mm_loadu_si128(reinterpret_cast<__m128i const*>(ctrl)))
+#else
+        : ctrl_(ctrl)
+#endif
+      {
+      }
+
+      /// Slots whose control byte is `h2`.
+      [[nodiscard]] u32 match(u8 const h2) const noexcept {
+#if defined(RLL_UUID_MAP_SSE2)
+        return static_cast<u32>(
+          _mm_movemask_epi8(_mm_cmpeq_epi8(this->ctrl_, _mm_set1_epi8(static_cast<char>(h2))))
+        );
+#else
+        auto res = u32();
+        for(auto i = std::size_t(0); i < width; i++)
+          res |= static_cast<u32>(this->ctrl_[i] == h2) << i;  // NOLINT(*-pointer-arithmetic)
+        return res;
+#endif
+      }
+
+      /// Slots that were never used.
+      [[nodiscard]] u32 match_empty() const noexcept { return this->match(empty); }
+
+      /// Slots that are empty or deleted, i.e. whose top bit is set.
+      [[nodiscard]] u32 match_free() const noexcept {
+#if defined(RLL_UUID_MAP_SSE2)
+        return static_cast<u32>(_mm_movemask_epi8(this->ctrl_));
+#else
+        auto res = u32();
+        for(auto i = std::size_t(0); i < width; i++)
+          res |= static_cast<u32>(this->ctrl_[i] >> 7U) << i;  // NOLINT(*-pointer-arithmetic)
+        return res;
+#endif
+      }
+
+      [[nodiscard]] static std::size_t lowest(u32 const mask) noexcept {
+        return static_cast<std::size_t>(countr_zero(mask));
+      }
+
+     private:
+#if defined(RLL_UUID_MAP_SSE2)
+      __m128i ctrl_;
+#else
+      u8 const* ctrl_;
+#endif
+    };
+
+    /**
+     * Open-addressing table of `Slot`s keyed by uuid, shared by uuid_map and uuid_set.
+     *
+     * Slots are probed a group of sixteen at a time: the group at `hash >> 7` is checked for
+     * control bytes equal to `hash & 0x7F`, and probing moves on (triangular steps over groups)
+     * only while the group has no empty slot. The table is kept at most 7/8 full.
+     */
+    template <typename Slot>
+    class uuid_table {
+      template <bool Const>
+      class basic_iterator {
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = Slot;
+        using difference_type = std::ptrdiff_t;
+        using reference = std::conditional_t<Const, Slot const&, Slot&>;
+        using pointer = std::conditional_t<Const, Slot const*, Slot*>;
+
+        basic_iterator() = default;
+
+        template <bool C = Const, typename = std::enable_if_t<C>>
+        basic_iterator(basic_iterator<false> const& other) noexcept  // NOLINT(*-explicit-*)
+          : ctrl_(other.ctrl_)
+          , slot_(other.slot_)
+          , end_(other.end_) {}
+
+        [[nodiscard]] reference operator*() const noexcept { return *this->slot_; }
+
+        [[nodiscard]] pointer operator->() const noexcept { return this->slot_; }
+
+        basic_iterator& operator++() noexcept {
+          ++this->ctrl_;
+          ++this->slot_;
+          this->skip_free();
+          return *this;
+        }
+
+        basic_iterator operator++(int) noexcept {
+          auto res = *this;
+          ++*this;
+          return res;
+        }
+
+        [[nodiscard]] friend bool operator==(basic_iterator const& a, basic_iterator const& b)
+          noexcept {
+          return a.ctrl_ == b.ctrl_;
+        }
+
+        [[nodiscard]] friend bool operator!=(basic_iterator const& a, basic_iterator const& b)
+          noexcept {
+          return a.ctrl_ != b.ctrl_;
+        }
+
+       private:
+        friend class uuid_table;
+        friend class basic_iterator<not Const>;
+
+        basic_iterator(u8 const* ctrl, pointer slot, u8 const* end) noexcept
+          : ctrl_(ctrl)
+          , slot_(slot)
+          , end_(end) {}
+
+        void skip_free() noexcept {
+          // NOLINTNEXTLINE(*-pointer-arithmetic)
+          for(; this->ctrl_ != this->end_ and (*this->ctrl_ & 0x80U) != 0; ++this->ctrl_)
+            ++this->slot_;
+        }
+
+        u8 const* ctrl_ = nullptr;
+        pointer slot_ = nullptr;
+        u8 const* end_ = nullptr;
+      };
+
+     public:
+      using key_type = uuid;
+      using value_type = Slot;
+      using size_type = std::size_t;
+      using difference_type = std::ptrdiff_t;
+      using reference = Slot&;
+      using const_reference = Slot const&;
+      using iterator = basic_iterator<std::is_same_v<Slot, uuid>>;
+      using const_iterator = basic_iterator<true>;
+
+      uuid_table() = default;
+
+      uuid_table(uuid_table const& other)
+        : uuid_table() {
+        if(other.size_ == 0)
+          return;
+        this->allocate(other.capacity_);
+        // erased slots are copied too: they keep the probe sequences of later keys intact
+        for(auto i = std::size_t(0); i < other.capacity_; i++) {
+          if(other.full(i)) {
+            ::new(static_cast<void*>(this->slots_ + i)) Slot(other.slots_[i]);  // NOLINT
+            this->size_++;
+          }
+          this->ctrl_[i] = other.ctrl_[i];  // NOLINT(*-pointer-arithmetic)
+        }
+        this->growth_left_ = other.growth_left_;
+      }
+
+      uuid_table(uuid_table&& other) noexcept
+        : ctrl_(std::exchange(other.ctrl_, nullptr))
+        , slots_(std::exchange(other.slots_, nullptr))
+        , capacity_(std::exchange(other.capacity_, 0))
+        , size_(std::exchange(other.size_, 0))
+        , growth_left_(std::exchange(other.growth_left_, 0)) {}
+
+      uuid_table& operator=(uuid_table const& other) {
+        if(this != &other)
+          uuid_table(other).swap(*this);
+        return *this;
+      }
+
+      uuid_table& operator=(uuid_table&& other) noexcept {
+        uuid_table(std::move(other)).swap(*this);
+        return *this;
+      }
+
+      ~uuid_table() { this->release(); }
+
+      [[nodiscard]] iterator begin() noexcept { return this->iterator_at<iterator>(0, true); }
+
+      [[nodiscard]] iterator end() noexcept {
+        return this->iterator_at<iterator>(this->capacity_, false);
+      }
+
+      [[nodiscard]] const_iterator begin() const noexcept {
+        return this->iterator_at<const_iterator>(0, true);
+      }
+
+      [[nodiscard]] const_iterator end() const noexcept {
+        return this->iterator_at<const_iterator>(this->capacity_, false);
+      }
+
+      [[nodiscard]] const_iterator cbegin() const noexcept { return this->begin(); }
+
+      [[nodiscard]] const_iterator cend() const noexcept { return this->end(); }
+
+      [[nodiscard]] bool empty() const noexcept { return this->size_ == 0; }
+
+      [[nodiscard]] size_type size() const noexcept { return this->size_; }
+
+      /**
+       * Number of slots. The table grows once `size()` plus the number of erased slots not yet
+       * reused reaches 7/8 of it.
+       */
+      [[nodiscard]] size_type capacity() const noexcept { return this->capacity_; }
+
+      /// Destroys all elements and keeps the allocated slots.
+      void clear() noexcept {
+        for(auto i = std::size_t(0); i < this->capacity_; i++) {
+          if(this->full(i))
+            this->slots_[i].~Slot();  // NOLINT(*-pointer-arithmetic)
+        }
+        std::fill_n(this->ctrl_, this->capacity_, uuid_group::empty);
+        this->size_ = 0;
+        this->growth_left_ = max_load(this->capacity_);
+      }
+
+      /// Allocates enough slots for @p count elements without further rehashing.
+      void reserve(size_type const count) {
+        auto capacity = std::max(this->capacity_, uuid_group::width);
+        while(max_load(capacity) < count)
+          capacity *= 2;
+        if(capacity != this->capacity_)
+          this->rehash(capacity);
+      }
+
+      [[nodiscard]] iterator find(uuid const& key) noexcept {
+        auto const i = this->find_index(key, key.to_u64());
+        return i == npos ? this->end() : this->iterator_at<iterator>(i, false);
+      }
+
+      [[nodiscard]] const_iterator find(uuid const& key) const noexcept {
+        auto const i = this->find_index(key, key.to_u64());
+        return i == npos ? this->end() : this->iterator_at<const_iterator>(i, false);
+      }
+
+      [[nodiscard]] bool contains(uuid const& key) const noexcept {
+        return this->find_index(key, key.to_u64()) != npos;
+      }
+
+      [[nodiscard]] size_type count(uuid const& key) const noexcept {
+        return this->contains(key) ? 1 : 0;
+      }
+
+      size_type erase(uuid const& key) noexcept {
+        auto const i = this->find_index(key, key.to_u64());
+        if(i == npos)
+          return 0;
+        this->erase_at(i);
+        return 1;
+      }
+
+      iterator erase(const_iterator pos) noexcept {
+        auto const i = static_cast<std::size_t>(pos.ctrl_ - this->ctrl_);
+        this->erase_at(i);
+        return this->iterator_at<iterator>(i + 1, true);
+      }
+
+      void swap(uuid_table& other) noexcept {
+        std::swap(this->ctrl_, other.ctrl_);
+        std::swap(this->slots_, other.slots_);
+        std::swap(this->capacity_, other.capacity_);
+        std::swap(this->size_, other.size_);
+        std::swap(this->growth_left_, other.growth_left_);
+      }
+
+     protected:
+      static constexpr auto npos = static_cast<std::size_t>(-1);
+
+      [[nodiscard]] static uuid const& key_of(Slot const& slot) noexcept {
+        if constexpr(std::is_same_v<Slot, uuid>)
+          return slot;
+        else
+          return slot.first;
+      }
+
+      /**
+       * Finds @p key or constructs a slot for it from @p args. Returns the slot index and whether
+       * a new slot was constructed.
+       */
+      template <typename... Args>
+      std::pair<iterator, bool> emplace_key(uuid const& key, Args&&... args) {
+        auto const hash = key.to_u64();
+        auto const found = this->find_index(key, hash);
+        if(found != npos)
+          return {this->iterator_at<iterator>(found, false), false};
+        if(this->growth_left_ == 0)
+          this->grow();
+        auto const i = this->find_free(hash);
+        ::new(static_cast<void*>(this->slots_ + i)) Slot(std::forward<Args>(args)...);  // NOLINT
+        if(this->ctrl_[i] == uuid_group::empty)  // NOLINT(*-pointer-arithmetic)
+          this->growth_left_--;
+        this->ctrl_[i] = static_cast<u8>(hash & 0x7FU);  // NOLINT(*-pointer-arithmetic)
+        this->size_++;
+        return {this->iterator_at<iterator>(i, false), true};
+      }
+
+      [[nodiscard]] std::size_t find_index(uuid const& key, u64 const hash) const noexcept {
+        if(this->capacity_ == 0)
+          return npos;
+        auto const h2 = static_cast<u8>(hash & 0x7FU);
+        auto const mask = this->capacity_ / uuid_group::width - 1;
+        auto group = static_cast<std::size_t>(hash >> 7U) & mask;
+        for(auto step = std::size_t(1);; step++) {
+          auto const base = group * uuid_group::width;
+          auto const g = uuid_group(this->ctrl_ + base);  // NOLINT(*-pointer-arithmetic)
+          for(auto m = g.match(h2); m != 0; m &= m - 1) {
+            auto const i = base + uuid_group::lowest(m);
+            if(key_of(this->slots_[i]) == key)  // NOLINT(*-pointer-arithmetic)
+              return i;
+          }
+          if(g.match_empty() != 0)
+            return npos;
+          group = (group + step) & mask;
+        }
+      }
+
+     private:
+      [[nodiscard]] static constexpr std::size_t max_load(std::size_t const capacity) noexcept {
+        return capacity - capacity / 8;
+      }
+
+      [[nodiscard]] bool full(std::size_t const i) const noexcept {
+        return (this->ctrl_[i] & 0x80U) == 0;  // NOLINT(*-pointer-arithmetic)
+      }
+
+      template <typename It>
+      [[nodiscard]] It iterator_at(std::size_t const i, bool const skip) const noexcept {
+        if(this->capacity_ == 0)
+          return It();
+        // NOLINTNEXTLINE(*-pointer-arithmetic)
+        auto it = It(this->ctrl_ + i, this->slots_ + i, this->ctrl_ + this->capacity_);
+        if(skip)
+          it.skip_free();
+        return it;
+      }
+
+      [[nodiscard]] std::size_t find_free(u64 const hash) const noexcept {
+        auto const mask = this->capacity_ / uuid_group::width - 1;
+        auto group = static_cast<std::size_t>(hash >> 7U) & mask;
+        for(auto step = std::size_t(1);; step++) {
+          auto const base = group * uuid_group::width;
+          // NOLINTNEXTLINE(*-pointer-arithmetic)
+          if(auto const m = uuid_group(this->ctrl_ + base).match_free(); m != 0)
+            return base + uuid_group::lowest(m);
+          group = (group + step) & mask;
+        }
+      }
+
+      void erase_at(std::size_t const i) noexcept {
+        this->slots_[i].~Slot();  // NOLINT(*-pointer-arithmetic)
+        this->size_--;
+        // a group that already had an empty slot never let a probe pass, so the slot can
+        // become empty again; otherwise later keys may have probed past it
+        auto const base = i / uuid_group::width * uuid_group::width;
+        // NOLINTBEGIN(*-pointer-arithmetic)
+        if(uuid_group(this->ctrl_ + base).match_empty() != 0) {
+          this->ctrl_[i] = uuid_group::empty;
+          this->growth_left_++;
+        } else
+          this->ctrl_[i] = uuid_group::deleted;
+        // NOLINTEND(*-pointer-arithmetic)
+      }
+
+      void grow() {
+        if(this->capacity_ == 0)
+          this->rehash(uuid_group::width);
+        else if(this->size_ <= max_load(this->capacity_) / 2)
+          this->rehash(this->capacity_);  // mostly erased slots: clean up in place
+        else
+          this->rehash(this->capacity_ * 2);
+      }
+
+      void allocate(std::size_t const capacity) {
+        auto* const ctrl = std::allocator<u8>().allocate(capacity);
+        try {
+          this->slots_ = std::allocator<Slot>().allocate(capacity);
+        } catch(...) {
+          std::allocator<u8>().deallocate(ctrl, capacity);
+          throw;
+        }
+        std::fill_n(ctrl, capacity, uuid_group::empty);
+        this->ctrl_ = ctrl;
+        this->capacity_ = capacity;
+        this->size_ = 0;
+        this->growth_left_ = max_load(capacity);
+      }
+
+      void rehash(std::size_t const capacity) {
+        // allocated before anything moves, so that a failed allocation leaves the table intact
+        auto fresh = uuid_table();
+        fresh.allocate(capacity);
+        for(auto i = std::size_t(0); i < this->capacity_; i++) {
+          if(not this->full(i))
+            continue;
+          auto& slot = this->slots_[i];  // NOLINT(*-pointer-arithmetic)
+          auto const hash = key_of(slot).to_u64();
+          auto const j = fresh.find_free(hash);
+          ::new(static_cast<void*>(fresh.slots_ + j)) Slot(std::move(slot));  // NOLINT
+          fresh.ctrl_[j] = static_cast<u8>(hash & 0x7FU);                     // NOLINT
+          fresh.size_++;
+          fresh.growth_left_--;
+        }
+        this->swap(fresh);
+      }
+
+      void release() noexcept {
+        if(this->capacity_ == 0)
+          return;
+        this->clear();
+        std::allocator<Slot>().deallocate(this->slots_, this->capacity_);
+        std::allocator<u8>().deallocate(this->ctrl_, this->capacity_);
+        this->ctrl_ = nullptr;
+        this->slots_ = nullptr;
+        this->capacity_ = 0;
+        this->growth_left_ = 0;
+      }
+
+      u8* ctrl_ = nullptr;
+      Slot* slots_ = nullptr;
+      std::size_t capacity_ = 0;
+      std::size_t size_ = 0;
+      std::size_t growth_left_ = 0;
+    };
+  }  // namespace detail
+#endif
+
+  /**
+   * @brief Hash map with @ref uuid keys.
+   * @details Open-addressing (SwissTable-style) table that stores keys and values inline, so a
+   * lookup is usually one 16-byte group compare (SSE2 where available) plus one key compare,
+   * without the node allocations and pointer chasing of `std::unordered_map`. Keys are hashed
+   * with @ref uuid::to_u64.
+   *
+   * The interface follows `std::unordered_map`, except that inserting or erasing invalidates
+   * all iterators and references, and there is no bucket interface.
+   *
+   * Example usage:
+   * @code {.cpp}
+   * auto tracks = rll::uuid_map<track>();
+   * tracks[id] = track { ... };
+   * if(auto const it = tracks.find(id); it != tracks.end())
+   *   use(it->second);
+   * @endcode
+   * @tparam V Mapped type.
+   * @see uuid_set
+   */
+  template <typename V>
+  class uuid_map : public detail::uuid_table<std::pair<uuid const, V>> {
+    using base = detail::uuid_table<std::pair<uuid const, V>>;
+
+   public:
+    using mapped_type = V;
+    using typename base::const_iterator;
+    using typename base::iterator;
+    using typename base::value_type;
+
+    uuid_map() = default;
+
+    uuid_map(std::initializer_list<value_type> const init) {
+      this->reserve(init.size());
+      for(auto const& v : init)
+        this->insert(v);
+    }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(uuid const& key, Args&&... args) {
+      return this->emplace_key(
+        key,
+        std::piecewise_construct,
+        std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...)
+      );
+    }
+
+    std::pair<iterator, bool> insert(value_type const& value) {
+      return this->try_emplace(value.first, value.second);
+    }
+
+    std::pair<iterator, bool> insert(value_type&& value) {
+      return this->try_emplace(value.first, std::move(value.second));
+    }
+
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(uuid const& key, M&& value) {
+      auto res = this->try_emplace(key, std::forward<M>(value));
+      if(not res.second)
+        res.first->second = std::forward<M>(value);
+      return res;
+    }
+
+    [[nodiscard]] V& operator[](uuid const& key) { return this->try_emplace(key).first->second; }
+
+    /**
+     * @brief Returns the value mapped to @p key.
+     * @throw std::out_of_range If there is no such key.
+     */
+    [[nodiscard]] V& at(uuid const& key) {
+      auto const it = this->find(key);
+      if(it == this->end())
+        throw std::out_of_range("rll::uuid_map::at: key not found");
+      return it->second;
+    }
+
+    /**
+     * @brief Returns the value mapped to @p key.
+     * @throw std::out_of_range If there is no such key.
+     */
+    [[nodiscard]] V const& at(uuid const& key) const {
+      auto const it = this->find(key);
+      if(it == this->end())
+        throw std::out_of_range("rll::uuid_map::at: key not found");
+      return it->second;
+    }
+  };
+
+  /**
+   * @brief Hash set of @ref uuid values.
+   * @details Same table as @ref uuid_map without mapped values.
+   * @see uuid_map
+   */
+  class uuid_set : public detail::uuid_table<uuid> {
+    using base = detail::uuid_table<uuid>;
+
+   public:
+    uuid_set() = default;
+
+    uuid_set(std::initializer_list<uuid> const init) {
+      this->reserve(init.size());
+      for(auto const& v : init)
+        this->insert(v);
+    }
+
+    std::pair<iterator, bool> insert(uuid const& value) { return this->emplace_key(value, value); }
+  };
+}  // namespace rll
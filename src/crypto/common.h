@@ -0,0 +1,74 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <string>
+#include <rll/stdint.h>
+#include <rll/crypto/static_hasher.h>
+
+namespace rll::crypto::detail {
+  [[nodiscard]] inline u32 load_be32(u8 const* p) noexcept {
+    return (static_cast<u32>(p[0]) << 24) | (static_cast<u32>(p[1]) << 16)
+         | (static_cast<u32>(p[2]) << 8) | static_cast<u32>(p[3]);
+  }
+
+  inline void store_be32(u8* p, u32 const x) noexcept {
+    p[0] = static_cast<u8>(x >> 24);
+    p[1] = static_cast<u8>(x >> 16);
+    p[2] = static_cast<u8>(x >> 8);
+    p[3] = static_cast<u8>(x);
+  }
+
+  inline void store_be64(u8* p, u64 const x) noexcept {
+    store_be32(p, static_cast<u32>(x >> 32));
+    store_be32(p + 4, static_cast<u32>(x));
+  }
+
+  [[nodiscard]] inline u32 rotl(u32 const x, u32 const c) noexcept {
+    return (x << c) | (x >> (32 - c));
+  }
+
+  [[nodiscard]] inline u32 rotr(u32 const x, u32 const c) noexcept {
+    return (x >> c) | (x << (32 - c));
+  }
+
+  [[nodiscard]] inline std::string to_hex(u8 const* data, std::size_t const size) {
+    auto res = std::string();
+    res.reserve(2 * size);
+    for(auto i = std::size_t(0); i < size; i++) {
+      res.push_back("0123456789abcdef"[(data[i] >> 4) & 0xF]);
+      res.push_back("0123456789abcdef"[data[i] & 0xF]);
+    }
+    return res;
+  }
+
+  enum class length_order {
+    little_endian,
+    big_endian
+  };
+
+  /**
+   * Appends the padding byte, zeros and the 64-bit message length in bits to the buffered tail and
+   * compresses the result into `state`.
+   */
+  template <std::size_t BlockSize, typename State, typename Compress>
+  void finish(
+    State& state,
+    block_buffer<BlockSize> const& buffer,
+    length_order const order,
+    Compress compress
+  ) {
+    auto tail = std::array<u8, 2 * BlockSize>();
+    std::copy_n(buffer.data.data(), buffer.size, tail.data());
+    tail[buffer.size] = 0x80;
+    auto const blocks = buffer.size < BlockSize - sizeof(u64) ? 1 : 2;
+    auto* length = tail.data() + blocks * BlockSize - sizeof(u64);
+    auto const bits = buffer.num_bytes * 8;
+    if(order == length_order::big_endian)
+      store_be64(length, bits);
+    else
+      for(auto i = std::size_t(0); i < sizeof(u64); i++)
+        length[i] = static_cast<u8>(bits >> (8 * i));
+    compress(state, tail.data(), blocks);
+  }
+}  // namespace rll::crypto::detail
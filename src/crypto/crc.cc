@@ -0,0 +1,246 @@
+#include <rll/crypto/crc.h>
+
+#include <array>
+#include <cstring>
+#include <rll/bit.h>
+
+#include "crypto/common.h"
+#include "oslayer/cpu.h"
+
+#if defined(RLL_ARCH_X86_64)
+#  include <immintrin.h>
+#  define RLL_CRC32C_X86
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && defined(__ARM_FEATURE_CRC32)
+#  include <arm_acle.h>
+#  define RLL_CRC32C_ARM
+#endif
+
+namespace {
+  using namespace rll;
+
+  constexpr auto crc32c_poly = u32(0x82F63B78);
+  constexpr auto crc64_poly = u64(0xC96C5795D7870F42);
+
+  /**
+   * Multiplies two polynomials modulo the (reflected) generator. `a` must not be zero.
+   * In the reflected representation the top bit is x^0.
+   */
+  template <typename T, T Poly>
+  constexpr T multmodp(T a, T b) noexcept {
+    auto m = static_cast<T>(T(1) << (8 * sizeof(T) - 1));
+    auto p = T();
+    for(;;) {
+      if(a & m) {
+        p ^= b;
+        if((a & (m - 1)) == 0)
+          break;
+      }
+      m >>= 1;
+      b = (b & 1) ? static_cast<T>((b >> 1) ^ Poly) : static_cast<T>(b >> 1);
+    }
+    return p;
+  }
+
+  /// x^(2^k) modulo the generator for k = 0..66, enough for any 64-bit byte count.
+  template <typename T, T Poly>
+  constexpr std::array<T, 67> make_x2n_table() noexcept {
+    auto table = std::array<T, 67>();
+    table[0] = static_cast<T>(T(1) << (8 * sizeof(T) - 2));
+    for(auto k = std::size_t(1); k < table.size(); k++)
+      table[k] = multmodp<T, Poly>(table[k - 1], table[k - 1]);
+    return table;
+  }
+
+  template <typename T, T Poly>
+  constexpr std::array<std::array<T, 256>, 8> make_slicing_table() noexcept {
+    auto table = std::array<std::array<T, 256>, 8>();
+    for(auto i = std::size_t(0); i < 256; i++) {
+      auto c = static_cast<T>(i);
+      for(auto j = 0; j < 8; j++)
+        c = (c & 1) ? static_cast<T>((c >> 1) ^ Poly) : static_cast<T>(c >> 1);
+      table[0][i] = c;
+    }
+    for(auto k = std::size_t(1); k < 8; k++)
+      for(auto i = std::size_t(0); i < 256; i++)
+        table[k][i] = static_cast<T>((table[k - 1][i] >> 8) ^ table[0][table[k - 1][i] & 0xFF]);
+    return table;
+  }
+
+  constexpr auto crc32c_x2n = make_x2n_table<u32, crc32c_poly>();
+  constexpr auto crc64_x2n = make_x2n_table<u64, crc64_poly>();
+  constexpr auto crc32c_table = make_slicing_table<u32, crc32c_poly>();
+  constexpr auto crc64_table = make_slicing_table<u64, crc64_poly>();
+
+  /// x^(8 * n) modulo the generator: multiplying by it appends n zero bytes.
+  template <typename T, T Poly>
+  constexpr T x8nmodp(std::array<T, 67> const& x2n, u64 n) noexcept {
+    auto p = static_cast<T>(T(1) << (8 * sizeof(T) - 1));
+    for(auto k = std::size_t(3); n != 0; n >>= 1, k++)
+      if(n & 1)
+        p = multmodp<T, Poly>(x2n[k], p);
+    return p;
+  }
+
+  [[nodiscard]] u64 load_le64(u8 const* p) noexcept {
+    auto v = u64();
+    std::memcpy(&v, p, sizeof(v));
+#if RLL_ENDIAN == RLL_BIG_ENDIAN
+    v = ___rolly_byteswap64(v);
+#endif
+    return v;
+  }
+
+  /// Slicing-by-8 over the raw (non-inverted) register.
+  template <typename T, std::array<std::array<T, 256>, 8> const& Table>
+  T extend_portable(T c, u8 const* p, std::size_t n) noexcept {
+    // NOLINTBEGIN(*-pointer-arithmetic)
+    for(; n >= 8; n -= 8, p += 8) {
+      auto const w = load_le64(p) ^ c;
+      c = static_cast<T>(
+        Table[7][w & 0xFF] ^ Table[6][(w >> 8) & 0xFF] ^ Table[5][(w >> 16) & 0xFF]
+        ^ Table[4][(w >> 24) & 0xFF] ^ Table[3][(w >> 32) & 0xFF] ^ Table[2][(w >> 40) & 0xFF]
+        ^ Table[1][(w >> 48) & 0xFF] ^ Table[0][w >> 56]
+      );
+    }
+    for(; n > 0; --n, ++p)
+      c = static_cast<T>((c >> 8) ^ Table[0][(c ^ *p) & 0xFF]);
+    // NOLINTEND(*-pointer-arithmetic)
+    return c;
+  }
+
+  using crc32c_fn = u32 (*)(u32, u8 const*, std::size_t);
+  using multiply_fn = u32 (*)(u32, u32);
+
+  u32 crc32c_portable(u32 const c, u8 const* p, std::size_t const n) noexcept {
+    return extend_portable<u32, crc32c_table>(c, p, n);
+  }
+
+  u32 multiply_portable(u32 const a, u32 const b) noexcept {
+    return multmodp<u32, crc32c_poly>(a, b);
+  }
+
+  // three independent streams hide the 3-cycle latency of the crc instruction; the stream results
+  // are shifted into place by multiplying with x^(8 * stream length)
+  constexpr auto stream_long = std::size_t(8192);
+  constexpr auto stream_short = std::size_t(256);
+  constexpr auto shift_long_1 = x8nmodp<u32, crc32c_poly>(crc32c_x2n, stream_long);
+  constexpr auto shift_long_2 = x8nmodp<u32, crc32c_poly>(crc32c_x2n, 2 * stream_long);
+  constexpr auto shift_short_1 = x8nmodp<u32, crc32c_poly>(crc32c_x2n, stream_short);
+  constexpr auto shift_short_2 = x8nmodp<u32, crc32c_poly>(crc32c_x2n, 2 * stream_short);
+
+  // NOLINTBEGIN(*-macro-usage, *-pro-bounds-pointer-arithmetic)
+#define RLL_CRC32C_INTERLEAVED(word, byte, multiply)                                          \
+  while(n > 0 and (reinterpret_cast<std::uintptr_t>(p) & 7) != 0) {                          \
+    c = byte(c, *p++);                                                                        \
+    --n;                                                                                      \
+  }                                                                                           \
+  for(auto const [len, k1, k2] : {                                                            \
+        std::array<std::size_t, 3> {stream_long, shift_long_1, shift_long_2},                 \
+        std::array<std::size_t, 3> {stream_short, shift_short_1, shift_short_2}               \
+      }) {                                                                                    \
+    for(; n >= 3 * len; n -= 3 * len, p += 3 * len) {                                         \
+      auto c0 = static_cast<u64>(c);                                                          \
+      auto c1 = u64();                                                                        \
+      auto c2 = u64();                                                                        \
+      for(auto i = std::size_t(0); i < len; i += 8) {                                         \
+        c0 = word(c0, load_le64(p + i));                                                      \
+        c1 = word(c1, load_le64(p + len + i));                                                \
+        c2 = word(c2, load_le64(p + 2 * len + i));                                            \
+      }                                                                                       \
+      c = multiply(static_cast<u32>(k2), static_cast<u32>(c0))                                \
+        ^ multiply(static_cast<u32>(k1), static_cast<u32>(c1)) ^ static_cast<u32>(c2);        \
+    }                                                                                         \
+  }                                                                                           \
+  for(; n >= 8; n -= 8, p += 8)                                                               \
+    c = static_cast<u32>(word(c, load_le64(p)));                                              \
+  for(; n > 0; --n)                                                                           \
+    c = byte(c, *p++);
+
+#if defined(RLL_CRC32C_X86)
+  ___target___("sse4.2,pclmul") u32 multiply_pclmul(u32 const a, u32 const b) {
+    auto const product = _mm_clmulepi64_si128(_mm_cvtsi32_si128(static_cast<int>(a)),
+                                              _mm_cvtsi32_si128(static_cast<int>(b)), 0x00);
+    // the reflected 63-bit product is one bit short of the 64-bit register; reduce the low half
+    // with the crc instruction and fold in the high half
+    auto const shifted = static_cast<u64>(_mm_cvtsi128_si64(_mm_slli_epi64(product, 1)));
+    return _mm_crc32_u32(0, static_cast<u32>(shifted)) ^ static_cast<u32>(shifted >> 32);
+  }
+
+  ___target___("sse4.2") u32
+    crc32c_sse42(u32 c, u8 const* p, std::size_t n, multiply_fn const multiply) {
+    RLL_CRC32C_INTERLEAVED(_mm_crc32_u64, _mm_crc32_u8, multiply)
+    return c;
+  }
+
+  u32 crc32c_sse42_pclmul(u32 const c, u8 const* p, std::size_t const n) noexcept {
+    return crc32c_sse42(c, p, n, multiply_pclmul);
+  }
+
+  u32 crc32c_sse42_only(u32 const c, u8 const* p, std::size_t const n) noexcept {
+    return crc32c_sse42(c, p, n, multiply_portable);
+  }
+#elif defined(RLL_CRC32C_ARM)
+  u32 crc32c_armv8(u32 c, u8 const* p, std::size_t n) noexcept {
+    RLL_CRC32C_INTERLEAVED(__crc32cd, __crc32cb, multiply_portable)
+    return c;
+  }
+#endif
+#undef RLL_CRC32C_INTERLEAVED
+  // NOLINTEND(*-macro-usage, *-pro-bounds-pointer-arithmetic)
+
+  crc32c_fn select_crc32c() noexcept {
+    auto const& cpu = oslayer::cpu();
+#if defined(RLL_CRC32C_X86)
+    if(cpu.sse42 and cpu.pclmul)
+      return crc32c_sse42_pclmul;
+    if(cpu.sse42)
+      return crc32c_sse42_only;
+#elif defined(RLL_CRC32C_ARM)
+    if(cpu.arm_crc32)
+      return crc32c_armv8;
+#endif
+    static_cast<void>(cpu);
+    return crc32c_portable;
+  }
+
+  crc32c_fn active_crc32c() noexcept {
+    static auto const fn = select_crc32c();
+    return fn;
+  }
+
+  template <typename T>
+  std::string to_hex_be(T const value) {
+    auto bytes = std::array<u8, sizeof(T)>();
+    for(auto i = std::size_t(0); i < sizeof(T); i++)
+      bytes[i] = static_cast<u8>(value >> (8 * (sizeof(T) - 1 - i)));
+    return crypto::detail::to_hex(bytes.data(), bytes.size());
+  }
+}  // namespace
+
+namespace rll::crypto {
+  std::string crc32c::hash_string() const { return to_hex_be(this->crc_); }
+
+  crc32c::value_type crc32c::extend(value_type const crc, void const* data, std::size_t const len)
+    noexcept {
+    return ~active_crc32c()(~crc, static_cast<u8 const*>(data), len);
+  }
+
+  crc32c::value_type
+    crc32c::combine(value_type const crc_a, value_type const crc_b, u64 const len_b) noexcept {
+    return multmodp<u32, crc32c_poly>(x8nmodp<u32, crc32c_poly>(crc32c_x2n, len_b), crc_a) ^ crc_b;
+  }
+
+  bool crc32c::accelerated() noexcept { return active_crc32c() != crc32c_portable; }
+
+  std::string crc64::hash_string() const { return to_hex_be(this->crc_); }
+
+  crc64::value_type crc64::extend(value_type const crc, void const* data, std::size_t const len)
+    noexcept {
+    return ~extend_portable<u64, crc64_table>(~crc, static_cast<u8 const*>(data), len);
+  }
+
+  crc64::value_type
+    crc64::combine(value_type const crc_a, value_type const crc_b, u64 const len_b) noexcept {
+    return multmodp<u64, crc64_poly>(x8nmodp<u64, crc64_poly>(crc64_x2n, len_b), crc_a) ^ crc_b;
+  }
+}  // namespace rll::crypto
@@ -0,0 +1,156 @@
+#include <rll/crypto/hash_file.h>
+
+#include <algorithm>
+#include <atomic>
+#include <system_error>
+#include <thread>
+#include <rll/crypto/crc.h>
+#include <rll/crypto/fast_hash.h>
+#include <rll/crypto/md5.h>
+#include <rll/crypto/sha1.h>
+#include <rll/crypto/sha256.h>
+#include <rll/io/mapped_file.h>
+
+#include "crypto/common.h"
+
+namespace {
+  using namespace rll;
+  using crypto::hash_algorithm;
+  using crypto::hash_file_chunk_size;
+
+  template <typename Engine>
+  std::vector<u8> digest_sequential(io::mapped_file const& file) {
+    auto engine = Engine();
+    engine.append(file.view());
+    auto const digest = engine.hash();
+    return {digest.begin(), digest.end()};
+  }
+
+  void store_u128(u8* out, u128 const value) noexcept {
+    for(auto i = 0; i < 8; i++) {
+      out[i] = static_cast<u8>(value.upper() >> (56 - 8 * i));      // NOLINT(*-pointer-arithmetic)
+      out[8 + i] = static_cast<u8>(value.lower() >> (56 - 8 * i));  // NOLINT(*-pointer-arithmetic)
+    }
+  }
+
+  /// Calls `fn(index)` for every chunk index, spread over up to @p threads threads.
+  template <typename F>
+  void for_each_chunk(std::size_t const chunks, std::size_t const threads, F const& fn) {
+    auto next = std::atomic<std::size_t>(0);
+    auto const work = [&] {
+      for(auto i = next.fetch_add(1); i < chunks; i = next.fetch_add(1))
+        fn(i);
+    };
+
+    auto pool = std::vector<std::thread>();
+    try {
+      for(auto i = std::size_t(1); i < threads; i++)
+        pool.emplace_back(work);
+    } catch(std::system_error const&) {  // NOLINT(*-empty-catch)
+      // out of threads: the ones already running and this one finish the work
+    }
+    work();
+    for(auto& thread : pool)
+      thread.join();
+  }
+
+  [[nodiscard]] std::size_t chunk_count(std::size_t const size) noexcept {
+    return (size + hash_file_chunk_size - 1) / hash_file_chunk_size;
+  }
+
+  std::vector<u8> digest_fast_tree(io::mapped_file const& file, std::size_t const threads) {
+    auto const data = file.view();
+    auto leaves = std::vector<u8>(chunk_count(data.size()) * 16);
+    for_each_chunk(chunk_count(data.size()), threads, [&](std::size_t const i) {
+      store_u128(
+        leaves.data() + 16 * i,  // NOLINT(*-pointer-arithmetic)
+        crypto::fast_hash128(data.substr(i * hash_file_chunk_size, hash_file_chunk_size), i)
+      );
+    });
+
+    auto root = std::vector<u8>(16);
+    store_u128(
+      root.data(),
+      crypto::fast_hash128(
+        std::string_view(reinterpret_cast<char const*>(leaves.data()), leaves.size()),  // NOLINT
+        data.size()
+      )
+    );
+    return root;
+  }
+
+  /// Checksums the chunks in parallel and joins them with `Crc::combine`.
+  template <typename Crc>
+  std::vector<u8> digest_crc(io::mapped_file const& file, std::size_t const threads) {
+    auto const data = file.view();
+    auto parts = std::vector<typename Crc::value_type>(chunk_count(data.size()));
+    for_each_chunk(parts.size(), threads, [&](std::size_t const i) {
+      parts[i] = Crc::compute(data.substr(i * hash_file_chunk_size, hash_file_chunk_size));
+    });
+
+    auto crc = typename Crc::value_type();
+    for(auto i = std::size_t(0); i < parts.size(); i++)
+      crc = Crc::combine(
+        crc,
+        parts[i],
+        std::min(hash_file_chunk_size, data.size() - i * hash_file_chunk_size)
+      );
+
+    auto digest = std::vector<u8>(sizeof(crc));
+    for(auto i = std::size_t(0); i < digest.size(); i++)
+      digest[i] = static_cast<u8>(crc >> (8 * (digest.size() - 1 - i)));
+    return digest;
+  }
+}  // namespace
+
+namespace rll::crypto {
+  std::string file_digest::to_string() const {
+    return detail::to_hex(this->digest.data(), this->digest.size());
+  }
+
+  f64 file_digest::throughput() const noexcept {
+    auto const seconds = std::chrono::duration<f64>(this->elapsed).count();
+    return seconds > 0 ? static_cast<f64>(this->size) / seconds : 0.0;
+  }
+
+  result<file_digest> hash_file(
+    std::filesystem::path const& path,
+    hash_algorithm const algorithm,
+    std::size_t threads
+  ) noexcept {
+    auto const start = std::chrono::steady_clock::now();
+    auto file = io::mapped_file::open(path);
+    if(not file)
+      return error("rll::crypto::hash_file: {}", file.error());
+
+    auto res = file_digest();
+    res.algorithm = algorithm;
+    res.size = file->size();
+    try {
+      switch(algorithm) {
+        case hash_algorithm::md5: res.digest = digest_sequential<md5_engine>(*file); break;
+        case hash_algorithm::sha1: res.digest = digest_sequential<sha1_engine>(*file); break;
+        case hash_algorithm::sha256: res.digest = digest_sequential<sha256_engine>(*file); break;
+        case hash_algorithm::fast_tree:
+        case hash_algorithm::crc32c:
+        case hash_algorithm::crc64: {
+          if(threads == 0)
+            threads = std::max(1U, std::thread::hardware_concurrency());
+          res.threads = std::max(std::size_t(1), std::min(threads, chunk_count(file->size())));
+          if(algorithm == hash_algorithm::fast_tree)
+            res.digest = digest_fast_tree(*file, res.threads);
+          else if(algorithm == hash_algorithm::crc32c)
+            res.digest = digest_crc<crc32c>(*file, res.threads);
+          else
+            res.digest = digest_crc<crc64>(*file, res.threads);
+          break;
+        }
+        default: return error("rll::crypto::hash_file: unknown algorithm");
+      }
+    } catch(std::exception const& e) {
+      return error("rll::crypto::hash_file: {}", e.what());
+    }
+    res.elapsed = std::chrono::steady_clock::now() - start;
+    return res;
+  }
+}  // namespace rll::crypto
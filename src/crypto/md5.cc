@@ -1,5 +1,7 @@
 #include <rll/crypto/md5.h>
 
+#include "crypto/common.h"
+
 namespace {
   using namespace rll;
 
@@ -31,27 +33,20 @@ namespace {
 }  // namespace
 
 namespace rll::crypto {
-  struct md5::md5_private {
-    mutable u64 num_bytes;
-    mutable std::size_t buffer_size;
-    mutable std::array<u8, block_size> buffer;
-    mutable std::array<u32, digest_size / sizeof(u32)> state;
-
-    md5_private() { this->reset(); }
-
-    void process_block(void const* block) const {
-      auto a = this->state[0];
-      auto b = this->state[1];
-      auto c = this->state[2];
-      auto d = this->state[3];
-      auto const* words = static_cast<u32 const*>(block);
-
+  void md5_engine::compress(state_type& state, u8 const* blocks, std::size_t count) noexcept {
 #if defined(__BYTE_ORDER) && (__BYTE_ORDER != 0) && (__BYTE_ORDER == __BIG_ENDIAN)
 #  define LITTLEENDIAN(x) swap(x)
 #else
 #  define LITTLEENDIAN(x) (x)
 #endif
 
+    for(; count > 0; --count, blocks += block_size) {
+      auto a = state[0];
+      auto b = state[1];
+      auto c = state[2];
+      auto d = state[3];
+      auto const* words = reinterpret_cast<u32 const*>(blocks);  // NOLINT
+
       // first round
       auto const word0 = LITTLEENDIAN(words[0]);
       a = rotate(a + f1(b, c, d) + word0 + 0xd76aa478, 7) + b;
@@ -149,78 +144,36 @@ namespace rll::crypto {
       c = rotate(c + f4(d, a, b) + word2 + 0x2ad7d2bb, 15) + d;
       b = rotate(b + f4(c, d, a) + word9 + 0xeb86d391, 21) + c;
 
-      this->state[0] += a;
-      this->state[1] += b;
-      this->state[2] += c;
-      this->state[3] += d;
+      state[0] += a;
+      state[1] += b;
+      state[2] += c;
+      state[3] += d;
     }
 
-    void process_all() const {
-      auto padded_len = this->buffer_size * 8;
-      padded_len++;
-      if(auto const lower_11_bits = padded_len & 511; lower_11_bits <= 448)
-        padded_len += 448 - lower_11_bits;
-      else
-        padded_len += 512 + 448 - lower_11_bits;
-      padded_len /= 8;
-
-      auto extra = std::array<u8, block_size>();
-      if(this->buffer_size < block_size)
-        this->buffer[this->buffer_size] = 128;
-      else
-        extra[0] = 128;
-
-      auto i = std::size_t();
-      for(i = this->buffer_size + 1; i < block_size; i++)
-        this->buffer[i] = 0;
-      for(; i < padded_len; i++)
-        extra[i - md5::block_size] = 0;
-
-      auto msg_bits = 8 * this->num_bytes + this->buffer_size;
-      auto* add_length = static_cast<u8*>(nullptr);
-      if(padded_len < md5::block_size)
-        add_length = this->buffer.data() + padded_len;
-      else
-        add_length = extra.data() + padded_len - md5::block_size;
-
-      // must be little endian
-      *add_length++ = msg_bits & 0xFF;
-      msg_bits >>= 8;
-      *add_length++ = msg_bits & 0xFF;
-      msg_bits >>= 8;
-      *add_length++ = msg_bits & 0xFF;
-      msg_bits >>= 8;
-      *add_length++ = msg_bits & 0xFF;
-      msg_bits >>= 8;
-      *add_length++ = msg_bits & 0xFF;
-      msg_bits >>= 8;
-      *add_length++ = msg_bits & 0xFF;
-      msg_bits >>= 8;
-      *add_length++ = msg_bits & 0xFF;
-      msg_bits >>= 8;
-      *add_length++ = msg_bits & 0xFF;
-
-      this->process_block(this->buffer.data());
-      if(padded_len > block_size)
-        this->process_block(extra.data());
-    }
+#undef LITTLEENDIAN
+  }
 
-    void reset() {
-      this->num_bytes = 0;
-      this->buffer_size = 0;
-      this->state = {
-        0x67452301,
-        0xefcdab89,
-        0x98badcfe,
-        0x10325476,
-      };
-    }
-  };
+  md5_engine::digest_type md5_engine::hash() const noexcept {
+    auto state = this->state_;
+    detail::finish(
+      state,
+      this->buffer_,
+      detail::length_order::little_endian,
+      &md5_engine::compress
+    );
 
-  md5::md5()
-    : impl(std::make_unique<md5_private>()) {}
+    auto current = digest_type();
+    auto* current_ptr = current.data();
+    for(auto i = std::size_t(0); i < digest_size / sizeof(u32); i++) {
+      *current_ptr++ = state[i] & 0xFF;
+      *current_ptr++ = (state[i] >> 8) & 0xFF;
+      *current_ptr++ = (state[i] >> 16) & 0xFF;
+      *current_ptr++ = (state[i] >> 24) & 0xFF;
+    }
+    return current;
+  }
 
-  md5::~md5() = default;
+  uuid md5_engine::hash_uuid() const noexcept { return uuid(this->hash()); }
 
   basic_hasher& md5::append(std::string const& str) {
     return this->append(str.c_str(), str.size());
@@ -231,68 +184,18 @@ namespace rll::crypto {
   }
 
   basic_hasher& md5::append(void const* str, std::size_t len) {
-    auto const* current = static_cast<u8 const*>(str);
-
-    if(impl->buffer_size > 0) {
-      while(len > 0 and impl->buffer_size < md5::block_size) {
-        impl->buffer[impl->buffer_size++] = *current++;
-        len--;
-      }
-    }
-
-    if(impl->buffer_size == md5::block_size) {
-      impl->process_block(impl->buffer.data());
-      impl->num_bytes += md5::block_size;
-      impl->buffer_size = 0;
-    }
-
-    if(len == 0)
-      return *this;
-
-    while(len >= md5::block_size) {
-      impl->process_block(current);
-      current += md5::block_size;
-      impl->num_bytes += md5::block_size;
-      len -= md5::block_size;
-    }
-
-    while(len > 0) {
-      impl->buffer[impl->buffer_size++] = *current++;
-      len--;
-    }
-
+    this->engine_.append(str, len);
     return *this;
   }
 
-  void md5::reset() { impl->reset(); }
+  void md5::reset() { this->engine_.reset(); }
 
   std::string md5::hash_string() const {
     auto const hash = this->hash();
-    auto res = std::string();
-    res.reserve(2 * md5::digest_size);
-    for(auto i = 0; i < md5::digest_size; i++) {
-      res.push_back("0123456789abcdef"[(hash[i] >> 4) & 0xF]);
-      res.push_back("0123456789abcdef"[hash[i] & 0xF]);
-    }
-    return res;
+    return detail::to_hex(hash.data(), hash.size());
   }
 
-  md5::digest_type md5::hash() const {  // save old hash if buffer is partially filled
-    auto const old = impl->state;
-    impl->process_all();
-
-    auto current = md5::digest_type();
-    auto* current_ptr = current.data();
-    for(auto i = 0; i < md5::digest_size / sizeof(u32); i++) {
-      *current_ptr++ = impl->state[i] & 0xFF;
-      *current_ptr++ = (impl->state[i] >> 8) & 0xFF;
-      *current_ptr++ = (impl->state[i] >> 16) & 0xFF;
-      *current_ptr++ = (impl->state[i] >> 24) & 0xFF;
-      impl->state[i] = old[i];
-    }
-
-    return current;
-  }
+  md5::digest_type md5::hash() const { return this->engine_.hash(); }
 
-  uuid md5::hash_uuid() const { return uuid(this->hash()); }
+  uuid md5::hash_uuid() const { return this->engine_.hash_uuid(); }
 }  // namespace rll::crypto
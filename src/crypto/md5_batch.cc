@@ -0,0 +1,386 @@
+#include <rll/crypto/md5_batch.h>
+
+#include <algorithm>
+#include <cstring>
+#include "oslayer/cpu.h"
+
+#if defined(RLL_ARCH_X86_64) || defined(RLL_ARCH_X86_32)
+#  include <immintrin.h>
+#  define RLL_MD5_X86
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define RLL_MD5_NEON
+#endif
+
+// NOLINTBEGIN(*-macro-usage, *-pro-type-reinterpret-cast, *-pro-bounds-pointer-arithmetic)
+
+// all 64 md5 steps as (function, a, b, c, d, word index, constant, rotation)
+#define RLL_MD5_STEPS(S) \
+  S(RLL_MD5_F1, a, b, c, d, 0, 0xd76aa478, 7) \
+  S(RLL_MD5_F1, d, a, b, c, 1, 0xe8c7b756, 12) \
+  S(RLL_MD5_F1, c, d, a, b, 2, 0x242070db, 17) \
+  S(RLL_MD5_F1, b, c, d, a, 3, 0xc1bdceee, 22) \
+  S(RLL_MD5_F1, a, b, c, d, 4, 0xf57c0faf, 7) \
+  S(RLL_MD5_F1, d, a, b, c, 5, 0x4787c62a, 12) \
+  S(RLL_MD5_F1, c, d, a, b, 6, 0xa8304613, 17) \
+  S(RLL_MD5_F1, b, c, d, a, 7, 0xfd469501, 22) \
+  S(RLL_MD5_F1, a, b, c, d, 8, 0x698098d8, 7) \
+  S(RLL_MD5_F1, d, a, b, c, 9, 0x8b44f7af, 12) \
+  S(RLL_MD5_F1, c, d, a, b, 10, 0xffff5bb1, 17) \
+  S(RLL_MD5_F1, b, c, d, a, 11, 0x895cd7be, 22) \
+  S(RLL_MD5_F1, a, b, c, d, 12, 0x6b901122, 7) \
+  S(RLL_MD5_F1, d, a, b, c, 13, 0xfd987193, 12) \
+  S(RLL_MD5_F1, c, d, a, b, 14, 0xa679438e, 17) \
+  S(RLL_MD5_F1, b, c, d, a, 15, 0x49b40821, 22) \
+  S(RLL_MD5_F2, a, b, c, d, 1, 0xf61e2562, 5) \
+  S(RLL_MD5_F2, d, a, b, c, 6, 0xc040b340, 9) \
+  S(RLL_MD5_F2, c, d, a, b, 11, 0x265e5a51, 14) \
+  S(RLL_MD5_F2, b, c, d, a, 0, 0xe9b6c7aa, 20) \
+  S(RLL_MD5_F2, a, b, c, d, 5, 0xd62f105d, 5) \
+  S(RLL_MD5_F2, d, a, b, c, 10, 0x02441453, 9) \
+  S(RLL_MD5_F2, c, d, a, b, 15, 0xd8a1e681, 14) \
+  S(RLL_MD5_F2, b, c, d, a, 4, 0xe7d3fbc8, 20) \
+  S(RLL_MD5_F2, a, b, c, d, 9, 0x21e1cde6, 5) \
+  S(RLL_MD5_F2, d, a, b, c, 14, 0xc33707d6, 9) \
+  S(RLL_MD5_F2, c, d, a, b, 3, 0xf4d50d87, 14) \
+  S(RLL_MD5_F2, b, c, d, a, 8, 0x455a14ed, 20) \
+  S(RLL_MD5_F2, a, b, c, d, 13, 0xa9e3e905, 5) \
+  S(RLL_MD5_F2, d, a, b, c, 2, 0xfcefa3f8, 9) \
+  S(RLL_MD5_F2, c, d, a, b, 7, 0x676f02d9, 14) \
+  S(RLL_MD5_F2, b, c, d, a, 12, 0x8d2a4c8a, 20) \
+  S(RLL_MD5_F3, a, b, c, d, 5, 0xfffa3942, 4) \
+  S(RLL_MD5_F3, d, a, b, c, 8, 0x8771f681, 11) \
+  S(RLL_MD5_F3, c, d, a, b, 11, 0x6d9d6122, 16) \
+  S(RLL_MD5_F3, b, c, d, a, 14, 0xfde5380c, 23) \
+  S(RLL_MD5_F3, a, b, c, d, 1, 0xa4beea44, 4) \
+  S(RLL_MD5_F3, d, a, b, c, 4, 0x4bdecfa9, 11) \
+  S(RLL_MD5_F3, c, d, a, b, 7, 0xf6bb4b60, 16) \
+  S(RLL_MD5_F3, b, c, d, a, 10, 0xbebfbc70, 23) \
+  S(RLL_MD5_F3, a, b, c, d, 13, 0x289b7ec6, 4) \
+  S(RLL_MD5_F3, d, a, b, c, 0, 0xeaa127fa, 11) \
+  S(RLL_MD5_F3, c, d, a, b, 3, 0xd4ef3085, 16) \
+  S(RLL_MD5_F3, b, c, d, a, 6, 0x04881d05, 23) \
+  S(RLL_MD5_F3, a, b, c, d, 9, 0xd9d4d039, 4) \
+  S(RLL_MD5_F3, d, a, b, c, 12, 0xe6db99e5, 11) \
+  S(RLL_MD5_F3, c, d, a, b, 15, 0x1fa27cf8, 16) \
+  S(RLL_MD5_F3, b, c, d, a, 2, 0xc4ac5665, 23) \
+  S(RLL_MD5_F4, a, b, c, d, 0, 0xf4292244, 6) \
+  S(RLL_MD5_F4, d, a, b, c, 7, 0x432aff97, 10) \
+  S(RLL_MD5_F4, c, d, a, b, 14, 0xab9423a7, 15) \
+  S(RLL_MD5_F4, b, c, d, a, 5, 0xfc93a039, 21) \
+  S(RLL_MD5_F4, a, b, c, d, 12, 0x655b59c3, 6) \
+  S(RLL_MD5_F4, d, a, b, c, 3, 0x8f0ccc92, 10) \
+  S(RLL_MD5_F4, c, d, a, b, 10, 0xffeff47d, 15) \
+  S(RLL_MD5_F4, b, c, d, a, 1, 0x85845dd1, 21) \
+  S(RLL_MD5_F4, a, b, c, d, 8, 0x6fa87e4f, 6) \
+  S(RLL_MD5_F4, d, a, b, c, 15, 0xfe2ce6e0, 10) \
+  S(RLL_MD5_F4, c, d, a, b, 6, 0xa3014314, 15) \
+  S(RLL_MD5_F4, b, c, d, a, 13, 0x4e0811a1, 21) \
+  S(RLL_MD5_F4, a, b, c, d, 4, 0xf7537e82, 6) \
+  S(RLL_MD5_F4, d, a, b, c, 11, 0xbd3af235, 10) \
+  S(RLL_MD5_F4, c, d, a, b, 2, 0x2ad7d2bb, 15) \
+  S(RLL_MD5_F4, b, c, d, a, 9, 0xeb86d391, 21)
+
+#define RLL_MD5_F1(b, c, d) V_XOR(d, V_AND(b, V_XOR(c, d)))
+#define RLL_MD5_F2(b, c, d) V_XOR(c, V_AND(d, V_XOR(b, c)))
+#define RLL_MD5_F3(b, c, d) V_XOR(V_XOR(b, c), d)
+#define RLL_MD5_F4(b, c, d) V_XOR(c, V_OR(b, V_NOT(d)))
+#define RLL_MD5_STEP(f, a, b, c, d, k, t, s) \
+  a = V_ADD(V_ROTL(V_ADD(V_ADD(a, f(b, c, d)), V_ADD(V_LOAD(k), V_SET1(t))), s), b);
+
+namespace {
+  using namespace rll;
+  using crypto::md5;
+
+  constexpr auto max_lanes = std::size_t(16);
+  constexpr auto words_per_block = md5::block_size / sizeof(u32);
+
+  // state is laid out as 4 rows of `lanes` words, message words as 16 rows of `lanes` words
+  using compress_fn = void (*)(u32* state, u32 const* words);
+
+  void compress_scalar(u32* state, u32 const* words) {
+#define V_ADD(x, y) ((x) + (y))
+#define V_AND(x, y) ((x) & (y))
+#define V_OR(x, y) ((x) | (y))
+#define V_XOR(x, y) ((x) ^ (y))
+#define V_NOT(x) (~(x))
+#define V_ROTL(x, s) (((x) << (s)) | ((x) >> (32 - (s))))
+#define V_LOAD(k) words[k]
+#define V_SET1(t) static_cast<u32>(t)
+    auto a = state[0];
+    auto b = state[1];
+    auto c = state[2];
+    auto d = state[3];
+    RLL_MD5_STEPS(RLL_MD5_STEP)
+    state[0] += a;
+    state[1] += b;
+    state[2] += c;
+    state[3] += d;
+#undef V_ADD
+#undef V_AND
+#undef V_OR
+#undef V_XOR
+#undef V_NOT
+#undef V_ROTL
+#undef V_LOAD
+#undef V_SET1
+  }
+
+#if defined(RLL_MD5_X86)
+  ___target___("sse2") void compress_sse2(u32* state, u32 const* words) {
+#  define V_ADD(x, y) _mm_add_epi32(x, y)
+#  define V_AND(x, y) _mm_and_si128(x, y)
+#  define V_OR(x, y) _mm_or_si128(x, y)
+#  define V_XOR(x, y) _mm_xor_si128(x, y)
+#  define V_NOT(x) _mm_xor_si128(x, _mm_set1_epi32(-1))
+#  define V_ROTL(x, s) _mm_or_si128(_mm_slli_epi32(x, s), _mm_srli_epi32(x, 32 - (s)))
+#  define V_LOAD(k) _mm_load_si128(reinterpret_cast<__m128i const*>(words) + (k))
+#  define V_SET1(t) _mm_set1_epi32(static_cast<int>(t))
+    auto* st = reinterpret_cast<__m128i*>(state);
+    auto a = _mm_load_si128(st + 0);
+    auto b = _mm_load_si128(st + 1);
+    auto c = _mm_load_si128(st + 2);
+    auto d = _mm_load_si128(st + 3);
+    RLL_MD5_STEPS(RLL_MD5_STEP)
+    _mm_store_si128(st + 0, _mm_add_epi32(_mm_load_si128(st + 0), a));
+    _mm_store_si128(st + 1, _mm_add_epi32(_mm_load_si128(st + 1), b));
+    _mm_store_si128(st + 2, _mm_add_epi32(_mm_load_si128(st + 2), c));
+    _mm_store_si128(st + 3, _mm_add_epi32(_mm_load_si128(st + 3), d));
+#  undef V_ADD
+#  undef V_AND
+#  undef V_OR
+#  undef V_XOR
+#  undef V_NOT
+#  undef V_ROTL
+#  undef V_LOAD
+#  undef V_SET1
+  }
+
+  ___target___("avx2") void compress_avx2(u32* state, u32 const* words) {
+#  define V_ADD(x, y) _mm256_add_epi32(x, y)
+#  define V_AND(x, y) _mm256_and_si256(x, y)
+#  define V_OR(x, y) _mm256_or_si256(x, y)
+#  define V_XOR(x, y) _mm256_xor_si256(x, y)
+#  define V_NOT(x) _mm256_xor_si256(x, _mm256_set1_epi32(-1))
+#  define V_ROTL(x, s) _mm256_or_si256(_mm256_slli_epi32(x, s), _mm256_srli_epi32(x, 32 - (s)))
+#  define V_LOAD(k) _mm256_load_si256(reinterpret_cast<__m256i const*>(words) + (k))
+#  define V_SET1(t) _mm256_set1_epi32(static_cast<int>(t))
+    auto* st = reinterpret_cast<__m256i*>(state);
+    auto a = _mm256_load_si256(st + 0);
+    auto b = _mm256_load_si256(st + 1);
+    auto c = _mm256_load_si256(st + 2);
+    auto d = _mm256_load_si256(st + 3);
+    RLL_MD5_STEPS(RLL_MD5_STEP)
+    _mm256_store_si256(st + 0, _mm256_add_epi32(_mm256_load_si256(st + 0), a));
+    _mm256_store_si256(st + 1, _mm256_add_epi32(_mm256_load_si256(st + 1), b));
+    _mm256_store_si256(st + 2, _mm256_add_epi32(_mm256_load_si256(st + 2), c));
+    _mm256_store_si256(st + 3, _mm256_add_epi32(_mm256_load_si256(st + 3), d));
+#  undef V_ADD
+#  undef V_AND
+#  undef V_OR
+#  undef V_XOR
+#  undef V_NOT
+#  undef V_ROTL
+#  undef V_LOAD
+#  undef V_SET1
+  }
+
+  // GCC 12 reports the _mm512_undefined_epi32() inside _mm512_rol_epi32 as uninitialized
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wuninitialized"
+#  endif
+  ___target___("avx512f") void compress_avx512(u32* state, u32 const* words) {
+#  define V_ADD(x, y) _mm512_add_epi32(x, y)
+#  define V_AND(x, y) _mm512_and_si512(x, y)
+#  define V_OR(x, y) _mm512_or_si512(x, y)
+#  define V_XOR(x, y) _mm512_xor_si512(x, y)
+#  define V_NOT(x) _mm512_xor_si512(x, _mm512_set1_epi32(-1))
+#  define V_ROTL(x, s) _mm512_rol_epi32(x, s)
+#  define V_LOAD(k) _mm512_load_si512(reinterpret_cast<__m512i const*>(words) + (k))
+#  define V_SET1(t) _mm512_set1_epi32(static_cast<int>(t))
+    auto* st = reinterpret_cast<__m512i*>(state);
+    auto a = _mm512_load_si512(st + 0);
+    auto b = _mm512_load_si512(st + 1);
+    auto c = _mm512_load_si512(st + 2);
+    auto d = _mm512_load_si512(st + 3);
+    RLL_MD5_STEPS(RLL_MD5_STEP)
+    _mm512_store_si512(st + 0, _mm512_add_epi32(_mm512_load_si512(st + 0), a));
+    _mm512_store_si512(st + 1, _mm512_add_epi32(_mm512_load_si512(st + 1), b));
+    _mm512_store_si512(st + 2, _mm512_add_epi32(_mm512_load_si512(st + 2), c));
+    _mm512_store_si512(st + 3, _mm512_add_epi32(_mm512_load_si512(st + 3), d));
+#  undef V_ADD
+#  undef V_AND
+#  undef V_OR
+#  undef V_XOR
+#  undef V_NOT
+#  undef V_ROTL
+#  undef V_LOAD
+#  undef V_SET1
+  }
+#  if defined(__GNUC__) && !defined(__clang__)
+#    pragma GCC diagnostic pop
+#  endif
+#elif defined(RLL_MD5_NEON)
+  void compress_neon(u32* state, u32 const* words) {
+#  define V_ADD(x, y) vaddq_u32(x, y)
+#  define V_AND(x, y) vandq_u32(x, y)
+#  define V_OR(x, y) vorrq_u32(x, y)
+#  define V_XOR(x, y) veorq_u32(x, y)
+#  define V_NOT(x) vmvnq_u32(x)
+#  define V_ROTL(x, s) vorrq_u32(vshlq_n_u32(x, s), vshrq_n_u32(x, 32 - (s)))
+#  define V_LOAD(k) vld1q_u32(words + 4 * (k))
+#  define V_SET1(t) vdupq_n_u32(static_cast<u32>(t))
+    auto a = vld1q_u32(state + 0);
+    auto b = vld1q_u32(state + 4);
+    auto c = vld1q_u32(state + 8);
+    auto d = vld1q_u32(state + 12);
+    RLL_MD5_STEPS(RLL_MD5_STEP)
+    vst1q_u32(state + 0, vaddq_u32(vld1q_u32(state + 0), a));
+    vst1q_u32(state + 4, vaddq_u32(vld1q_u32(state + 4), b));
+    vst1q_u32(state + 8, vaddq_u32(vld1q_u32(state + 8), c));
+    vst1q_u32(state + 12, vaddq_u32(vld1q_u32(state + 12), d));
+#  undef V_ADD
+#  undef V_AND
+#  undef V_OR
+#  undef V_XOR
+#  undef V_NOT
+#  undef V_ROTL
+#  undef V_LOAD
+#  undef V_SET1
+  }
+#endif
+
+  struct kernel {
+    compress_fn compress;
+    std::size_t lanes;
+  };
+
+  kernel select_kernel() noexcept {
+#if defined(RLL_MD5_X86)
+    auto const& cpu = oslayer::cpu();
+    if(cpu.avx512f)
+      return {compress_avx512, 16};
+    if(cpu.avx2)
+      return {compress_avx2, 8};
+    if(cpu.sse2)
+      return {compress_sse2, 4};
+#elif defined(RLL_MD5_NEON)
+    return {compress_neon, 4};
+#endif
+    return {compress_scalar, 1};
+  }
+
+  kernel const& active_kernel() noexcept {
+    static auto const k = select_kernel();
+    return k;
+  }
+
+  constexpr u32 load_le32(u8 const* p) {
+    return static_cast<u32>(p[0]) | (static_cast<u32>(p[1]) << 8) | (static_cast<u32>(p[2]) << 16)
+         | (static_cast<u32>(p[3]) << 24);
+  }
+
+  /**
+   * One message in flight: full blocks are read in place, the padded tail (one or two blocks)
+   * is built once when the message is assigned to a lane.
+   */
+  struct lane {
+    u8 const* data = nullptr;
+    std::size_t message = 0;
+    std::size_t block = 0;
+    std::size_t full_blocks = 0;
+    std::size_t total_blocks = 0;
+    std::array<u8, 2 * md5::block_size> tail = {};
+
+    void assign(std::string_view const msg, std::size_t const index) noexcept {
+      this->data = reinterpret_cast<u8 const*>(msg.data());
+      this->message = index;
+      this->block = 0;
+      this->full_blocks = msg.size() / md5::block_size;
+      auto const rest = msg.size() % md5::block_size;
+      this->total_blocks = this->full_blocks + (rest < md5::block_size - sizeof(u64) ? 1 : 2);
+
+      auto const tail_size = (this->total_blocks - this->full_blocks) * md5::block_size;
+      std::fill_n(this->tail.begin(), tail_size, u8(0));
+      if(rest > 0)
+        std::memcpy(this->tail.data(), this->data + this->full_blocks * md5::block_size, rest);
+      this->tail[rest] = 0x80;
+      auto bits = static_cast<u64>(msg.size()) * 8;
+      for(auto i = tail_size - sizeof(u64); i < tail_size; ++i, bits >>= 8)
+        this->tail[i] = static_cast<u8>(bits & 0xFF);
+    }
+
+    [[nodiscard]] u8 const* current() const noexcept {
+      if(this->block < this->full_blocks)
+        return this->data + this->block * md5::block_size;
+      return this->tail.data() + (this->block - this->full_blocks) * md5::block_size;
+    }
+  };
+}  // namespace
+
+// NOLINTEND(*-macro-usage, *-pro-type-reinterpret-cast, *-pro-bounds-pointer-arithmetic)
+
+namespace rll::crypto {
+  void md5_batch(
+    std::string_view const* messages,
+    md5::digest_type* digests,
+    std::size_t const count
+  ) noexcept {
+    constexpr auto iv = std::array<u32, 4> {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+
+    auto const& k = active_kernel();
+    auto const n = k.lanes;
+    alignas(64) auto state = std::array<u32, 4 * max_lanes>();
+    alignas(64) auto words = std::array<u32, words_per_block * max_lanes>();
+    auto lanes = std::array<lane, max_lanes>();
+    auto active = std::array<bool, max_lanes>();
+    auto next = std::size_t(0);
+    auto done = std::size_t(0);
+
+    auto const refill = [&](std::size_t const l) {
+      active[l] = next < count;
+      if(not active[l])
+        return;
+      lanes[l].assign(messages[next], next);
+      for(auto i = std::size_t(0); i < iv.size(); ++i)
+        state[i * n + l] = iv[i];
+      ++next;
+    };
+
+    for(auto l = std::size_t(0); l < n; ++l)
+      refill(l);
+    while(done < count) {
+      for(auto l = std::size_t(0); l < n; ++l) {
+        if(not active[l])
+          continue;
+        auto const* block = lanes[l].current();
+        for(auto w = std::size_t(0); w < words_per_block; ++w)
+          words[w * n + l] = load_le32(block + w * sizeof(u32));
+      }
+      k.compress(state.data(), words.data());
+      for(auto l = std::size_t(0); l < n; ++l) {
+        if(not active[l] or ++lanes[l].block < lanes[l].total_blocks)
+          continue;
+        auto& digest = digests[lanes[l].message];
+        for(auto i = std::size_t(0); i < iv.size(); ++i) {
+          auto const word = state[i * n + l];
+          digest[i * 4 + 0] = word & 0xFF;
+          digest[i * 4 + 1] = (word >> 8) & 0xFF;
+          digest[i * 4 + 2] = (word >> 16) & 0xFF;
+          digest[i * 4 + 3] = (word >> 24) & 0xFF;
+        }
+        ++done;
+        refill(l);
+      }
+    }
+  }
+
+  std::vector<md5::digest_type> md5_batch(std::vector<std::string_view> const& messages) {
+    auto digests = std::vector<md5::digest_type>(messages.size());
+    md5_batch(messages.data(), digests.data(), messages.size());
+    return digests;
+  }
+
+  std::size_t md5_batch_lanes() noexcept { return active_kernel().lanes; }
+}  // namespace rll::crypto
@@ -0,0 +1,236 @@
+#include <rll/crypto/sha1.h>
+
+#include "crypto/common.h"
+#include "oslayer/cpu.h"
+
+#if defined(RLL_ARCH_X86_64) || defined(RLL_ARCH_X86_32)
+#  include <immintrin.h>
+#  define RLL_SHA1_X86
+#elif (defined(__aarch64__) || defined(_M_ARM64)) \
+  && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#  include <arm_neon.h>
+#  define RLL_SHA1_ARM
+#endif
+
+namespace {
+  using namespace rll;
+  using crypto::sha1;
+  using state_type = crypto::sha1_engine::state_type;
+  using compress_fn = void (*)(state_type&, u8 const*, std::size_t);
+
+  void compress_portable(state_type& state, u8 const* blocks, std::size_t count) {
+    using crypto::detail::rotl;
+    auto w = std::array<u32, 80>();
+    for(; count > 0; --count, blocks += sha1::block_size) {
+      for(auto i = 0; i < 16; ++i)
+        w[i] = crypto::detail::load_be32(blocks + 4 * i);
+      for(auto i = 16; i < 80; ++i)
+        w[i] = rotl(w[i - 3] ^ w[i - 8] ^ w[i - 14] ^ w[i - 16], 1);
+
+      auto a = state[0];
+      auto b = state[1];
+      auto c = state[2];
+      auto d = state[3];
+      auto e = state[4];
+      auto const round = [&](u32 const f, u32 const k, u32 const w) {
+        auto const t = rotl(a, 5) + f + e + k + w;
+        e = d;
+        d = c;
+        c = rotl(b, 30);
+        b = a;
+        a = t;
+      };
+      for(auto i = 0; i < 20; ++i)
+        round(d ^ (b & (c ^ d)), 0x5a827999, w[i]);
+      for(auto i = 20; i < 40; ++i)
+        round(b ^ c ^ d, 0x6ed9eba1, w[i]);
+      for(auto i = 40; i < 60; ++i)
+        round((b & c) | (d & (b | c)), 0x8f1bbcdc, w[i]);
+      for(auto i = 60; i < 80; ++i)
+        round(b ^ c ^ d, 0xca62c1d6, w[i]);
+      state[0] += a;
+      state[1] += b;
+      state[2] += c;
+      state[3] += d;
+      state[4] += e;
+    }
+  }
+
+  // NOLINTBEGIN(*-macro-usage, *-pro-type-reinterpret-cast, *-pro-bounds-pointer-arithmetic)
+#if defined(RLL_SHA1_X86)
+  // four rounds per group; e_in carries this group's e + w, e_out receives the next one
+#  define RLL_SHA1_GROUP(g, e_in, e_out, cur, next, prev, prev2)                          \
+    e_in = (g) == 0 ? _mm_add_epi32(e_in, cur) : _mm_sha1nexte_epu32(e_in, cur);        \
+    e_out = abcd;                                                                         \
+    if((g) >= 3 and (g) <= 18)                                                            \
+      next = _mm_sha1msg2_epu32(next, cur);                                               \
+    abcd = _mm_sha1rnds4_epu32(abcd, e_in, (g) / 5);                                      \
+    if((g) >= 1 and (g) <= 16)                                                            \
+      prev = _mm_sha1msg1_epu32(prev, cur);                                               \
+    if((g) >= 2 and (g) <= 17)                                                            \
+      prev2 = _mm_xor_si128(prev2, cur);
+
+  ___target___("sha,sse4.1,ssse3") void compress_shani(
+    state_type& state,
+    u8 const* blocks,
+    std::size_t count
+  ) {
+    auto const mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+    auto abcd = _mm_loadu_si128(reinterpret_cast<__m128i const*>(state.data()));
+    auto e0 = _mm_set_epi32(static_cast<int>(state[4]), 0, 0, 0);
+    abcd = _mm_shuffle_epi32(abcd, 0x1B);
+
+    for(; count > 0; --count, blocks += sha1::block_size) {
+      auto const abcd_save = abcd;
+      auto const e0_save = e0;
+      auto const* in = reinterpret_cast<__m128i const*>(blocks);
+      auto m0 = _mm_shuffle_epi8(_mm_loadu_si128(in + 0), mask);
+      auto m1 = _mm_shuffle_epi8(_mm_loadu_si128(in + 1), mask);
+      auto m2 = _mm_shuffle_epi8(_mm_loadu_si128(in + 2), mask);
+      auto m3 = _mm_shuffle_epi8(_mm_loadu_si128(in + 3), mask);
+      auto e1 = __m128i();
+
+      RLL_SHA1_GROUP(0, e0, e1, m0, m1, m3, m2)
+      RLL_SHA1_GROUP(1, e1, e0, m1, m2, m0, m3)
+      RLL_SHA1_GROUP(2, e0, e1, m2, m3, m1, m0)
+      RLL_SHA1_GROUP(3, e1, e0, m3, m0, m2, m1)
+      RLL_SHA1_GROUP(4, e0, e1, m0, m1, m3, m2)
+      RLL_SHA1_GROUP(5, e1, e0, m1, m2, m0, m3)
+      RLL_SHA1_GROUP(6, e0, e1, m2, m3, m1, m0)
+      RLL_SHA1_GROUP(7, e1, e0, m3, m0, m2, m1)
+      RLL_SHA1_GROUP(8, e0, e1, m0, m1, m3, m2)
+      RLL_SHA1_GROUP(9, e1, e0, m1, m2, m0, m3)
+      RLL_SHA1_GROUP(10, e0, e1, m2, m3, m1, m0)
+      RLL_SHA1_GROUP(11, e1, e0, m3, m0, m2, m1)
+      RLL_SHA1_GROUP(12, e0, e1, m0, m1, m3, m2)
+      RLL_SHA1_GROUP(13, e1, e0, m1, m2, m0, m3)
+      RLL_SHA1_GROUP(14, e0, e1, m2, m3, m1, m0)
+      RLL_SHA1_GROUP(15, e1, e0, m3, m0, m2, m1)
+      RLL_SHA1_GROUP(16, e0, e1, m0, m1, m3, m2)
+      RLL_SHA1_GROUP(17, e1, e0, m1, m2, m0, m3)
+      RLL_SHA1_GROUP(18, e0, e1, m2, m3, m1, m0)
+      RLL_SHA1_GROUP(19, e1, e0, m3, m0, m2, m1)
+
+      e0 = _mm_sha1nexte_epu32(e0, e0_save);
+      abcd = _mm_add_epi32(abcd, abcd_save);
+    }
+
+    abcd = _mm_shuffle_epi32(abcd, 0x1B);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state.data()), abcd);
+    state[4] = static_cast<u32>(_mm_extract_epi32(e0, 3));
+  }
+
+#  undef RLL_SHA1_GROUP
+#elif defined(RLL_SHA1_ARM)
+#  define RLL_SHA1_GROUP(g, round, cur, n1, n2, n3)                         \
+    wk = vaddq_u32(cur, vdupq_n_u32(k[(g) / 5]));                           \
+    e_next = vsha1h_u32(vgetq_lane_u32(abcd, 0));                           \
+    abcd = round(abcd, e, wk);                                              \
+    e = e_next;                                                             \
+    if((g) < 16)                                                            \
+      cur = vsha1su1q_u32(vsha1su0q_u32(cur, n1, n2), n3);
+
+  void compress_armv8(state_type& state, u8 const* blocks, std::size_t count) {
+    constexpr u32 k[4] = {0x5a827999, 0x6ed9eba1, 0x8f1bbcdc, 0xca62c1d6};  // NOLINT
+    auto abcd = vld1q_u32(state.data());
+    auto e = state[4];
+    for(; count > 0; --count, blocks += sha1::block_size) {
+      auto const abcd_save = abcd;
+      auto const e_save = e;
+      auto m0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 0)));
+      auto m1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 16)));
+      auto m2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 32)));
+      auto m3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 48)));
+      auto wk = uint32x4_t();
+      auto e_next = u32();
+
+      RLL_SHA1_GROUP(0, vsha1cq_u32, m0, m1, m2, m3)
+      RLL_SHA1_GROUP(1, vsha1cq_u32, m1, m2, m3, m0)
+      RLL_SHA1_GROUP(2, vsha1cq_u32, m2, m3, m0, m1)
+      RLL_SHA1_GROUP(3, vsha1cq_u32, m3, m0, m1, m2)
+      RLL_SHA1_GROUP(4, vsha1cq_u32, m0, m1, m2, m3)
+      RLL_SHA1_GROUP(5, vsha1pq_u32, m1, m2, m3, m0)
+      RLL_SHA1_GROUP(6, vsha1pq_u32, m2, m3, m0, m1)
+      RLL_SHA1_GROUP(7, vsha1pq_u32, m3, m0, m1, m2)
+      RLL_SHA1_GROUP(8, vsha1pq_u32, m0, m1, m2, m3)
+      RLL_SHA1_GROUP(9, vsha1pq_u32, m1, m2, m3, m0)
+      RLL_SHA1_GROUP(10, vsha1mq_u32, m2, m3, m0, m1)
+      RLL_SHA1_GROUP(11, vsha1mq_u32, m3, m0, m1, m2)
+      RLL_SHA1_GROUP(12, vsha1mq_u32, m0, m1, m2, m3)
+      RLL_SHA1_GROUP(13, vsha1mq_u32, m1, m2, m3, m0)
+      RLL_SHA1_GROUP(14, vsha1mq_u32, m2, m3, m0, m1)
+      RLL_SHA1_GROUP(15, vsha1pq_u32, m3, m0, m1, m2)
+      RLL_SHA1_GROUP(16, vsha1pq_u32, m0, m1, m2, m3)
+      RLL_SHA1_GROUP(17, vsha1pq_u32, m1, m2, m3, m0)
+      RLL_SHA1_GROUP(18, vsha1pq_u32, m2, m3, m0, m1)
+      RLL_SHA1_GROUP(19, vsha1pq_u32, m3, m0, m1, m2)
+
+      abcd = vaddq_u32(abcd, abcd_save);
+      e += e_save;
+    }
+    vst1q_u32(state.data(), abcd);
+    state[4] = e;
+  }
+
+#  undef RLL_SHA1_GROUP
+#endif
+  // NOLINTEND(*-macro-usage, *-pro-type-reinterpret-cast, *-pro-bounds-pointer-arithmetic)
+
+  compress_fn select_compress() noexcept {
+    auto const& cpu = oslayer::cpu();
+#if defined(RLL_SHA1_X86)
+    if(cpu.sha and cpu.sse41 and cpu.ssse3)
+      return compress_shani;
+#elif defined(RLL_SHA1_ARM)
+    if(cpu.arm_sha1)
+      return compress_armv8;
+#endif
+    static_cast<void>(cpu);
+    return compress_portable;
+  }
+
+  compress_fn active_compress() noexcept {
+    static auto const fn = select_compress();
+    return fn;
+  }
+}  // namespace
+
+namespace rll::crypto {
+  void sha1_engine::compress(state_type& state, u8 const* blocks, std::size_t count) noexcept {
+    active_compress()(state, blocks, count);
+  }
+
+  sha1_engine::digest_type sha1_engine::hash() const noexcept {
+    auto state = this->state_;
+    detail::finish(state, this->buffer_, detail::length_order::big_endian, active_compress());
+
+    auto digest = digest_type();
+    for(auto i = std::size_t(0); i < state.size(); i++)
+      detail::store_be32(digest.data() + 4 * i, state[i]);
+    return digest;
+  }
+
+  basic_hasher& sha1::append(std::string const& str) {
+    return this->append(str.c_str(), str.size());
+  }
+
+  basic_hasher& sha1::append(std::string_view const str) {
+    return this->append(str.data(), str.size());
+  }
+
+  basic_hasher& sha1::append(void const* str, std::size_t len) {
+    this->engine_.append(str, len);
+    return *this;
+  }
+
+  void sha1::reset() { this->engine_.reset(); }
+
+  std::string sha1::hash_string() const {
+    auto const hash = this->hash();
+    return detail::to_hex(hash.data(), hash.size());
+  }
+
+  sha1::digest_type sha1::hash() const { return this->engine_.hash(); }
+
+  bool sha1::accelerated() noexcept { return active_compress() != compress_portable; }
+}  // namespace rll::crypto
@@ -0,0 +1,259 @@
+#include <rll/crypto/sha256.h>
+
+#include "crypto/common.h"
+#include "oslayer/cpu.h"
+
+#if defined(RLL_ARCH_X86_64) || defined(RLL_ARCH_X86_32)
+#  include <immintrin.h>
+#  define RLL_SHA256_X86
+#elif (defined(__aarch64__) || defined(_M_ARM64)) \
+  && (defined(__ARM_FEATURE_SHA2) || defined(__ARM_FEATURE_CRYPTO))
+#  include <arm_neon.h>
+#  define RLL_SHA256_ARM
+#endif
+
+namespace {
+  using namespace rll;
+  using crypto::sha256;
+  using state_type = crypto::sha256_engine::state_type;
+  using compress_fn = void (*)(state_type&, u8 const*, std::size_t);
+
+  alignas(16) constexpr u32 k[64] = {  // NOLINT(*-avoid-c-arrays)
+    0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+    0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+    0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+    0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+    0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+    0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+    0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+    0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+  };
+
+  void compress_portable(state_type& state, u8 const* blocks, std::size_t count) {
+    using crypto::detail::rotr;
+    auto w = std::array<u32, 64>();
+    for(; count > 0; --count, blocks += sha256::block_size) {
+      for(auto i = 0; i < 16; ++i)
+        w[i] = crypto::detail::load_be32(blocks + 4 * i);
+      for(auto i = 16; i < 64; ++i) {
+        auto const s0 = rotr(w[i - 15], 7) ^ rotr(w[i - 15], 18) ^ (w[i - 15] >> 3);
+        auto const s1 = rotr(w[i - 2], 17) ^ rotr(w[i - 2], 19) ^ (w[i - 2] >> 10);
+        w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+      }
+
+      auto a = state[0];
+      auto b = state[1];
+      auto c = state[2];
+      auto d = state[3];
+      auto e = state[4];
+      auto f = state[5];
+      auto g = state[6];
+      auto h = state[7];
+      for(auto i = 0; i < 64; ++i) {
+        auto const s1 = rotr(e, 6) ^ rotr(e, 11) ^ rotr(e, 25);
+        auto const ch = (e & f) ^ (~e & g);
+        auto const t1 = h + s1 + ch + k[i] + w[i];
+        auto const s0 = rotr(a, 2) ^ rotr(a, 13) ^ rotr(a, 22);
+        auto const maj = (a & b) ^ (a & c) ^ (b & c);
+        auto const t2 = s0 + maj;
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+      }
+      state[0] += a;
+      state[1] += b;
+      state[2] += c;
+      state[3] += d;
+      state[4] += e;
+      state[5] += f;
+      state[6] += g;
+      state[7] += h;
+    }
+  }
+
+  // NOLINTBEGIN(*-macro-usage, *-pro-type-reinterpret-cast, *-pro-bounds-pointer-arithmetic)
+#if defined(RLL_SHA256_X86)
+  // four rounds per group; groups 1..12 prepare and groups 3..14 finish the message schedule
+#  define RLL_SHA256_GROUP(g, cur, next, prev)                        \
+    msg = _mm_add_epi32(cur, _mm_load_si128(kv + (g)));             \
+    state1 = _mm_sha256rnds2_epu32(state1, state0, msg);            \
+    if((g) >= 3 and (g) <= 14) {                                    \
+      next = _mm_add_epi32(next, _mm_alignr_epi8(cur, prev, 4));    \
+      next = _mm_sha256msg2_epu32(next, cur);                       \
+    }                                                               \
+    msg = _mm_shuffle_epi32(msg, 0x0E);                             \
+    state0 = _mm_sha256rnds2_epu32(state0, state1, msg);            \
+    if((g) >= 1 and (g) <= 12)                                      \
+      prev = _mm_sha256msg1_epu32(prev, cur);
+
+  ___target___("sha,sse4.1,ssse3") void compress_shani(
+    state_type& state,
+    u8 const* blocks,
+    std::size_t count
+  ) {
+    auto const* kv = reinterpret_cast<__m128i const*>(k);
+    auto const mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // state is kept as abef/cdgh for sha256rnds2
+    auto tmp = _mm_loadu_si128(reinterpret_cast<__m128i const*>(state.data()));
+    auto state1 = _mm_loadu_si128(reinterpret_cast<__m128i const*>(state.data() + 4));
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);
+    state1 = _mm_shuffle_epi32(state1, 0x1B);
+    auto state0 = _mm_alignr_epi8(tmp, state1, 8);
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);
+
+    for(; count > 0; --count, blocks += sha256::block_size) {
+      auto const abef = state0;
+      auto const cdgh = state1;
+      auto const* in = reinterpret_cast<__m128i const*>(blocks);
+      auto m0 = _mm_shuffle_epi8(_mm_loadu_si128(in + 0), mask);
+      auto m1 = _mm_shuffle_epi8(_mm_loadu_si128(in + 1), mask);
+      auto m2 = _mm_shuffle_epi8(_mm_loadu_si128(in + 2), mask);
+      auto m3 = _mm_shuffle_epi8(_mm_loadu_si128(in + 3), mask);
+      auto msg = __m128i();
+
+      RLL_SHA256_GROUP(0, m0, m1, m3)
+      RLL_SHA256_GROUP(1, m1, m2, m0)
+      RLL_SHA256_GROUP(2, m2, m3, m1)
+      RLL_SHA256_GROUP(3, m3, m0, m2)
+      RLL_SHA256_GROUP(4, m0, m1, m3)
+      RLL_SHA256_GROUP(5, m1, m2, m0)
+      RLL_SHA256_GROUP(6, m2, m3, m1)
+      RLL_SHA256_GROUP(7, m3, m0, m2)
+      RLL_SHA256_GROUP(8, m0, m1, m3)
+      RLL_SHA256_GROUP(9, m1, m2, m0)
+      RLL_SHA256_GROUP(10, m2, m3, m1)
+      RLL_SHA256_GROUP(11, m3, m0, m2)
+      RLL_SHA256_GROUP(12, m0, m1, m3)
+      RLL_SHA256_GROUP(13, m1, m2, m0)
+      RLL_SHA256_GROUP(14, m2, m3, m1)
+      RLL_SHA256_GROUP(15, m3, m0, m2)
+
+      state0 = _mm_add_epi32(state0, abef);
+      state1 = _mm_add_epi32(state1, cdgh);
+    }
+
+    tmp = _mm_shuffle_epi32(state0, 0x1B);
+    state1 = _mm_shuffle_epi32(state1, 0xB1);
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);
+    state1 = _mm_alignr_epi8(state1, tmp, 8);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state.data()), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(state.data() + 4), state1);
+  }
+
+#  undef RLL_SHA256_GROUP
+#elif defined(RLL_SHA256_ARM)
+#  define RLL_SHA256_GROUP(g, cur, n1, n2, n3)                   \
+    wk = vaddq_u32(cur, vld1q_u32(k + 4 * (g)));                 \
+    if((g) < 12)                                                 \
+      cur = vsha256su0q_u32(cur, n1);                            \
+    tmp = state0;                                                \
+    state0 = vsha256hq_u32(state0, state1, wk);                  \
+    state1 = vsha256h2q_u32(state1, tmp, wk);                    \
+    if((g) < 12)                                                 \
+      cur = vsha256su1q_u32(cur, n2, n3);
+
+  void compress_armv8(state_type& state, u8 const* blocks, std::size_t count) {
+    auto state0 = vld1q_u32(state.data());
+    auto state1 = vld1q_u32(state.data() + 4);
+    for(; count > 0; --count, blocks += sha256::block_size) {
+      auto const abcd = state0;
+      auto const efgh = state1;
+      auto m0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 0)));
+      auto m1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 16)));
+      auto m2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 32)));
+      auto m3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(blocks + 48)));
+      auto wk = uint32x4_t();
+      auto tmp = uint32x4_t();
+
+      RLL_SHA256_GROUP(0, m0, m1, m2, m3)
+      RLL_SHA256_GROUP(1, m1, m2, m3, m0)
+      RLL_SHA256_GROUP(2, m2, m3, m0, m1)
+      RLL_SHA256_GROUP(3, m3, m0, m1, m2)
+      RLL_SHA256_GROUP(4, m0, m1, m2, m3)
+      RLL_SHA256_GROUP(5, m1, m2, m3, m0)
+      RLL_SHA256_GROUP(6, m2, m3, m0, m1)
+      RLL_SHA256_GROUP(7, m3, m0, m1, m2)
+      RLL_SHA256_GROUP(8, m0, m1, m2, m3)
+      RLL_SHA256_GROUP(9, m1, m2, m3, m0)
+      RLL_SHA256_GROUP(10, m2, m3, m0, m1)
+      RLL_SHA256_GROUP(11, m3, m0, m1, m2)
+      RLL_SHA256_GROUP(12, m0, m1, m2, m3)
+      RLL_SHA256_GROUP(13, m1, m2, m3, m0)
+      RLL_SHA256_GROUP(14, m2, m3, m0, m1)
+      RLL_SHA256_GROUP(15, m3, m0, m1, m2)
+
+      state0 = vaddq_u32(state0, abcd);
+      state1 = vaddq_u32(state1, efgh);
+    }
+    vst1q_u32(state.data(), state0);
+    vst1q_u32(state.data() + 4, state1);
+  }
+
+#  undef RLL_SHA256_GROUP
+#endif
+  // NOLINTEND(*-macro-usage, *-pro-type-reinterpret-cast, *-pro-bounds-pointer-arithmetic)
+
+  compress_fn select_compress() noexcept {
+    auto const& cpu = oslayer::cpu();
+#if defined(RLL_SHA256_X86)
+    if(cpu.sha and cpu.sse41 and cpu.ssse3)
+      return compress_shani;
+#elif defined(RLL_SHA256_ARM)
+    if(cpu.arm_sha2)
+      return compress_armv8;
+#endif
+    static_cast<void>(cpu);
+    return compress_portable;
+  }
+
+  compress_fn active_compress() noexcept {
+    static auto const fn = select_compress();
+    return fn;
+  }
+}  // namespace
+
+namespace rll::crypto {
+  void sha256_engine::compress(state_type& state, u8 const* blocks, std::size_t count) noexcept {
+    active_compress()(state, blocks, count);
+  }
+
+  sha256_engine::digest_type sha256_engine::hash() const noexcept {
+    auto state = this->state_;
+    detail::finish(state, this->buffer_, detail::length_order::big_endian, active_compress());
+
+    auto digest = digest_type();
+    for(auto i = std::size_t(0); i < state.size(); i++)
+      detail::store_be32(digest.data() + 4 * i, state[i]);
+    return digest;
+  }
+
+  basic_hasher& sha256::append(std::string const& str) {
+    return this->append(str.c_str(), str.size());
+  }
+
+  basic_hasher& sha256::append(std::string_view const str) {
+    return this->append(str.data(), str.size());
+  }
+
+  basic_hasher& sha256::append(void const* str, std::size_t len) {
+    this->engine_.append(str, len);
+    return *this;
+  }
+
+  void sha256::reset() { this->engine_.reset(); }
+
+  std::string sha256::hash_string() const {
+    auto const hash = this->hash();
+    return detail::to_hex(hash.data(), hash.size());
+  }
+
+  sha256::digest_type sha256::hash() const { return this->engine_.hash(); }
+
+  bool sha256::accelerated() noexcept { return active_compress() != compress_portable; }
+}  // namespace rll::crypto
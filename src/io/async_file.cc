@@ -0,0 +1,713 @@
+#include <rll/io/async_file.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <rll/global/platform_definitions.h>
+#include <rll/io/filedevice.h>
+#include "oslayer/file_handle.h"
+
+#ifndef RLL_OS_WINDOWS
+#  include <cerrno>
+#  include <fcntl.h>
+#endif
+
+#if defined(RLL_OS_LINUX) && __has_include(<linux/io_uring.h>)
+#  include <linux/io_uring.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <sys/uio.h>
+#  if defined(__NR_io_uring_setup)
+#    define RLL_IO_URING
+#  endif
+#endif
+
+namespace {
+  using namespace rll;
+  using namespace rll::io;
+  using oslayer::file_handle;
+
+  /// Set on the threads that run completion callbacks. Submitting from them never waits for a
+  /// free slot, since only they can free one.
+  thread_local auto on_completion_thread = false;
+
+  /// One submitted operation and its progress.
+  struct task {
+    async_file::operation op;
+    std::size_t transferred = 0;
+#if defined(RLL_IO_URING)
+    iovec vec = {};
+#endif
+
+    [[nodiscard]] bool writes() const noexcept {
+      return this->op.type == async_file::operation::kind::write;
+    }
+
+    [[nodiscard]] char* cursor() const noexcept {
+      return static_cast<char*>(this->op.data) + this->transferred;  // NOLINT(*-pointer-arithmetic)
+    }
+
+    [[nodiscard]] std::size_t remaining() const noexcept {
+      return this->op.size - this->transferred;
+    }
+
+    [[nodiscard]] u64 position() const noexcept { return this->op.offset + this->transferred; }
+
+    [[nodiscard]] unexpected<std::string> failure(std::string_view const reason) const {
+      return error(
+        "failed to {} {} bytes at offset {}: {}",
+        this->writes() ? "write" : "read",
+        this->op.size,
+        this->op.offset,
+        reason
+      );
+    }
+  };
+
+#if defined(RLL_OS_WINDOWS)
+  [[nodiscard]] result<file_handle> open_file(std::filesystem::path const& path, open_mode mode) {
+    auto const access = mode == open_mode::read  ? GENERIC_READ
+                      : mode == open_mode::write ? GENERIC_WRITE
+                                                 : GENERIC_READ | GENERIC_WRITE;
+    auto* const native = ::CreateFileW(
+      path.c_str(),
+      static_cast<DWORD>(access),
+      FILE_SHARE_READ | FILE_SHARE_WRITE,
+      nullptr,
+      mode == open_mode::read ? OPEN_EXISTING : OPEN_ALWAYS,
+      FILE_ATTRIBUTE_NORMAL,
+      nullptr
+    );
+    if(native == INVALID_HANDLE_VALUE)  // NOLINT(*-pro-type-cstyle-cast)
+      return error("failed to open \'{}\': {}", path.generic_string(), oslayer::last_error());
+    return file_handle(native);
+  }
+#else
+  [[nodiscard]] result<file_handle> open_file(std::filesystem::path const& path, open_mode mode) {
+    auto const flags = mode == open_mode::read  ? O_RDONLY
+                     : mode == open_mode::write ? O_WRONLY | O_CREAT
+                                                : O_RDWR | O_CREAT;
+    auto const permissions = static_cast<mode_t>(filedevice::write_permissions);
+    auto const native = ::open(path.c_str(), flags | O_CLOEXEC, permissions);  // NOLINT(*-vararg)
+    if(native < 0)
+      return error("failed to open \'{}\': {}", path.generic_string(), oslayer::last_error());
+    return file_handle(native);
+  }
+#endif
+
+  /// Performs @p t synchronously, in chunks, until it is done or a read reaches the end.
+  [[nodiscard]] result<std::size_t> transfer(file_handle const& file, task& t) {
+    while(t.remaining() > 0) {
+      auto const done = t.writes()
+                        ? oslayer::write_at(file.native(), t.cursor(), t.remaining(), t.position())
+                        : oslayer::read_at(file.native(), t.cursor(), t.remaining(), t.position());
+      if(done < 0)
+        return t.failure(oslayer::last_error());
+      if(done == 0)
+        break;
+      t.transferred += static_cast<std::size_t>(done);
+    }
+    return t.transferred;
+  }
+
+  /**
+   * Common part of the backends: the file and the accounting of operations in flight, which
+   * bounds the queue and lets @ref drain wait for it to empty.
+   */
+  class engine {
+   public:
+    engine(file_handle file, u32 const depth)
+      : file_(std::move(file))
+      , depth_(depth) {}
+
+    engine(engine const&) = delete;
+    engine& operator=(engine const&) = delete;
+    virtual ~engine() = default;
+
+    [[nodiscard]] virtual async_backend backend() const noexcept = 0;
+
+    /// Takes ownership of all @p count tasks.
+    virtual void submit(std::unique_ptr<task>* tasks, std::size_t count) = 0;
+
+    [[nodiscard]] virtual result<> register_buffers(std::vector<async_file::buffer> const&) {
+      return ok();
+    }
+
+    virtual void unregister_buffers() noexcept {}
+
+    [[nodiscard]] file_handle const& file() const noexcept { return this->file_; }
+
+    void drain() noexcept {
+      auto lock = std::unique_lock(this->mutex_);
+      this->changed_.wait(lock, [this] { return this->in_flight_ == 0; });
+    }
+
+   protected:
+    /// Whether a submitter has to wait for a slot. Called with the mutex held.
+    [[nodiscard]] bool full() const noexcept {
+      return this->in_flight_ >= this->depth_ and not on_completion_thread;
+    }
+
+    /// Waits for and takes a slot. Called with the mutex held.
+    void acquire(std::unique_lock<std::mutex>& lock) {
+      this->changed_.wait(lock, [this] { return not this->full(); });
+      ++this->in_flight_;
+    }
+
+    /// Runs the callback of @p t and releases its slot. Called without the mutex held.
+    void complete(std::unique_ptr<task> t, result<std::size_t> res) noexcept {
+      if(t->op.done)
+        t->op.done(std::move(res));
+      t.reset();
+      {
+        auto const lock = std::lock_guard(this->mutex_);
+        --this->in_flight_;
+      }
+      this->changed_.notify_all();
+    }
+
+    file_handle file_;
+    u32 depth_;
+    u32 in_flight_ = 0;
+    std::mutex mutex_;
+    std::condition_variable changed_;
+  };
+
+  class pool_engine final : public engine {
+   public:
+    pool_engine(file_handle file, u32 const depth, u32 const threads)
+      : engine(std::move(file), depth) {
+      for(auto i = 0U; i < std::max(threads, 1U); ++i)
+        this->workers_.emplace_back([this] { this->run(); });
+    }
+
+    ~pool_engine() override {
+      this->drain();
+      {
+        auto const lock = std::lock_guard(this->mutex_);
+        this->stopping_ = true;
+      }
+      this->ready_.notify_all();
+      for(auto& worker : this->workers_)
+        worker.join();
+    }
+
+    [[nodiscard]] async_backend backend() const noexcept override {
+      return async_backend::thread_pool;
+    }
+
+    void submit(std::unique_ptr<task>* const tasks, std::size_t const count) override {
+      auto lock = std::unique_lock(this->mutex_);
+      for(auto i = std::size_t(0); i < count; ++i) {
+        this->acquire(lock);
+        this->queue_.push_back(std::move(tasks[i]));  // NOLINT(*-pointer-arithmetic)
+        this->ready_.notify_one();
+      }
+    }
+
+   private:
+    void run() {
+      on_completion_thread = true;
+      auto lock = std::unique_lock(this->mutex_);
+      while(true) {
+        this->ready_.wait(lock, [this] { return this->stopping_ or not this->queue_.empty(); });
+        if(this->queue_.empty())
+          return;
+        auto t = std::move(this->queue_.front());
+        this->queue_.pop_front();
+        lock.unlock();
+        auto res = transfer(this->file_, *t);
+        this->complete(std::move(t), std::move(res));
+        lock.lock();
+      }
+    }
+
+    std::deque<std::unique_ptr<task>> queue_;
+    std::condition_variable ready_;
+    bool stopping_ = false;
+    std::vector<std::thread> workers_;
+  };
+
+#if defined(RLL_IO_URING)
+  [[nodiscard]] int uring_setup(u32 const entries, io_uring_params* params) noexcept {
+    return static_cast<int>(::syscall(__NR_io_uring_setup, entries, params));
+  }
+
+  [[nodiscard]] int uring_enter(int const ring, u32 const submit, u32 const wait, u32 const flags) {
+    return static_cast<int>(::syscall(__NR_io_uring_enter, ring, submit, wait, flags, nullptr, 0));
+  }
+
+  [[nodiscard]] int
+    uring_register(int const ring, u32 const opcode, void const* args, u32 const count) noexcept {
+    return static_cast<int>(::syscall(__NR_io_uring_register, ring, opcode, args, count));
+  }
+
+  template <typename T>
+  [[nodiscard]] T* at_offset(void* base, u32 const offset) noexcept {
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);  // NOLINT
+  }
+
+  /// Kernel submission and completion queues shared through memory mappings.
+  struct ring {
+    int fd = -1;
+    void* queues = MAP_FAILED;  // NOLINT(*-pro-type-cstyle-cast)
+    std::size_t queues_size = 0;
+    void* completions = MAP_FAILED;  // NOLINT(*-pro-type-cstyle-cast)
+    std::size_t completions_size = 0;
+    io_uring_sqe* sqes = static_cast<io_uring_sqe*>(MAP_FAILED);  // NOLINT
+    std::size_t sqes_size = 0;
+
+    u32* sq_head = nullptr;
+    u32* sq_tail = nullptr;
+    u32 sq_mask = 0;
+    u32 sq_entries = 0;
+    u32* cq_head = nullptr;
+    u32* cq_tail = nullptr;
+    u32 cq_mask = 0;
+    io_uring_cqe* cqes = nullptr;
+
+    ring() = default;
+    ring(ring const&) = delete;
+    ring& operator=(ring const&) = delete;
+
+    ~ring() {
+      if(this->sqes != MAP_FAILED)  // NOLINT(*-pro-type-cstyle-cast)
+        ::munmap(this->sqes, this->sqes_size);
+      if(this->completions != MAP_FAILED and this->completions != this->queues)  // NOLINT
+        ::munmap(this->completions, this->completions_size);
+      if(this->queues != MAP_FAILED)  // NOLINT(*-pro-type-cstyle-cast)
+        ::munmap(this->queues, this->queues_size);
+      if(this->fd >= 0)
+        ::close(this->fd);
+    }
+
+    [[nodiscard]] static std::unique_ptr<ring> setup(u32 const entries) {
+      auto r = std::make_unique<ring>();
+      auto params = io_uring_params();
+      r->fd = uring_setup(entries, &params);
+      if(r->fd < 0)
+        return nullptr;
+
+      auto const map = [&](std::size_t const size, off_t const offset) {
+        auto constexpr protection = PROT_READ | PROT_WRITE;
+        return ::mmap(nullptr, size, protection, MAP_SHARED | MAP_POPULATE, r->fd, offset);
+      };
+      r->queues_size = params.sq_off.array + params.sq_entries * sizeof(u32);
+      r->completions_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+      if(params.features & IORING_FEAT_SINGLE_MMAP) {
+        r->queues_size = std::max(r->queues_size, r->completions_size);
+        r->queues = map(r->queues_size, IORING_OFF_SQ_RING);
+        r->completions = r->queues;
+      } else {
+        r->queues = map(r->queues_size, IORING_OFF_SQ_RING);
+        r->completions = map(r->completions_size, IORING_OFF_CQ_RING);
+      }
+      r->sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+      r->sqes = static_cast<io_uring_sqe*>(map(r->sqes_size, IORING_OFF_SQES));
+      if(r->queues == MAP_FAILED or r->completions == MAP_FAILED  // NOLINT
+         or r->sqes == MAP_FAILED)                                // NOLINT
+        return nullptr;
+
+      r->sq_head = at_offset<u32>(r->queues, params.sq_off.head);
+      r->sq_tail = at_offset<u32>(r->queues, params.sq_off.tail);
+      r->sq_mask = *at_offset<u32>(r->queues, params.sq_off.ring_mask);
+      r->sq_entries = params.sq_entries;
+      r->cq_head = at_offset<u32>(r->completions, params.cq_off.head);
+      r->cq_tail = at_offset<u32>(r->completions, params.cq_off.tail);
+      r->cq_mask = *at_offset<u32>(r->completions, params.cq_off.ring_mask);
+      r->cqes = at_offset<io_uring_cqe>(r->completions, params.cq_off.cqes);
+
+      // slot i of the indirection array always names sqe i
+      auto* const array = at_offset<u32>(r->queues, params.sq_off.array);
+      for(auto i = 0U; i < params.sq_entries; ++i)
+        array[i] = i;  // NOLINT(*-pointer-arithmetic)
+      return r;
+    }
+
+    /// Submission queue entries written but not yet consumed by the kernel.
+    [[nodiscard]] u32 unsubmitted() const noexcept {
+      return *this->sq_tail - __atomic_load_n(this->sq_head, __ATOMIC_ACQUIRE);
+    }
+  };
+
+  class uring_engine final : public engine {
+   public:
+    /// Returns nothing if io_uring is unavailable, leaving @p file untouched.
+    [[nodiscard]] static std::unique_ptr<engine> create(file_handle& file, u32 const depth) {
+      // completion callbacks may submit past the depth, so leave them room in the queue
+      auto r = ring::setup(depth * 2);
+      if(not r)
+        return nullptr;
+      return std::unique_ptr<engine>(new uring_engine(std::move(file), depth, std::move(r)));
+    }
+
+    ~uring_engine() override {
+      this->drain();
+      {
+        // a no-op with empty user data tells the reaper to stop
+        auto lock = std::unique_lock(this->mutex_);
+        std::memset(this->next_sqe(lock), 0, sizeof(io_uring_sqe));
+        this->publish();
+        this->flush(lock);
+      }
+      this->reaper_.join();
+    }
+
+    [[nodiscard]] async_backend backend() const noexcept override {
+      return async_backend::io_uring;
+    }
+
+    void submit(std::unique_ptr<task>* const tasks, std::size_t const count) override {
+      auto lock = std::unique_lock(this->mutex_);
+      for(auto i = std::size_t(0); i < count; ++i) {
+        if(this->full())
+          this->flush(lock);
+        this->acquire(lock);
+        this->push(lock, tasks[i].release());  // NOLINT(*-pointer-arithmetic)
+      }
+      this->flush(lock);
+    }
+
+    [[nodiscard]] result<> register_buffers(std::vector<async_file::buffer> const& buffers
+    ) override {
+      auto vecs = std::vector<iovec>();
+      vecs.reserve(buffers.size());
+      for(auto const& b : buffers)
+        vecs.push_back({b.data, b.size});
+      this->drain();
+      auto const lock = std::lock_guard(this->mutex_);
+      this->unregister_locked();
+      if(vecs.empty())
+        return ok();
+      auto const res = uring_register(
+        this->ring_->fd,
+        IORING_REGISTER_BUFFERS,
+        vecs.data(),
+        static_cast<u32>(vecs.size())
+      );
+      if(res < 0)
+        return error("failed to register io_uring buffers: {}", oslayer::last_error());
+      this->buffers_ = std::move(vecs);
+      return ok();
+    }
+
+    void unregister_buffers() noexcept override {
+      this->drain();
+      auto const lock = std::lock_guard(this->mutex_);
+      this->unregister_locked();
+    }
+
+   private:
+    uring_engine(file_handle file, u32 const depth, std::unique_ptr<ring> r)
+      : engine(std::move(file), depth)
+      , ring_(std::move(r)) {
+      auto const fd = this->file_.native();
+      this->fixed_file_ = uring_register(this->ring_->fd, IORING_REGISTER_FILES, &fd, 1) == 0;
+      this->reaper_ = std::thread([this] { this->run(); });
+    }
+
+    void unregister_locked() noexcept {
+      if(this->buffers_.empty())
+        return;
+      static_cast<void>(uring_register(this->ring_->fd, IORING_UNREGISTER_BUFFERS, nullptr, 0));
+      this->buffers_.clear();
+    }
+
+    [[nodiscard]] bool queue_full() const noexcept {
+      return this->ring_->unsubmitted() == this->ring_->sq_entries;
+    }
+
+    /**
+     * Returns a free submission queue entry, submitting first if the queue is full. Only for
+     * threads other than the reaper, which is the one that frees entries when the kernel is
+     * out of resources.
+     */
+    [[nodiscard]] io_uring_sqe* next_sqe(std::unique_lock<std::mutex>& lock) {
+      while(this->queue_full())
+        this->flush(lock);
+      return &this->ring_->sqes[*this->ring_->sq_tail & this->ring_->sq_mask];  // NOLINT
+    }
+
+    void publish() noexcept {
+      __atomic_store_n(this->ring_->sq_tail, *this->ring_->sq_tail + 1, __ATOMIC_RELEASE);
+    }
+
+    /**
+     * Queues the rest of @p t. Called with the mutex held. On the completion thread, a queue
+     * that stays full after one submission attempt defers @p t to the next round of the reaper
+     * instead of waiting for space that only the reaper can free.
+     */
+    void push(std::unique_lock<std::mutex>& lock, task* t) {
+      if(on_completion_thread) {
+        if(this->deferred_.empty() and this->queue_full())
+          this->flush(lock);
+        if(not this->deferred_.empty() or this->queue_full()) {
+          this->deferred_.push_back(t);
+          return;
+        }
+      }
+      this->fill(this->next_sqe(lock), t);
+    }
+
+    /// Moves deferred tasks into the queue while it has room. Called with the mutex held.
+    void push_deferred() {
+      while(not this->deferred_.empty() and not this->queue_full()) {
+        auto* const t = this->deferred_.front();
+        this->deferred_.pop_front();
+        this->fill(&this->ring_->sqes[*this->ring_->sq_tail & this->ring_->sq_mask], t);  // NOLINT
+      }
+    }
+
+    /// Describes the next chunk of @p t in @p sqe and publishes it.
+    void fill(io_uring_sqe* const sqe, task* t) noexcept {
+      std::memset(sqe, 0, sizeof(io_uring_sqe));
+      auto const size = static_cast<u32>(std::min(t->remaining(), oslayer::max_transfer));
+      auto const fixed = std::find_if(this->buffers_.begin(), this->buffers_.end(), [&](auto& b) {
+        auto const* const base = static_cast<char const*>(b.iov_base);
+        return t->cursor() >= base
+           and t->cursor() + size <= base + b.iov_len;  // NOLINT(*-pointer-arithmetic)
+      });
+      if(fixed != this->buffers_.end()) {
+        sqe->opcode = t->writes() ? IORING_OP_WRITE_FIXED : IORING_OP_READ_FIXED;
+        sqe->addr = reinterpret_cast<u64>(t->cursor());  // NOLINT(*-reinterpret-cast)
+        sqe->len = size;
+        sqe->buf_index = static_cast<u16>(fixed - this->buffers_.begin());
+      } else {
+        sqe->opcode = t->writes() ? IORING_OP_WRITEV : IORING_OP_READV;
+        t->vec = {t->cursor(), size};
+        sqe->addr = reinterpret_cast<u64>(&t->vec);  // NOLINT(*-reinterpret-cast)
+        sqe->len = 1;
+      }
+      sqe->fd = this->fixed_file_ ? 0 : this->file_.native();
+      sqe->flags = this->fixed_file_ ? IOSQE_FIXED_FILE : 0;
+      sqe->off = t->position();
+      sqe->user_data = reinterpret_cast<u64>(t);  // NOLINT(*-reinterpret-cast)
+      this->publish();
+    }
+
+    /**
+     * Hands the queued entries to the kernel. Called with the mutex held. When the kernel is
+     * out of resources, submitters retry; the reaper leaves the entries for its next round,
+     * since it is the one that has to free them. Entries the kernel rejects outright are failed.
+     */
+    void flush(std::unique_lock<std::mutex>& lock) {
+      while(auto const pending = this->ring_->unsubmitted()) {
+        if(uring_enter(this->ring_->fd, pending, 0, 0) >= 0 or errno == EINTR)
+          continue;
+        if(errno == EAGAIN or errno == EBUSY) {
+          if(on_completion_thread)
+            return;
+          lock.unlock();
+          std::this_thread::yield();
+          lock.lock();
+          continue;
+        }
+
+        auto const reason = oslayer::last_error();
+        auto rejected = std::vector<std::unique_ptr<task>>();
+        auto const head = __atomic_load_n(this->ring_->sq_head, __ATOMIC_ACQUIRE);
+        for(auto i = head; i != *this->ring_->sq_tail; ++i) {
+          auto const data = this->ring_->sqes[i & this->ring_->sq_mask].user_data;  // NOLINT
+          if(data != 0)
+            rejected.emplace_back(reinterpret_cast<task*>(data));  // NOLINT(*-reinterpret-cast)
+        }
+        __atomic_store_n(this->ring_->sq_tail, head, __ATOMIC_RELEASE);
+        lock.unlock();
+        for(auto& t : rejected) {
+          auto res = t->failure(reason);
+          this->complete(std::move(t), std::move(res));
+        }
+        lock.lock();
+      }
+    }
+
+    void run() {
+      on_completion_thread = true;
+      auto retry = std::vector<task*>();
+      auto stopping = false;
+      while(not stopping) {
+        auto wait = 1U;
+        {
+          auto lock = std::unique_lock(this->mutex_);
+          this->flush(lock);
+          this->push_deferred();
+          this->flush(lock);
+          auto const queued = this->ring_->unsubmitted() + this->deferred_.size();
+          if(this->in_flight_ > 0 and queued >= this->in_flight_)
+            wait = 0;  // everything in flight is still queued, so nothing would complete
+        }
+        if(wait == 0)
+          std::this_thread::yield();
+        static_cast<void>(uring_enter(this->ring_->fd, 0, wait, IORING_ENTER_GETEVENTS));
+
+        auto head = *this->ring_->cq_head;
+        while(head != __atomic_load_n(this->ring_->cq_tail, __ATOMIC_ACQUIRE)) {
+          auto const cqe = this->ring_->cqes[head & this->ring_->cq_mask];  // NOLINT
+          __atomic_store_n(this->ring_->cq_head, ++head, __ATOMIC_RELEASE);
+          if(cqe.user_data == 0) {
+            stopping = true;
+            continue;
+          }
+          auto t = std::unique_ptr<task>(reinterpret_cast<task*>(cqe.user_data));  // NOLINT
+          if(cqe.res == -EINTR or cqe.res == -EAGAIN) {
+            retry.push_back(t.release());
+            continue;
+          }
+          if(cqe.res < 0) {
+            auto res = t->failure(std::strerror(-cqe.res));
+            this->complete(std::move(t), std::move(res));
+            continue;
+          }
+          t->transferred += static_cast<std::size_t>(cqe.res);
+          if(cqe.res == 0 or t->remaining() == 0) {
+            auto const transferred = t->transferred;
+            this->complete(std::move(t), transferred);
+            continue;
+          }
+          retry.push_back(t.release());  // short transfer
+        }
+
+        if(not retry.empty()) {
+          auto lock = std::unique_lock(this->mutex_);
+          for(auto* t : retry)
+            this->push(lock, t);
+          retry.clear();
+        }
+      }
+    }
+
+    std::unique_ptr<ring> ring_;
+    std::deque<task*> deferred_;  ///< Waiting for room in the submission queue, in order.
+    bool fixed_file_ = false;
+    std::vector<iovec> buffers_;
+    std::thread reaper_;
+  };
+#endif
+
+  [[nodiscard]] result<> submit_one(engine& backend, async_file::operation op) noexcept {
+    try {
+      auto t = std::make_unique<task>(task {std::move(op)});
+      backend.submit(&t, 1);
+      return ok();
+    } catch(std::exception const& ex) {
+      return error("failed to submit operation: {}", ex.what());
+    }
+  }
+
+  [[nodiscard]] std::future<result<std::size_t>>
+    with_future(async_file& file, async_file::operation op) {
+    auto promise = std::make_shared<std::promise<result<std::size_t>>>();
+    auto future = promise->get_future();
+    op.done = [promise](result<std::size_t> res) { promise->set_value(std::move(res)); };
+    auto batch = std::vector<async_file::operation>();
+    batch.push_back(std::move(op));
+    if(auto const res = file.submit(std::move(batch)); not res)
+      promise->set_value(unexpected(res.error()));
+    return future;
+  }
+}  // namespace
+
+namespace rll::io {
+  struct async_file::impl {
+    std::unique_ptr<engine> backend;
+  };
+
+  async_file::async_file(std::unique_ptr<impl> i) noexcept
+    : impl_(std::move(i)) {}
+
+  async_file::async_file(async_file&&) noexcept = default;
+
+  async_file& async_file::operator=(async_file&&) noexcept = default;
+
+  async_file::~async_file() = default;
+
+  result<async_file> async_file::open(
+    std::filesystem::path const& path,
+    open_mode const mode,
+    async_options const& options
+  ) noexcept {
+    try {
+      auto file = open_file(path, mode);
+      if(not file)
+        return unexpected(file.error());
+      auto const depth = std::clamp(options.queue_depth, 1U, 4'096U);
+      auto i = std::make_unique<impl>();
+#if defined(RLL_IO_URING)
+      if(options.io_uring)
+        i->backend = uring_engine::create(*file, depth);
+#endif
+      if(not i->backend)
+        i->backend = std::make_unique<pool_engine>(std::move(*file), depth, options.threads);
+      return async_file(std::move(i));
+    } catch(std::exception const& ex) {
+      return error("failed to open \'{}\': {}", path.generic_string(), ex.what());
+    }
+  }
+
+  async_backend async_file::backend() const noexcept { return this->impl_->backend->backend(); }
+
+  result<u64> async_file::size() const noexcept {
+    return oslayer::file_size(this->impl_->backend->file().native());
+  }
+
+  result<> async_file::submit(std::vector<operation> batch) noexcept {
+    try {
+      auto tasks = std::vector<std::unique_ptr<task>>();
+      tasks.reserve(batch.size());
+      for(auto& op : batch)
+        tasks.push_back(std::make_unique<task>(task {std::move(op)}));
+      this->impl_->backend->submit(tasks.data(), tasks.size());
+      return ok();
+    } catch(std::exception const& ex) {
+      return error("failed to submit {} operations: {}", batch.size(), ex.what());
+    }
+  }
+
+  result<> async_file::read(
+    u64 const offset,
+    void* buffer,
+    std::size_t const size,
+    completion done
+  ) noexcept {
+    auto op = operation::read(offset, buffer, size, std::move(done));
+    return submit_one(*this->impl_->backend, std::move(op));
+  }
+
+  result<> async_file::write(
+    u64 const offset,
+    void const* data,
+    std::size_t const size,
+    completion done
+  ) noexcept {
+    auto op = operation::write(offset, data, size, std::move(done));
+    return submit_one(*this->impl_->backend, std::move(op));
+  }
+
+  std::future<result<std::size_t>>
+    async_file::read(u64 const offset, void* buffer, std::size_t const size) {
+    return with_future(*this, operation::read(offset, buffer, size, {}));
+  }
+
+  std::future<result<std::size_t>>
+    async_file::write(u64 const offset, void const* data, std::size_t const size) {
+    return with_future(*this, operation::write(offset, data, size, {}));
+  }
+
+  result<> async_file::register_buffers(std::vector<buffer> const& buffers) noexcept {
+    try {
+      return this->impl_->backend->register_buffers(buffers);
+    } catch(std::exception const& ex) {
+      return error("failed to register buffers: {}", ex.what());
+    }
+  }
+
+  void async_file::unregister_buffers() noexcept { this->impl_->backend->unregister_buffers(); }
+
+  void async_file::drain() noexcept { this->impl_->backend->drain(); }
+}  // namespace rll::io
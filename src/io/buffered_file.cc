@@ -0,0 +1,409 @@
+#include <rll/io/buffered_file.h>
+
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <string>
+#include <utility>
+#include <rll/global/platform_definitions.h>
+#include <rll/io/filedevice.h>
+#include "oslayer/file_handle.h"
+
+#ifndef RLL_OS_WINDOWS
+#  include <fcntl.h>
+#endif
+
+namespace {
+  using namespace rll;
+  using namespace rll::io;
+  using oslayer::file_handle;
+  namespace fs = std::filesystem;
+
+  /// Smallest buffer, so that tiny sizes do not degrade into a system call per byte.
+  constexpr auto min_buffer_size = std::size_t(4'096);
+
+  /// Tells the kernel that [@p offset, @p offset + @p size) will not be needed again.
+  void drop_cached(file_handle const& file, u64 const offset, u64 const size) noexcept {
+#if defined(POSIX_FADV_DONTNEED)
+    static_cast<void>(::posix_fadvise(
+      file.native(),
+      static_cast<off_t>(offset),
+      static_cast<off_t>(size),
+      POSIX_FADV_DONTNEED
+    ));
+#else
+    static_cast<void>(file);
+    static_cast<void>(offset);
+    static_cast<void>(size);
+#endif
+  }
+}  // namespace
+
+namespace rll::io {
+  struct file_reader::impl {
+    std::string path;
+    oslayer::file_handle file;
+    std::unique_ptr<char[]> buffer;  // NOLINT(*-avoid-c-arrays)
+    std::size_t capacity = 0;
+    std::size_t begin = 0;    ///< First unconsumed byte of the buffer.
+    std::size_t end = 0;      ///< End of the valid bytes of the buffer.
+    std::size_t scanned = 0;  ///< The bytes before this index contain no newline after begin.
+    u64 offset = 0;           ///< File offset of buffer[end].
+    u64 dropped = 0;          ///< File offset up to which the page cache has been dropped.
+    bool drop_behind = false;
+
+    [[nodiscard]] u64 position() const noexcept {
+      return this->offset - (this->end - this->begin);
+    }
+
+    [[nodiscard]] char* at(std::size_t const index) const noexcept {
+      return this->buffer.get() + index;  // NOLINT(*-pointer-arithmetic)
+    }
+
+    [[nodiscard]] std::string_view take(std::size_t const size) noexcept {
+      auto const res = std::string_view(this->at(this->begin), size);
+      this->begin += size;
+      return res;
+    }
+
+    /// Reads more data after the buffered bytes. Returns the number of bytes read, 0 at the end.
+    [[nodiscard]] result<std::size_t> refill() {
+      if(this->begin > 0) {
+        auto const rest = this->end - this->begin;
+        std::memmove(this->at(0), this->at(this->begin), rest);
+        this->scanned -= std::min(this->scanned, this->begin);
+        this->begin = 0;
+        this->end = rest;
+      }
+      if(this->end == this->capacity)
+        this->grow();
+      auto const room = this->capacity - this->end;
+      auto const done =
+        oslayer::read_at(this->file.native(), this->at(this->end), room, this->offset);
+      if(done < 0)
+        return error("failed to read from \'{}\': {}", this->path, oslayer::last_error());
+      this->end += static_cast<std::size_t>(done);
+      this->advance(static_cast<u64>(done));
+      return static_cast<std::size_t>(done);
+    }
+
+    /// Accounts for @p size bytes read from the file.
+    void advance(u64 const size) noexcept {
+      this->offset += size;
+      if(this->drop_behind and this->position() - this->dropped >= this->capacity) {
+        drop_cached(this->file, this->dropped, this->position() - this->dropped);
+        this->dropped = this->position();
+      }
+    }
+
+    /// Doubles the buffer for a line that does not fit into it.
+    void grow() {
+      auto bigger = std::make_unique<char[]>(this->capacity * 2);  // NOLINT(*-avoid-c-arrays)
+      std::memcpy(bigger.get(), this->at(0), this->end);
+      this->buffer = std::move(bigger);
+      this->capacity *= 2;
+    }
+  };
+
+  file_reader::file_reader(std::unique_ptr<impl> i) noexcept
+    : impl_(std::move(i)) {}
+
+  file_reader::file_reader(file_reader&&) noexcept = default;
+
+  file_reader& file_reader::operator=(file_reader&&) noexcept = default;
+
+  file_reader::~file_reader() = default;
+
+  result<file_reader>
+    file_reader::open(std::filesystem::path const& path, stream_options const& options) noexcept {
+    try {
+#if defined(RLL_OS_WINDOWS)
+      auto file = oslayer::file_handle(::CreateFileW(
+        path.c_str(),
+        GENERIC_READ,
+        FILE_SHARE_READ | FILE_SHARE_WRITE,
+        nullptr,
+        OPEN_EXISTING,
+        FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr
+      ));
+#else
+      // NOLINTNEXTLINE(*-vararg)
+      auto file = oslayer::file_handle(::open(path.c_str(), O_RDONLY | O_CLOEXEC));
+#endif
+      if(not file.valid()) {
+        auto const reason = oslayer::last_error();
+        return error("failed to open \'{}\': {}", path.generic_string(), reason);
+      }
+#if defined(POSIX_FADV_SEQUENTIAL)
+      static_cast<void>(::posix_fadvise(file.native(), 0, 0, POSIX_FADV_SEQUENTIAL));
+#endif
+
+      auto i = std::make_unique<impl>();
+      i->path = path.generic_string();
+      i->file = std::move(file);
+      i->capacity = std::max(options.buffer_size, min_buffer_size);
+      i->buffer = std::make_unique<char[]>(i->capacity);  // NOLINT(*-avoid-c-arrays)
+      i->drop_behind = options.drop_behind;
+      return file_reader(std::move(i));
+    } catch(std::exception const& ex) {
+      return error("failed to open \'{}\': {}", path.generic_string(), ex.what());
+    }
+  }
+
+  result<std::size_t> file_reader::read_chunk(void* buffer, std::size_t const size) noexcept {
+    try {
+      auto& d = *this->impl_;
+      auto* const out = static_cast<char*>(buffer);
+      auto done = std::size_t(0);
+      while(done < size) {
+        if(d.begin == d.end and size - done >= d.capacity) {
+          // nothing to gain from copying through the buffer
+          auto const read =
+            oslayer::read_at(d.file.native(), out + done, size - done, d.offset);  // NOLINT
+          if(read < 0)
+            return error("failed to read from \'{}\': {}", d.path, oslayer::last_error());
+          if(read == 0)
+            break;
+          d.advance(static_cast<u64>(read));
+          done += static_cast<std::size_t>(read);
+          continue;
+        }
+        if(d.begin == d.end) {
+          auto const read = d.refill();
+          if(not read)
+            return unexpected(read.error());
+          if(*read == 0)
+            break;
+        }
+        auto const chunk = d.take(std::min(d.end - d.begin, size - done));
+        std::memcpy(out + done, chunk.data(), chunk.size());  // NOLINT(*-pointer-arithmetic)
+        done += chunk.size();
+      }
+      return done;
+    } catch(std::exception const& ex) {
+      return error("failed to read from \'{}\': {}", this->impl_->path, ex.what());
+    }
+  }
+
+  result<std::string_view> file_reader::next_chunk() noexcept {
+    try {
+      auto& d = *this->impl_;
+      if(d.begin == d.end)
+        if(auto const read = d.refill(); not read)
+          return unexpected(read.error());
+      return d.take(d.end - d.begin);
+    } catch(std::exception const& ex) {
+      return error("failed to read from \'{}\': {}", this->impl_->path, ex.what());
+    }
+  }
+
+  result<optional<std::string_view>> file_reader::next_line() noexcept {
+    try {
+      auto& d = *this->impl_;
+      while(true) {
+        auto const from = std::max(d.scanned, d.begin);
+        if(auto const* newline = static_cast<char*>(std::memchr(d.at(from), '\n', d.end - from))) {
+          auto const line = d.take(static_cast<std::size_t>(newline - d.at(d.begin)));
+          ++d.begin;
+          return line;
+        }
+        d.scanned = d.end;
+        auto const read = d.refill();
+        if(not read)
+          return unexpected(read.error());
+        if(*read > 0)
+          continue;
+        if(d.begin == d.end)
+          return optional<std::string_view>();
+        return d.take(d.end - d.begin);
+      }
+    } catch(std::exception const& ex) {
+      return error("failed to read from \'{}\': {}", this->impl_->path, ex.what());
+    }
+  }
+
+  u64 file_reader::position() const noexcept { return this->impl_->position(); }
+
+  result<> file_reader::seek(u64 const offset) noexcept {
+    auto& d = *this->impl_;
+    d.begin = d.end = d.scanned = 0;
+    d.offset = d.dropped = offset;
+    return ok();
+  }
+
+  result<u64> file_reader::size() const noexcept {
+    return oslayer::file_size(this->impl_->file.native());
+  }
+
+  struct file_writer::impl {
+    std::string path;
+    oslayer::file_handle file;
+    std::unique_ptr<char[]> buffer;  // NOLINT(*-avoid-c-arrays)
+    std::size_t capacity = 0;
+    std::size_t used = 0;
+    u64 offset = 0;   ///< File size without the buffered data.
+    u64 started = 0;  ///< File offset up to which writeback has been started.
+    u64 evicted = 0;  ///< File offset up to which the page cache has been dropped.
+    bool drop_behind = false;
+
+    [[nodiscard]] result<> write_through(char const* data, std::size_t const size) {
+      if(not this->file.valid())
+        return error("failed to write to \'{}\': file is closed", this->path);
+      if(not oslayer::write_all(this->file.native(), data, size))
+        return error("failed to write to \'{}\': {}", this->path, oslayer::last_error());
+      this->offset += size;
+      if(this->drop_behind)
+        this->write_behind();
+      return ok();
+    }
+
+    [[nodiscard]] result<> flush() {
+      if(this->used == 0)
+        return ok();
+      if(auto const res = this->write_through(this->buffer.get(), this->used); not res)
+        return res;
+      this->used = 0;
+      return ok();
+    }
+
+    /**
+     * Starts writeback of each buffer-sized step as soon as it is written, then waits for the
+     * step before it and evicts it from the page cache. The amount of dirty data stays bounded
+     * instead of being written in one burst when the kernel decides to.
+     */
+    void write_behind() noexcept {
+#if defined(RLL_OS_LINUX)
+      if(this->offset - this->started < this->capacity)
+        return;
+      auto const fd = this->file.native();
+      auto const range = [](u64 const from, u64 const to) {
+        return std::pair(static_cast<off64_t>(from), static_cast<off64_t>(to - from));
+      };
+      auto const [from, size] = range(this->started, this->offset);
+      static_cast<void>(::sync_file_range(fd, from, size, SYNC_FILE_RANGE_WRITE));
+      if(this->started > this->evicted) {
+        auto const [old_from, old_size] = range(this->evicted, this->started);
+        auto constexpr flags = SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE
+                             | SYNC_FILE_RANGE_WAIT_AFTER;
+        static_cast<void>(::sync_file_range(fd, old_from, old_size, flags));
+        drop_cached(this->file, this->evicted, this->started - this->evicted);
+        this->evicted = this->started;
+      }
+      this->started = this->offset;
+#endif
+    }
+  };
+
+  file_writer::file_writer(std::unique_ptr<impl> i) noexcept
+    : impl_(std::move(i)) {}
+
+  file_writer::file_writer(file_writer&&) noexcept = default;
+
+  file_writer& file_writer::operator=(file_writer&& other) noexcept {
+    if(this != &other) {
+      if(this->impl_)
+        static_cast<void>(this->impl_->flush());
+      this->impl_ = std::move(other.impl_);
+    }
+    return *this;
+  }
+
+  file_writer::~file_writer() {
+    if(this->impl_)
+      static_cast<void>(this->impl_->flush());
+  }
+
+  result<file_writer> file_writer::open(
+    std::filesystem::path const& path,
+    write_mode const mode,
+    stream_options const& options
+  ) noexcept {
+    try {
+      auto ec = std::error_code();
+      if(auto const parent = path.parent_path(); not parent.empty())
+        if(fs::create_directories(parent, ec); ec)
+          return error("failed to create \'{}\': {}", parent.generic_string(), ec.message());
+#if defined(RLL_OS_WINDOWS)
+      auto file = oslayer::file_handle(::CreateFileW(
+        path.c_str(),
+        GENERIC_WRITE,
+        FILE_SHARE_READ,
+        nullptr,
+        mode == write_mode::append ? OPEN_ALWAYS : CREATE_ALWAYS,
+        FILE_FLAG_SEQUENTIAL_SCAN,
+        nullptr
+      ));
+      if(file.valid() and mode == write_mode::append)
+        ::SetFilePointerEx(file.native(), LARGE_INTEGER(), nullptr, FILE_END);
+#else
+      auto const flags = O_WRONLY | O_CREAT | O_CLOEXEC
+                       | (mode == write_mode::append ? O_APPEND : O_TRUNC);
+      auto const permissions = static_cast<mode_t>(filedevice::write_permissions);
+      // NOLINTNEXTLINE(*-vararg)
+      auto file = oslayer::file_handle(::open(path.c_str(), flags, permissions));
+#endif
+      if(not file.valid()) {
+        auto const reason = oslayer::last_error();
+        return error("failed to open \'{}\': {}", path.generic_string(), reason);
+      }
+      auto const size =
+        mode == write_mode::append ? oslayer::file_size(file.native()) : result<u64>(0);
+      if(not size)
+        return unexpected(size.error());
+
+      auto i = std::make_unique<impl>();
+      i->path = path.generic_string();
+      i->file = std::move(file);
+      i->capacity = std::max(options.buffer_size, min_buffer_size);
+      i->buffer = std::make_unique<char[]>(i->capacity);  // NOLINT(*-avoid-c-arrays)
+      i->offset = i->started = i->evicted = *size;
+      i->drop_behind = options.drop_behind;
+      return file_writer(std::move(i));
+    } catch(std::exception const& ex) {
+      return error("failed to open \'{}\': {}", path.generic_string(), ex.what());
+    }
+  }
+
+  result<> file_writer::write(std::string_view const data) noexcept {
+    return this->write(data.data(), data.size());
+  }
+
+  result<> file_writer::write(void const* data, std::size_t const size) noexcept {
+    auto& d = *this->impl_;
+    if(not d.file.valid())
+      return error("failed to write to \'{}\': file is closed", d.path);
+    if(size > d.capacity - d.used)
+      if(auto const res = d.flush(); not res)
+        return res;
+    if(size >= d.capacity)
+      return d.write_through(static_cast<char const*>(data), size);
+    std::memcpy(d.buffer.get() + d.used, data, size);  // NOLINT(*-pointer-arithmetic)
+    d.used += size;
+    return ok();
+  }
+
+  result<> file_writer::flush() noexcept { return this->impl_->flush(); }
+
+  result<> file_writer::sync() noexcept {
+    auto& d = *this->impl_;
+    if(auto const res = d.flush(); not res)
+      return res;
+    if(not oslayer::sync_data(d.file.native()))
+      return error("failed to sync \'{}\': {}", d.path, oslayer::last_error());
+    return ok();
+  }
+
+  result<> file_writer::close() noexcept {
+    auto& d = *this->impl_;
+    if(not d.file.valid())
+      return ok();
+    auto const res = d.flush();
+    if(not d.file.close() and res)
+      return error("failed to close \'{}\': {}", d.path, oslayer::last_error());
+    return res;
+  }
+
+  u64 file_writer::position() const noexcept { return this->impl_->offset + this->impl_->used; }
+}  // namespace rll::io
@@ -0,0 +1,154 @@
+#include <rll/io/filedevice.h>
+
+#include <atomic>
+#include <system_error>
+#include <fmt/format.h>
+#include <rll/stdint.h>
+#include <rll/global/platform_definitions.h>
+#include "oslayer/file_handle.h"
+
+#if defined(RLL_OS_WINDOWS)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace {
+  using namespace rll;
+  namespace fs = std::filesystem;
+
+  std::atomic<u64> temp_counter = 0;
+
+  /// Unique hidden name next to @p path, so that the final rename stays within one filesystem.
+  [[nodiscard]] fs::path temp_sibling(fs::path const& path) {
+#if defined(RLL_OS_WINDOWS)
+    auto const pid = static_cast<u64>(::GetCurrentProcessId());
+#else
+    auto const pid = static_cast<u64>(::getpid());
+#endif
+    auto name = path.filename();
+    name += fmt::format(".{}.{}.tmp", pid, temp_counter.fetch_add(1, std::memory_order_relaxed));
+    return path.parent_path() / fs::path(".").concat(name.native());
+  }
+
+  [[nodiscard]] result<> create_parent(fs::path const& path) {
+    auto const parent = path.parent_path();
+    auto ec = std::error_code();
+    if(parent.empty() or fs::exists(parent, ec))
+      return ok();
+    if(fs::create_directories(parent, ec); ec)
+      return error("failed to create directory \'{}\': {}", parent.generic_string(), ec.message());
+    return ok();
+  }
+
+#if defined(RLL_OS_WINDOWS)
+  [[nodiscard]] result<>
+    replace_file(fs::path const& path, std::string_view content, io::durability const level) {
+    auto const temp = temp_sibling(path);
+    auto file = oslayer::file_handle(::CreateFileW(
+      temp.c_str(),
+      GENERIC_WRITE,
+      0,
+      nullptr,
+      CREATE_NEW,
+      FILE_ATTRIBUTE_NORMAL,
+      nullptr
+    ));
+    if(not file.valid())
+      return error("failed to create \'{}\': {}", temp.generic_string(), oslayer::last_error());
+
+    auto const fail = [&](std::string_view const what) -> result<> {
+      auto const reason = oslayer::last_error();
+      file.close();
+      ::DeleteFileW(temp.c_str());
+      return error("failed to {} \'{}\': {}", what, temp.generic_string(), reason);
+    };
+    if(not oslayer::write_all(file.native(), content.data(), content.size()))
+      return fail("write to");
+    if(level != io::durability::none and not oslayer::sync_data(file.native()))
+      return fail("flush");
+    if(not file.close())
+      return fail("close");
+
+    auto const flags = MOVEFILE_REPLACE_EXISTING
+                     | (level == io::durability::full ? MOVEFILE_WRITE_THROUGH : 0);
+    if(not ::MoveFileExW(temp.c_str(), path.c_str(), static_cast<DWORD>(flags))) {
+      auto const reason = oslayer::last_error();
+      ::DeleteFileW(temp.c_str());
+      return error("failed to replace \'{}\': {}", path.generic_string(), reason);
+    }
+    return ok();
+  }
+#else
+  [[nodiscard]] result<>
+    replace_file(fs::path const& path, std::string_view content, io::durability const level) {
+    // the replacement keeps the mode of the file it replaces
+    auto mode = static_cast<mode_t>(io::filedevice::write_permissions);
+    struct stat st = {};
+    if(::stat(path.c_str(), &st) == 0)
+      mode = st.st_mode & 07777U;
+
+    auto const temp = temp_sibling(path);
+    auto file = oslayer::file_handle(
+      ::open(temp.c_str(), O_WRONLY | O_CREAT | O_EXCL | O_CLOEXEC, mode)  // NOLINT(*-vararg)
+    );
+    if(not file.valid())
+      return error("failed to create \'{}\': {}", temp.generic_string(), oslayer::last_error());
+
+    auto const fail = [&](std::string_view const what) -> result<> {
+      auto const reason = oslayer::last_error();
+      file.close();
+      ::unlink(temp.c_str());
+      return error("failed to {} \'{}\': {}", what, temp.generic_string(), reason);
+    };
+    if(::fchmod(file.native(), mode) != 0)  // open applied the umask
+      return fail("set permissions of");
+    if(not oslayer::write_all(file.native(), content.data(), content.size()))
+      return fail("write to");
+    if(level != io::durability::none and not oslayer::sync_data(file.native()))
+      return fail("sync");
+    if(not file.close())
+      return fail("close");
+
+    if(::rename(temp.c_str(), path.c_str()) != 0) {
+      auto const reason = oslayer::last_error();
+      ::unlink(temp.c_str());
+      return error("failed to replace \'{}\': {}", path.generic_string(), reason);
+    }
+    if(level != io::durability::full)
+      return ok();
+
+    // the rename is only durable once the directory entry is
+    auto const parent = path.parent_path().empty() ? fs::path(".") : path.parent_path();
+    auto const dir = oslayer::file_handle(
+      ::open(parent.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC)  // NOLINT(*-vararg)
+    );
+    if(not dir.valid())
+      return error("failed to open \'{}\': {}", parent.generic_string(), oslayer::last_error());
+    if(::fsync(dir.native()) != 0)
+      return error("failed to sync \'{}\': {}", parent.generic_string(), oslayer::last_error());
+    return ok();
+  }
+#endif
+}  // namespace
+
+namespace rll::io {
+  result<> filedevice::try_write_atomic_to(
+    std::filesystem::path const& path,
+    std::string_view const content,
+    durability const level
+  ) noexcept {
+    try {
+      if(auto const res = create_parent(path); not res)
+        return res;
+      return replace_file(path, content, level);
+    } catch(std::exception const& ex) {
+      return error("failed to write to file at \'{}\': {}", path.generic_string(), ex.what());
+    }
+  }
+}  // namespace rll::io
@@ -0,0 +1,148 @@
+#include <rll/io/mapped_file.h>
+
+#include <utility>
+#include <rll/global/platform_definitions.h>
+
+#if defined(RLL_OS_WINDOWS)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#else
+#  include <cerrno>
+#  include <cstring>
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace rll::io {
+  mapped_file::mapped_file(mapped_file&& other) noexcept
+    : data_(std::exchange(other.data_, nullptr))
+    , size_(std::exchange(other.size_, 0)) {}
+
+  mapped_file& mapped_file::operator=(mapped_file&& other) noexcept {
+    if(this != &other) {
+      this->unmap();
+      this->data_ = std::exchange(other.data_, nullptr);
+      this->size_ = std::exchange(other.size_, 0);
+    }
+    return *this;
+  }
+
+  mapped_file::~mapped_file() { this->unmap(); }
+
+#if defined(RLL_OS_WINDOWS)
+  result<mapped_file>
+    mapped_file::open(std::filesystem::path const& path, access_hint const hint) noexcept {
+    auto const flags = hint == access_hint::sequential ? FILE_FLAG_SEQUENTIAL_SCAN
+                     : hint == access_hint::random     ? FILE_FLAG_RANDOM_ACCESS
+                                                       : FILE_ATTRIBUTE_NORMAL;
+    auto* const file = ::CreateFileW(
+      path.c_str(),
+      GENERIC_READ,
+      FILE_SHARE_READ,
+      nullptr,
+      OPEN_EXISTING,
+      static_cast<DWORD>(flags),
+      nullptr
+    );
+    if(file == INVALID_HANDLE_VALUE)  // NOLINT(*-pro-type-cstyle-cast)
+      return error("failed to open \'{}\': error {}", path.generic_string(), ::GetLastError());
+
+    auto res = mapped_file();
+    auto size = LARGE_INTEGER();
+    if(not ::GetFileSizeEx(file, &size)) {
+      auto const code = ::GetLastError();
+      ::CloseHandle(file);
+      return error("failed to query size of \'{}\': error {}", path.generic_string(), code);
+    }
+    if(size.QuadPart == 0) {
+      ::CloseHandle(file);
+      return res;
+    }
+
+    auto* const mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(file);
+    if(mapping == nullptr)
+      return error("failed to map \'{}\': error {}", path.generic_string(), ::GetLastError());
+    auto const* view = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(mapping);
+    if(view == nullptr)
+      return error("failed to map \'{}\': error {}", path.generic_string(), ::GetLastError());
+
+    res.data_ = static_cast<u8 const*>(view);
+    res.size_ = static_cast<std::size_t>(size.QuadPart);
+    res.advise(hint);
+    return res;
+  }
+
+  // the access pattern is fixed when the file is opened; only prefetching can be requested later
+  void mapped_file::advise(access_hint const hint) const noexcept {
+#  if defined(_WIN32_WINNT) && _WIN32_WINNT >= 0x0602
+    if(this->data_ == nullptr or hint != access_hint::will_need)
+      return;
+    auto range = WIN32_MEMORY_RANGE_ENTRY {const_cast<u8*>(this->data_), this->size_};  // NOLINT
+    ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+#  else
+    static_cast<void>(hint);
+#  endif
+  }
+
+  void mapped_file::unmap() noexcept {
+    if(this->data_ != nullptr)
+      ::UnmapViewOfFile(this->data_);
+    this->data_ = nullptr;
+    this->size_ = 0;
+  }
+#else
+  result<mapped_file>
+    mapped_file::open(std::filesystem::path const& path, access_hint const hint) noexcept {
+    auto const fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);  // NOLINT(*-vararg)
+    if(fd < 0)
+      return error("failed to open \'{}\': {}", path.generic_string(), std::strerror(errno));
+
+    auto res = mapped_file();
+    struct stat st = {};
+    if(::fstat(fd, &st) != 0) {
+      auto const code = errno;
+      ::close(fd);
+      return error("failed to stat \'{}\': {}", path.generic_string(), std::strerror(code));
+    }
+    if(st.st_size == 0) {
+      ::close(fd);
+      return res;
+    }
+
+    auto const size = static_cast<std::size_t>(st.st_size);
+    auto* const view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    auto const code = errno;  // before close can overwrite it
+    ::close(fd);
+    if(view == MAP_FAILED)  // NOLINT(*-pro-type-cstyle-cast)
+      return error("failed to map \'{}\': {}", path.generic_string(), std::strerror(code));
+
+    res.data_ = static_cast<u8 const*>(view);
+    res.size_ = size;
+    res.advise(hint);
+    return res;
+  }
+
+  void mapped_file::advise(access_hint const hint) const noexcept {
+    if(this->data_ == nullptr)
+      return;
+    auto const advice = hint == access_hint::sequential ? MADV_SEQUENTIAL
+                      : hint == access_hint::random     ? MADV_RANDOM
+                      : hint == access_hint::will_need  ? MADV_WILLNEED
+                                                        : MADV_NORMAL;
+    ::madvise(const_cast<u8*>(this->data_), this->size_, advice);  // NOLINT(*-const-cast)
+  }
+
+  void mapped_file::unmap() noexcept {
+    if(this->data_ != nullptr)
+      ::munmap(const_cast<u8*>(this->data_), this->size_);  // NOLINT(*-const-cast)
+    this->data_ = nullptr;
+    this->size_ = 0;
+  }
+#endif
+}  // namespace rll::io
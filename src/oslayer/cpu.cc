@@ -0,0 +1,93 @@
+#include "cpu.h"
+
+#include <rll/stdint.h>
+
+#if defined(RLL_ARCH_X86_64) || defined(RLL_ARCH_X86_32)
+#  if defined(RLL_COMPILER_MSVC)
+#    include <intrin.h>
+#  else
+#    include <cpuid.h>
+#  endif
+#elif defined(RLL_ARCH_ARM) && (defined(RLL_OS_LINUX) || defined(RLL_OS_ANDROID))
+#  include <sys/auxv.h>
+#endif
+
+namespace {
+  using namespace rll;
+
+#if defined(RLL_ARCH_X86_64) || defined(RLL_ARCH_X86_32)
+  void cpuid(u32 const leaf, u32 const subleaf, u32 (&regs)[4]) {  // NOLINT(*-avoid-c-arrays)
+#  if defined(RLL_COMPILER_MSVC)
+    int out[4] = {};  // NOLINT(*-avoid-c-arrays)
+    __cpuidex(out, static_cast<int>(leaf), static_cast<int>(subleaf));
+    for(auto i = 0; i < 4; ++i)
+      regs[i] = static_cast<u32>(out[i]);
+#  else
+    __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#  endif
+  }
+
+  u64 xgetbv() {
+#  if defined(RLL_COMPILER_MSVC)
+    return _xgetbv(0);
+#  else
+    u32 eax = 0;
+    u32 edx = 0;
+    __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+    return (static_cast<u64>(edx) << 32) | eax;
+#  endif
+  }
+#endif
+
+  oslayer::cpu_features detect() noexcept {
+    auto f = oslayer::cpu_features();
+#if defined(RLL_ARCH_X86_64) || defined(RLL_ARCH_X86_32)
+    u32 regs[4] = {};  // NOLINT(*-avoid-c-arrays)
+    cpuid(0, 0, regs);
+    auto const max_leaf = regs[0];
+    if(max_leaf < 1)
+      return f;
+    cpuid(1, 0, regs);
+    auto const ecx1 = regs[2];
+    auto const edx1 = regs[3];
+    f.sse2 = edx1 & (1U << 26);
+    f.ssse3 = ecx1 & (1U << 9);
+    f.sse41 = ecx1 & (1U << 19);
+    f.sse42 = ecx1 & (1U << 20);
+    f.pclmul = ecx1 & (1U << 1);
+
+    // ymm/zmm state must be enabled by the os, not only supported by the cpu
+    auto const osxsave = (ecx1 & (1U << 27)) != 0;
+    auto const xcr0 = osxsave ? xgetbv() : 0;
+    auto const ymm_enabled = (xcr0 & 0x06) == 0x06;
+    auto const zmm_enabled = (xcr0 & 0xE6) == 0xE6;
+    if(max_leaf >= 7) {
+      cpuid(7, 0, regs);
+      auto const ebx7 = regs[1];
+      f.avx2 = ymm_enabled and (ebx7 & (1U << 5));
+      f.avx512f = zmm_enabled and (ebx7 & (1U << 16));
+      f.avx512bw = f.avx512f and (ebx7 & (1U << 30));
+      f.sha = ebx7 & (1U << 29);
+    }
+#elif defined(RLL_ARCH_ARM) && (defined(__aarch64__) || defined(_M_ARM64))
+    f.neon = true;
+#  if defined(RLL_OS_LINUX) || defined(RLL_OS_ANDROID)
+    auto const hwcap = ::getauxval(AT_HWCAP);
+    f.arm_pmull = hwcap & (1UL << 4);
+    f.arm_sha1 = hwcap & (1UL << 5);
+    f.arm_sha2 = hwcap & (1UL << 6);
+    f.arm_crc32 = hwcap & (1UL << 7);
+#  elif defined(RLL_OS_DARWIN) || defined(RLL_OS_IOS)
+    f.arm_pmull = f.arm_sha1 = f.arm_sha2 = f.arm_crc32 = true;
+#  endif
+#endif
+    return f;
+  }
+}  // namespace
+
+namespace rll::oslayer {
+  cpu_features const& cpu() noexcept {
+    static auto const features = detect();
+    return features;
+  }
+}  // namespace rll::oslayer
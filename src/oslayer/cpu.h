@@ -0,0 +1,37 @@
+#pragma once
+
+#include "base.h"
+
+// NOLINTBEGIN(*-macro-usage, *-reserved-identifier, *-identifier-naming)
+#if defined(RLL_COMPILER_MSVC) || defined(DOXYGEN)
+#  define ___target___(isa)
+#else
+#  define ___target___(isa) __attribute__((target(isa)))
+#endif
+// NOLINTEND(*-macro-usage, *-reserved-identifier, *-identifier-naming)
+
+namespace rll::oslayer {
+  /**
+   * @brief Instruction set extensions available on the running CPU.
+   * @details Detected once at first use. Kernels compiled with @ref ___target___ must only be
+   * called if the corresponding flag is set.
+   */
+  struct cpu_features {
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool sse41 = false;
+    bool sse42 = false;
+    bool pclmul = false;
+    bool avx2 = false;
+    bool avx512f = false;
+    bool avx512bw = false;
+    bool sha = false;
+    bool neon = false;
+    bool arm_crc32 = false;
+    bool arm_sha1 = false;
+    bool arm_sha2 = false;
+    bool arm_pmull = false;
+  };
+
+  [[nodiscard]] cpu_features const& cpu() noexcept;
+}  // namespace rll::oslayer
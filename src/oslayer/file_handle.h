@@ -0,0 +1,220 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <rll/result.h>
+#include <rll/stdint.h>
+#include "base.h"
+
+#if defined(RLL_OS_WINDOWS)
+#  ifndef WIN32_LEAN_AND_MEAN
+#    define WIN32_LEAN_AND_MEAN
+#  endif
+#  include <windows.h>
+#  include <fmt/format.h>
+#else
+#  include <cerrno>
+#  include <cstring>
+#  include <fcntl.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace rll::oslayer {
+  /**
+   * @brief Owning wrapper of a native file descriptor or handle, closed on destruction.
+   */
+  class file_handle {
+   public:
+#if defined(RLL_OS_WINDOWS)
+    using native_type = HANDLE;
+#else
+    using native_type = int;
+#endif
+
+    file_handle() noexcept = default;
+
+    explicit file_handle(native_type const native) noexcept
+      : native_(native) {}
+
+    file_handle(file_handle const&) = delete;
+    file_handle& operator=(file_handle const&) = delete;
+
+    file_handle(file_handle&& other) noexcept
+      : native_(std::exchange(other.native_, invalid())) {}
+
+    file_handle& operator=(file_handle&& other) noexcept {
+      if(this != &other) {
+        this->close();
+        this->native_ = std::exchange(other.native_, invalid());
+      }
+      return *this;
+    }
+
+    ~file_handle() { this->close(); }
+
+    [[nodiscard]] native_type native() const noexcept { return this->native_; }
+
+    [[nodiscard]] bool valid() const noexcept { return this->native_ != invalid(); }
+
+    /**
+     * @brief Closes the file.
+     * @return Whether closing succeeded; on POSIX, a failure can report a lost delayed write.
+     */
+    bool close() noexcept {
+      if(not this->valid())
+        return true;
+#if defined(RLL_OS_WINDOWS)
+      auto const closed = ::CloseHandle(this->native_) != 0;
+#else
+      auto const closed = ::close(this->native_) == 0;
+#endif
+      this->native_ = invalid();
+      return closed;
+    }
+
+   private:
+    [[nodiscard]] static native_type invalid() noexcept {
+#if defined(RLL_OS_WINDOWS)
+      return INVALID_HANDLE_VALUE;  // NOLINT(*-pro-type-cstyle-cast)
+#else
+      return -1;
+#endif
+    }
+
+    native_type native_ = invalid();
+  };
+
+  /**
+   * @brief Flushes the written data of @p native to the storage device.
+   * @details Uses `fdatasync`, or `F_FULLFSYNC` on Apple platforms, where `fsync` only reaches the
+   * drive cache.
+   * @return Whether the data was synced.
+   */
+  [[nodiscard]] inline bool sync_data(file_handle::native_type const native) noexcept {
+#if defined(RLL_OS_WINDOWS)
+    return ::FlushFileBuffers(native) != 0;
+#elif defined(RLL_OS_DARWIN) || defined(RLL_OS_IOS)
+    return ::fcntl(native, F_FULLFSYNC) == 0 or ::fsync(native) == 0;  // NOLINT(*-vararg)
+#else
+    return ::fdatasync(native) == 0;
+#endif
+  }
+
+  /// Largest transfer passed to a single system call.
+  constexpr auto max_transfer = std::size_t(1) << 30U;
+
+  /**
+   * @brief Describes the error of the last failed system call, from `errno` or `GetLastError()`.
+   */
+  [[nodiscard]] inline std::string last_error() {
+#if defined(RLL_OS_WINDOWS)
+    return fmt::format("error {}", ::GetLastError());
+#else
+    return std::strerror(errno);
+#endif
+  }
+
+  /**
+   * @brief Reads up to @p size bytes at @p offset without moving the file position.
+   * @details At most @ref max_transfer bytes are read; interrupted calls are retried.
+   * @return Number of bytes read, 0 at the end of the file, or -1 on failure.
+   */
+  [[nodiscard]] inline long long read_at(
+    file_handle::native_type const native,
+    void* out,
+    std::size_t size,
+    u64 const offset
+  ) noexcept {
+    size = std::min(size, max_transfer);
+#if defined(RLL_OS_WINDOWS)
+    auto overlapped = OVERLAPPED();
+    overlapped.Offset = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32U);
+    auto done = DWORD();
+    if(not ::ReadFile(native, out, static_cast<DWORD>(size), &done, &overlapped))
+      return ::GetLastError() == ERROR_HANDLE_EOF ? 0 : -1;
+    return done;
+#else
+    while(true) {
+      auto const done = ::pread(native, out, size, static_cast<off_t>(offset));
+      if(done >= 0 or errno != EINTR)
+        return done;
+    }
+#endif
+  }
+
+  /**
+   * @brief Writes up to @p size bytes at @p offset without moving the file position.
+   * @details At most @ref max_transfer bytes are written; interrupted calls are retried.
+   * @return Number of bytes written, or -1 on failure.
+   */
+  [[nodiscard]] inline long long write_at(
+    file_handle::native_type const native,
+    void const* data,
+    std::size_t size,
+    u64 const offset
+  ) noexcept {
+    size = std::min(size, max_transfer);
+#if defined(RLL_OS_WINDOWS)
+    auto overlapped = OVERLAPPED();
+    overlapped.Offset = static_cast<DWORD>(offset);
+    overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32U);
+    auto done = DWORD();
+    if(not ::WriteFile(native, data, static_cast<DWORD>(size), &done, &overlapped))
+      return -1;
+    return done;
+#else
+    while(true) {
+      auto const done = ::pwrite(native, data, size, static_cast<off_t>(offset));
+      if(done >= 0 or errno != EINTR)
+        return done;
+    }
+#endif
+  }
+
+  /**
+   * @brief Writes all @p size bytes of @p data at the file position.
+   * @return Whether everything was written; @ref last_error describes a failure.
+   */
+  [[nodiscard]] inline bool
+    write_all(file_handle::native_type const native, void const* data, std::size_t size) noexcept {
+    auto const* bytes = static_cast<char const*>(data);
+    while(size > 0) {
+      auto const chunk = std::min(size, max_transfer);
+#if defined(RLL_OS_WINDOWS)
+      auto done = DWORD();
+      if(not ::WriteFile(native, bytes, static_cast<DWORD>(chunk), &done, nullptr))
+        return false;
+#else
+      auto const done = ::write(native, bytes, chunk);
+      if(done < 0 and errno == EINTR)
+        continue;
+      if(done < 0)
+        return false;
+#endif
+      bytes += done;  // NOLINT(*-pointer-arithmetic)
+      size -= static_cast<std::size_t>(done);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Returns the current size of the file behind @p native.
+   */
+  [[nodiscard]] inline result<u64> file_size(file_handle::native_type const native) {
+#if defined(RLL_OS_WINDOWS)
+    auto size = LARGE_INTEGER();
+    if(not ::GetFileSizeEx(native, &size))
+      return error("failed to query file size: {}", last_error());
+    return static_cast<u64>(size.QuadPart);
+#else
+    struct stat st = {};
+    if(::fstat(native, &st) != 0)
+      return error("failed to query file size: {}", last_error());
+    return static_cast<u64>(st.st_size);
+#endif
+  }
+}  // namespace rll::oslayer
@@ -0,0 +1,74 @@
+#include "random.h"
+
+#include <cerrno>
+#include <rll/global/platform_definitions.h>
+#include <rll/stdint.h>
+
+#if defined(RLL_OS_WINDOWS)
+#  include <windows.h>
+#  include <bcrypt.h>
+#  pragma comment(lib, "bcrypt.lib")
+#else
+#  include <fcntl.h>
+#  include <unistd.h>
+#  if defined(RLL_OS_LINUX) || defined(RLL_OS_ANDROID)
+#    include <sys/syscall.h>
+#  elif defined(RLL_OS_DARWIN)
+#    include <sys/random.h>
+#  endif
+#endif
+
+namespace rll::oslayer {
+  bool system_random(void* data, std::size_t len) noexcept {
+    auto* out = static_cast<u8*>(data);
+#if defined(RLL_OS_WINDOWS)
+    while(len > 0) {
+      auto const chunk = static_cast<ULONG>(len < 0x10000000 ? len : 0x10000000);
+      if(::BCryptGenRandom(nullptr, out, chunk, BCRYPT_USE_SYSTEM_PREFERRED_RNG) != 0)
+        return false;
+      out += chunk;  // NOLINT(*-pointer-arithmetic)
+      len -= chunk;
+    }
+    return true;
+#else
+#  if (defined(RLL_OS_LINUX) || defined(RLL_OS_ANDROID)) && defined(SYS_getrandom)
+    while(len > 0) {
+      auto const n = ::syscall(SYS_getrandom, out, len, 0);
+      if(n < 0) {
+        if(errno == EINTR)
+          continue;
+        break;  // old kernel or seccomp filter: fall back to the device
+      }
+      out += n;  // NOLINT(*-pointer-arithmetic)
+      len -= static_cast<std::size_t>(n);
+    }
+    if(len == 0)
+      return true;
+#  elif defined(RLL_OS_DARWIN) || defined(RLL_OS_FREEBSD)
+    while(len > 0) {
+      auto const chunk = len < 256 ? len : std::size_t(256);
+      if(::getentropy(out, chunk) != 0)
+        break;
+      out += chunk;  // NOLINT(*-pointer-arithmetic)
+      len -= chunk;
+    }
+    if(len == 0)
+      return true;
+#  endif
+    auto const fd = ::open("/dev/urandom", O_RDONLY | O_CLOEXEC);  // NOLINT(*-vararg)
+    if(fd < 0)
+      return false;
+    while(len > 0) {
+      auto const n = ::read(fd, out, len);
+      if(n < 0 and errno == EINTR)
+        continue;
+      if(n <= 0)
+        break;
+      out += n;  // NOLINT(*-pointer-arithmetic)
+      len -= static_cast<std::size_t>(n);
+    }
+    ::close(fd);
+    return len == 0;
+#endif
+  }
+}  // namespace rll::oslayer
@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstddef>
+
+namespace rll::oslayer {
+  /**
+   * @brief Fills @p data with @p len bytes from the operating system CSPRNG.
+   * @details Uses `getrandom` or `getentropy` where available, `/dev/urandom` otherwise and
+   * `BCryptGenRandom` on Windows. May block until the kernel pool is initialized during early boot.
+   * @return `false` if no source could deliver the bytes.
+   */
+  [[nodiscard]] bool system_random(void* data, std::size_t len) noexcept;
+}  // namespace rll::oslayer
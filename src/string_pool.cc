@@ -0,0 +1,179 @@
+#include <rll/string_pool.h>
+
+#include <array>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
+#include <unordered_set>
+#include <vector>
+#include <fmt/format.h>
+#include <rll/crypto/fast_hash.h>
+
+namespace {
+  using namespace rll;
+
+  constexpr auto shard_bits = 4U;
+  constexpr auto shard_count = std::size_t(1) << shard_bits;
+  constexpr auto max_index = std::size_t(std::numeric_limits<u32>::max() >> shard_bits) - 1;
+
+  /// Arena block size; longer strings get a block of their own.
+  constexpr auto block_size = std::size_t(64) << 10U;
+
+  /// Handle of the @p index-th string of shard @p shard; never `0`, which is the empty string.
+  [[nodiscard]] constexpr u32 make_id(std::size_t const shard, std::size_t const index) noexcept {
+    return static_cast<u32>(((index + 1) << shard_bits) | shard);
+  }
+
+  /// Interned characters and their hash, which picks the shard and is kept to skip rehashing.
+  struct key {
+    std::string_view str;
+    u64 hash;
+  };
+
+  struct key_hash {
+    [[nodiscard]] std::size_t operator()(key const& k) const noexcept {
+      return static_cast<std::size_t>(k.hash);
+    }
+  };
+
+  struct key_equal {
+    [[nodiscard]] bool operator()(key const& a, key const& b) const noexcept {
+      return a.str == b.str;
+    }
+  };
+
+  struct alignas(64) shard {
+    mutable std::shared_mutex lock;
+    std::unordered_set<key, key_hash, key_equal> strings;
+    std::vector<char const*> by_index;
+    std::vector<std::unique_ptr<char[]>> blocks;  // NOLINT(*-avoid-c-arrays)
+    char* cursor = nullptr;
+    std::size_t left = 0;
+    std::size_t allocated = 0;
+
+    /// Copies @p str behind its header into the arena; the caller holds the lock exclusively.
+    [[nodiscard]] char const* store(std::string_view const str, u32 const id) {
+      constexpr auto align = alignof(detail::interned_header);
+      auto const needed =
+        (sizeof(detail::interned_header) + str.size() + 1 + align - 1) / align * align;
+      auto* at = this->cursor;
+      if(needed > this->left) {
+        auto const size = needed > block_size / 4 ? needed : block_size;
+        // not value-initialized: the bytes are written right away
+        this->blocks.push_back(std::unique_ptr<char[]>(new char[size]));  // NOLINT
+        this->allocated += size;
+        at = this->blocks.back().get();
+        if(size == block_size) {
+          this->cursor = at + needed;  // NOLINT(*-pointer-arithmetic)
+          this->left = block_size - needed;
+        }
+      } else {
+        this->cursor += needed;  // NOLINT(*-pointer-arithmetic)
+        this->left -= needed;
+      }
+      auto const header = detail::interned_header {static_cast<u32>(str.size()), id};
+      std::memcpy(at, &header, sizeof(header));
+      auto* data = at + sizeof(header);  // NOLINT(*-pointer-arithmetic)
+      std::memcpy(data, str.data(), str.size());
+      data[str.size()] = '\0';  // NOLINT(*-pointer-arithmetic)
+      return data;
+    }
+  };
+}  // namespace
+
+namespace rll {
+  struct string_pool::impl {
+    std::array<shard, shard_count> shards;
+
+    [[nodiscard]] static key make_key(std::string_view const str) noexcept {
+      return {str, crypto::fast_hash64(str)};
+    }
+
+    [[nodiscard]] shard& shard_of(key const& k) noexcept {
+      return this->shards[k.hash >> (64U - shard_bits)];  // NOLINT(*-constant-array-index)
+    }
+
+    [[nodiscard]] shard const& shard_of(key const& k) const noexcept {
+      return this->shards[k.hash >> (64U - shard_bits)];  // NOLINT(*-constant-array-index)
+    }
+  };
+
+  string_pool::string_pool()
+    : impl_(std::make_unique<impl>()) {}
+
+  string_pool::~string_pool() = default;
+
+  string_pool::string_pool(string_pool&&) noexcept = default;
+
+  string_pool& string_pool::operator=(string_pool&&) noexcept = default;
+
+  interned_string string_pool::intern(std::string_view const str) {
+    if(str.empty())
+      return {};
+    if(str.size() > std::numeric_limits<u32>::max())
+      throw std::length_error("rll::string_pool::intern: string too long");
+    auto const k = impl::make_key(str);
+    auto& s = this->impl_->shard_of(k);
+    {
+      auto const lock = std::shared_lock(s.lock);
+      if(auto const it = s.strings.find(k); it != s.strings.end())
+        return interned_string(it->str.data());
+    }
+
+    auto const lock = std::unique_lock(s.lock);
+    if(auto const it = s.strings.find(k); it != s.strings.end())
+      return interned_string(it->str.data());  // interned by another thread meanwhile
+    auto const index = s.by_index.size();
+    if(index > max_index)
+      throw std::length_error("rll::string_pool::intern: out of string handles");
+    auto const shard_index = static_cast<std::size_t>(&s - this->impl_->shards.data());
+    s.by_index.reserve(index + 1);
+    s.strings.reserve(s.strings.size() + 1);
+    auto const* data = s.store(str, make_id(shard_index, index));
+    s.by_index.push_back(data);
+    s.strings.insert(key {std::string_view(data, str.size()), k.hash});
+    return interned_string(data);
+  }
+
+  optional<interned_string> string_pool::find(std::string_view const str) const {
+    if(str.empty())
+      return interned_string();
+    auto const k = impl::make_key(str);
+    auto const& s = this->impl_->shard_of(k);
+    auto const lock = std::shared_lock(s.lock);
+    if(auto const it = s.strings.find(k); it != s.strings.end())
+      return interned_string(it->str.data());
+    return nullopt;
+  }
+
+  interned_string string_pool::at(u32 const id) const {
+    if(id == 0)
+      return {};
+    auto const& s = this->impl_->shards[id & (shard_count - 1)];  // NOLINT(*-constant-array-index)
+    auto const index = std::size_t(id >> shard_bits) - 1;
+    auto const lock = std::shared_lock(s.lock);
+    if(index >= s.by_index.size())
+      throw std::out_of_range(fmt::format("rll::string_pool::at: unknown string handle {}", id));
+    return interned_string(s.by_index[index]);
+  }
+
+  std::size_t string_pool::size() const {
+    auto res = std::size_t(0);
+    for(auto const& s : this->impl_->shards) {
+      auto const lock = std::shared_lock(s.lock);
+      res += s.by_index.size();
+    }
+    return res;
+  }
+
+  std::size_t string_pool::memory_usage() const {
+    auto res = std::size_t(0);
+    for(auto const& s : this->impl_->shards) {
+      auto const lock = std::shared_lock(s.lock);
+      res += s.allocated;
+    }
+    return res;
+  }
+}  // namespace rll
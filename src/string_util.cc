@@ -1,37 +1,616 @@
 #include <rll/string_util.h>
 
 #include <algorithm>
-#include <iterator>
-#include <sstream>
+#include <array>
+#include <exception>
+#include <system_error>
+#include <thread>
+#include <rll/bit.h>
+#include <rll/stdint.h>
+#include <rll/crypto/fast_hash.h>
+
+#include "oslayer/cpu.h"
+
+#if defined(RLL_ARCH_X86_64) || defined(RLL_ARCH_X86_32)
+#  include <immintrin.h>
+#  define RLL_STRING_X86
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#  include <arm_neon.h>
+#  define RLL_STRING_NEON
+#endif
+
+namespace {
+  using namespace rll;
+
+  // NOLINTBEGIN(*-pro-type-reinterpret-cast, *-pro-bounds-pointer-arithmetic)
+  /// Joins the threads of a fan-out on every way out of the scope.
+  class join_guard {
+   public:
+    explicit join_guard(std::vector<std::thread>& threads) noexcept
+      : threads_(threads) {}
+
+    join_guard(join_guard const&) = delete;
+    join_guard& operator=(join_guard const&) = delete;
+
+    ~join_guard() {
+      for(auto& thread : this->threads_)
+        if(thread.joinable())
+          thread.join();
+    }
+
+   private:
+    std::vector<std::thread>& threads_;
+  };
+
+  [[nodiscard]] inline std::size_t lowest_bit(u64 const mask) noexcept {
+    return static_cast<std::size_t>(countr_zero(mask));
+  }
+
+  /**
+   * Set of bytes for find_first_of, as a bitmap for the scalar path and as two 16-entry nibble
+   * tables for the vector paths: `c` is in the set iff `low[c & 15] & high[c >> 4]` is not zero.
+   * Every distinct high nibble of the set needs a bit of its own, so the tables only work for
+   * sets with at most eight distinct high nibbles (e.g. any set of up to eight bytes).
+   */
+  struct byte_set {
+    std::array<u64, 4> bits = {};
+    alignas(16) std::array<u8, 16> low = {};
+    alignas(16) std::array<u8, 16> high = {};
+    bool nibbles = true;
+
+    explicit byte_set(std::string_view const chars) noexcept {
+      auto groups = 0U;
+      for(auto const ch : chars) {
+        auto const c = static_cast<u8>(ch);
+        this->bits[c >> 6U] |= u64(1) << (c & 63U);
+        auto const hi = c >> 4U;
+        if(this->high[hi] == 0) {
+          if(groups == 8) {
+            this->nibbles = false;
+            continue;
+          }
+          this->high[hi] = static_cast<u8>(1U << groups++);
+        }
+        this->low[c & 15U] |= this->high[hi];
+      }
+    }
+
+    [[nodiscard]] bool contains(u8 const c) const noexcept {
+      return (this->bits[c >> 6U] >> (c & 63U)) & 1U;
+    }
+  };
+
+  using count_fn = std::size_t (*)(u8 const*, std::size_t, u8) noexcept;
+  using find_all_fn = void (*)(u8 const*, std::size_t, u8, std::size_t, std::vector<std::size_t>&);
+  using flip_case_fn = void (*)(u8 const*, std::size_t, u8*, u8) noexcept;
+  using iequals_fn = bool (*)(u8 const*, u8 const*, std::size_t) noexcept;
+
+  /// Distance between an ASCII letter and its other case, which is a single bit.
+  constexpr auto case_bit = u8(0x20);
+
+  std::size_t count_portable(u8 const* p, std::size_t const n, u8 const c) noexcept {
+    return static_cast<std::size_t>(std::count(p, p + n, c));
+  }
+
+  void find_all_portable(
+    u8 const* p,
+    std::size_t const n,
+    u8 const c,
+    std::size_t const base,
+    std::vector<std::size_t>& out
+  ) {
+    for(auto i = std::size_t(0); i < n; i++)
+      if(p[i] == c)
+        out.push_back(base + i);
+  }
+
+  std::size_t find_first_of_portable(u8 const* p, std::size_t const n, byte_set const& set)
+    noexcept {
+    for(auto i = std::size_t(0); i < n; i++)
+      if(set.contains(p[i]))
+        return i;
+    return std::string_view::npos;
+  }
+
+  /**
+   * Copies @p n bytes from @p in to @p out, flipping the case of the 26 letters starting at
+   * @p first (`'A'` to lower, `'a'` to upper); all other bytes, including non-ASCII ones, are
+   * copied unchanged. @p out may be equal to @p in.
+   */
+  void flip_case_portable(u8 const* in, std::size_t const n, u8* out, u8 const first) noexcept {
+    for(auto i = std::size_t(0); i < n; i++)
+      out[i] = static_cast<u8>(in[i] - first) < 26 ? static_cast<u8>(in[i] ^ case_bit) : in[i];
+  }
+
+  [[nodiscard]] constexpr u8 ascii_lower(u8 const c) noexcept {
+    return static_cast<u8>(c - 'A') < 26 ? static_cast<u8>(c | case_bit) : c;
+  }
+
+  bool iequals_portable(u8 const* a, u8 const* b, std::size_t const n) noexcept {
+    for(auto i = std::size_t(0); i < n; i++)
+      if(a[i] != b[i] and ascii_lower(a[i]) != ascii_lower(b[i]))
+        return false;
+    return true;
+  }
+
+  /// Appends `base + i` for every set bit `i` of @p mask.
+  inline void append_bits(u64 mask, std::size_t const base, std::vector<std::size_t>& out) {
+    for(; mask != 0; mask &= mask - 1)
+      out.push_back(base + lowest_bit(mask));
+  }
+
+#if defined(RLL_STRING_X86)
+  ___target___("sse2") std::size_t count_sse2(u8 const* p, std::size_t const n, u8 const c)
+    noexcept {
+    auto const needle = _mm_set1_epi8(static_cast<char>(c));
+    auto total = std::size_t(0);
+    auto i = std::size_t(0);
+    while(i + 16 <= n) {
+      // byte counters overflow after 255 blocks
+      auto const blocks = std::min<std::size_t>((n - i) / 16, 255);
+      auto acc = _mm_setzero_si128();
+      for(auto b = std::size_t(0); b < blocks; b++, i += 16) {
+        auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+        acc = _mm_sub_epi8(acc, _mm_cmpeq_epi8(v, needle));
+      }
+      auto const sums = _mm_sad_epu8(acc, _mm_setzero_si128());
+      total += static_cast<std::size_t>(_mm_cvtsi128_si32(sums))
+             + static_cast<std::size_t>(_mm_cvtsi128_si32(_mm_srli_si128(sums, 8)));
+    }
+    return total + count_portable(p + i, n - i, c);
+  }
+
+  ___target___("avx2") std::size_t count_avx2(u8 const* p, std::size_t const n, u8 const c)
+    noexcept {
+    auto const needle = _mm256_set1_epi8(static_cast<char>(c));
+    auto total = std::size_t(0);
+    auto i = std::size_t(0);
+    while(i + 32 <= n) {
+      auto const blocks = std::min<std::size_t>((n - i) / 32, 255);
+      auto acc = _mm256_setzero_si256();
+      for(auto b = std::size_t(0); b < blocks; b++, i += 32) {
+        auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i));
+        acc = _mm256_sub_epi8(acc, _mm256_cmpeq_epi8(v, needle));
+      }
+      auto const sums = _mm256_sad_epu8(acc, _mm256_setzero_si256());
+      auto const half =
+        _mm_add_epi64(_mm256_castsi256_si128(sums), _mm256_extracti128_si256(sums, 1));
+      total += static_cast<std::size_t>(_mm_cvtsi128_si32(half))
+             + static_cast<std::size_t>(_mm_cvtsi128_si32(_mm_srli_si128(half, 8)));
+    }
+    return total + count_portable(p + i, n - i, c);
+  }
+
+  ___target___("sse2") void find_all_sse2(
+    u8 const* p,
+    std::size_t const n,
+    u8 const c,
+    std::size_t const base,
+    std::vector<std::size_t>& out
+  ) {
+    auto const needle = _mm_set1_epi8(static_cast<char>(c));
+    auto i = std::size_t(0);
+    for(; i + 16 <= n; i += 16) {
+      auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+      append_bits(static_cast<u32>(_mm_movemask_epi8(_mm_cmpeq_epi8(v, needle))), base + i, out);
+    }
+    find_all_portable(p + i, n - i, c, base + i, out);
+  }
+
+  ___target___("avx2") void find_all_avx2(
+    u8 const* p,
+    std::size_t const n,
+    u8 const c,
+    std::size_t const base,
+    std::vector<std::size_t>& out
+  ) {
+    auto const needle = _mm256_set1_epi8(static_cast<char>(c));
+    auto i = std::size_t(0);
+    for(; i + 64 <= n; i += 64) {
+      auto const a = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i));
+      auto const b = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i + 32));
+      auto const lo = static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(a, needle)));
+      auto const hi = static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(b, needle)));
+      append_bits(lo | (static_cast<u64>(hi) << 32U), base + i, out);
+    }
+    find_all_portable(p + i, n - i, c, base + i, out);
+  }
+
+  // compares every byte with each byte of the set; only for sets of up to 16 bytes
+  ___target___("sse2") std::size_t find_first_of_sse2(
+    u8 const* p,
+    std::size_t const n,
+    std::string_view const chars,
+    byte_set const& set
+  ) noexcept {
+    __m128i needles[16];  // NOLINT(*-avoid-c-arrays)
+    for(auto j = std::size_t(0); j < chars.size(); j++)
+      needles[j] = _mm_set1_epi8(chars[j]);
+    auto i = std::size_t(0);
+    for(; i + 16 <= n; i += 16) {
+      auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p + i));
+      auto hits = _mm_setzero_si128();
+      for(auto j = std::size_t(0); j < chars.size(); j++)
+        hits = _mm_or_si128(hits, _mm_cmpeq_epi8(v, needles[j]));
+      if(auto const mask = static_cast<u32>(_mm_movemask_epi8(hits)); mask != 0)
+        return i + lowest_bit(mask);
+    }
+    auto const tail = find_first_of_portable(p + i, n - i, set);
+    return tail == std::string_view::npos ? tail : i + tail;
+  }
+
+  // nibble lookup ("shufti"): two pshufb per 32 bytes, whatever the size of the set
+  ___target___("avx2") std::size_t
+    find_first_of_avx2(u8 const* p, std::size_t const n, byte_set const& set) noexcept {
+    auto const low = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<__m128i const*>(set.low.data()))
+    );
+    auto const high = _mm256_broadcastsi128_si256(
+      _mm_load_si128(reinterpret_cast<__m128i const*>(set.high.data()))
+    );
+    auto const nibble = _mm256_set1_epi8(0x0F);
+    auto const zero = _mm256_setzero_si256();
+    auto i = std::size_t(0);
+    for(; i + 32 <= n; i += 32) {
+      auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p + i));
+      auto const classes = _mm256_and_si256(
+        _mm256_shuffle_epi8(low, _mm256_and_si256(v, nibble)),
+        _mm256_shuffle_epi8(high, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble))
+      );
+      auto const misses = static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(classes, zero)));
+      if(misses != 0xFFFFFFFFU)
+        return i + lowest_bit(~misses);
+    }
+    auto const tail = find_first_of_portable(p + i, n - i, set);
+    return tail == std::string_view::npos ? tail : i + tail;
+  }
+
+  /// Flips the case bit of the bytes of @p v in `[first, first + 26)`.
+  ___target___("sse2") __m128i flip_sse2(__m128i const v, u8 const first) noexcept {
+    // after the shift the range starts at -128, so a signed compare finds it
+    auto const shifted = _mm_add_epi8(v, _mm_set1_epi8(static_cast<char>(0x80 - first)));
+    auto const in_range = _mm_cmplt_epi8(shifted, _mm_set1_epi8(static_cast<char>(0x80 + 26)));
+    return _mm_xor_si128(v, _mm_and_si128(in_range, _mm_set1_epi8(case_bit)));
+  }
+
+  ___target___("sse2") void flip_case_sse2(
+    u8 const* in,
+    std::size_t const n,
+    u8* out,
+    u8 const first
+  ) noexcept {
+    auto i = std::size_t(0);
+    for(; i + 16 <= n; i += 16) {
+      auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + i));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), flip_sse2(v, first));
+    }
+    flip_case_portable(in + i, n - i, out + i, first);
+  }
+
+  ___target___("sse2") bool iequals_sse2(u8 const* a, u8 const* b, std::size_t const n) noexcept {
+    auto i = std::size_t(0);
+    for(; i + 16 <= n; i += 16) {
+      auto const va = _mm_loadu_si128(reinterpret_cast<__m128i const*>(a + i));
+      auto const vb = _mm_loadu_si128(reinterpret_cast<__m128i const*>(b + i));
+      auto const eq = _mm_cmpeq_epi8(flip_sse2(va, 'A'), flip_sse2(vb, 'A'));
+      if(_mm_movemask_epi8(eq) != 0xFFFF)
+        return false;
+    }
+    return iequals_portable(a + i, b + i, n - i);
+  }
+
+  ___target___("avx2") __m256i flip_avx2(__m256i const v, u8 const first) noexcept {
+    auto const shifted = _mm256_add_epi8(v, _mm256_set1_epi8(static_cast<char>(0x80 - first)));
+    auto const in_range =
+      _mm256_cmpgt_epi8(_mm256_set1_epi8(static_cast<char>(0x80 + 26)), shifted);
+    return _mm256_xor_si256(v, _mm256_and_si256(in_range, _mm256_set1_epi8(case_bit)));
+  }
+
+  ___target___("avx2") void flip_case_avx2(
+    u8 const* in,
+    std::size_t const n,
+    u8* out,
+    u8 const first
+  ) noexcept {
+    auto i = std::size_t(0);
+    for(; i + 32 <= n; i += 32) {
+      auto const v = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(in + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), flip_avx2(v, first));
+    }
+    flip_case_portable(in + i, n - i, out + i, first);
+  }
+
+  ___target___("avx2") bool iequals_avx2(u8 const* a, u8 const* b, std::size_t const n) noexcept {
+    auto i = std::size_t(0);
+    for(; i + 32 <= n; i += 32) {
+      auto const va = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(a + i));
+      auto const vb = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(b + i));
+      auto const eq = _mm256_cmpeq_epi8(flip_avx2(va, 'A'), flip_avx2(vb, 'A'));
+      if(static_cast<u32>(_mm256_movemask_epi8(eq)) != 0xFFFFFFFFU)
+        return false;
+    }
+    return iequals_portable(a + i, b + i, n - i);
+  }
+#elif defined(RLL_STRING_NEON)
+  std::size_t count_neon(u8 const* p, std::size_t const n, u8 const c) noexcept {
+    auto const needle = vdupq_n_u8(c);
+    auto total = std::size_t(0);
+    auto i = std::size_t(0);
+    while(i + 16 <= n) {
+      auto const blocks = std::min<std::size_t>((n - i) / 16, 255);
+      auto acc = vdupq_n_u8(0);
+      for(auto b = std::size_t(0); b < blocks; b++, i += 16)
+        acc = vsubq_u8(acc, vceqq_u8(vld1q_u8(p + i), needle));
+      total += vaddlvq_u8(acc);
+    }
+    return total + count_portable(p + i, n - i, c);
+  }
+
+  /// One bit (bit 4k + 3) per byte k of a compare result.
+  [[nodiscard]] inline u64 movemask_neon(uint8x16_t const eq) noexcept {
+    auto const nibbles = vshrn_n_u16(vreinterpretq_u16_u8(eq), 4);
+    return vget_lane_u64(vreinterpret_u64_u8(nibbles), 0) & 0x8888888888888888ULL;
+  }
+
+  void find_all_neon(
+    u8 const* p,
+    std::size_t const n,
+    u8 const c,
+    std::size_t const base,
+    std::vector<std::size_t>& out
+  ) {
+    auto const needle = vdupq_n_u8(c);
+    auto i = std::size_t(0);
+    for(; i + 16 <= n; i += 16) {
+      for(auto mask = movemask_neon(vceqq_u8(vld1q_u8(p + i), needle)); mask != 0; mask &= mask - 1)
+        out.push_back(base + i + (lowest_bit(mask) >> 2U));
+    }
+    find_all_portable(p + i, n - i, c, base + i, out);
+  }
+
+  std::size_t find_first_of_neon(u8 const* p, std::size_t const n, byte_set const& set) noexcept {
+    auto const low = vld1q_u8(set.low.data());
+    auto const high = vld1q_u8(set.high.data());
+    auto const nibble = vdupq_n_u8(0x0F);
+    auto i = std::size_t(0);
+    for(; i + 16 <= n; i += 16) {
+      auto const v = vld1q_u8(p + i);
+      auto const classes =
+        vandq_u8(vqtbl1q_u8(low, vandq_u8(v, nibble)), vqtbl1q_u8(high, vshrq_n_u8(v, 4)));
+      if(auto const mask = movemask_neon(vtstq_u8(classes, classes)); mask != 0)
+        return i + (lowest_bit(mask) >> 2U);
+    }
+    auto const tail = find_first_of_portable(p + i, n - i, set);
+    return tail == std::string_view::npos ? tail : i + tail;
+  }
+
+  [[nodiscard]] inline uint8x16_t flip_neon(uint8x16_t const v, u8 const first) noexcept {
+    auto const in_range = vcltq_u8(vsubq_u8(v, vdupq_n_u8(first)), vdupq_n_u8(26));
+    return veorq_u8(v, vandq_u8(in_range, vdupq_n_u8(case_bit)));
+  }
+
+  void flip_case_neon(u8 const* in, std::size_t const n, u8* out, u8 const first) noexcept {
+    auto i = std::size_t(0);
+    for(; i + 16 <= n; i += 16)
+      vst1q_u8(out + i, flip_neon(vld1q_u8(in + i), first));
+    flip_case_portable(in + i, n - i, out + i, first);
+  }
+
+  bool iequals_neon(u8 const* a, u8 const* b, std::size_t const n) noexcept {
+    auto i = std::size_t(0);
+    for(; i + 16 <= n; i += 16) {
+      auto const eq =
+        vceqq_u8(flip_neon(vld1q_u8(a + i), 'A'), flip_neon(vld1q_u8(b + i), 'A'));
+      if(vminvq_u8(eq) != 0xFF)
+        return false;
+    }
+    return iequals_portable(a + i, b + i, n - i);
+  }
+#endif
+  // NOLINTEND(*-pro-type-reinterpret-cast, *-pro-bounds-pointer-arithmetic)
+
+  struct scan_kernels {
+    count_fn count;
+    find_all_fn find_all;
+    flip_case_fn flip_case;
+    iequals_fn iequals;
+  };
+
+  scan_kernels select_scan_kernels() noexcept {
+#if defined(RLL_STRING_X86)
+    auto const& cpu = oslayer::cpu();
+    if(cpu.avx2)
+      return {count_avx2, find_all_avx2, flip_case_avx2, iequals_avx2};
+    if(cpu.sse2)
+      return {count_sse2, find_all_sse2, flip_case_sse2, iequals_sse2};
+#elif defined(RLL_STRING_NEON)
+    return {count_neon, find_all_neon, flip_case_neon, iequals_neon};
+#endif
+    return {count_portable, find_all_portable, flip_case_portable, iequals_portable};
+  }
+
+  scan_kernels const& active_scan_kernels() noexcept {
+    static auto const k = select_scan_kernels();
+    return k;
+  }
+
+  std::size_t find_first_of_dispatch(u8 const* p, std::size_t const n, std::string_view const chars)
+    noexcept {
+    auto const set = byte_set(chars);
+#if defined(RLL_STRING_X86)
+    auto const& cpu = oslayer::cpu();
+    if(cpu.avx2 and set.nibbles)
+      return find_first_of_avx2(p, n, set);
+    if(cpu.sse2 and chars.size() <= 16)
+      return find_first_of_sse2(p, n, chars, set);
+#elif defined(RLL_STRING_NEON)
+    if(set.nibbles)
+      return find_first_of_neon(p, n, set);
+#endif
+    return find_first_of_portable(p, n, set);
+  }
+
+  void flip_case(std::string_view const input, char* out, u8 const first) noexcept {
+    active_scan_kernels().flip_case(
+      reinterpret_cast<u8 const*>(input.data()),  // NOLINT(*-reinterpret-cast)
+      input.size(),
+      reinterpret_cast<u8*>(out),  // NOLINT(*-reinterpret-cast)
+      first
+    );
+  }
+
+  /// Below this many bytes per thread, starting a thread costs more than scanning.
+  constexpr auto min_bytes_per_thread = std::size_t(1) << 20U;
+}  // namespace
 
 namespace rll {
   std::vector<std::string> split(std::string const& input) {
-    auto buffer = std::istringstream(input);
-    return {std::istream_iterator<std::string>(buffer), std::istream_iterator<std::string>()};
+    return split(std::string_view(input));
   }
 
   std::vector<std::string> split(std::string_view input) {
-    auto str = std::string(input);
-    return split(str);
+    auto tokens = std::vector<std::string>();
+    for(auto const token : whitespace_split_view(input))
+      tokens.emplace_back(token);
+    return tokens;
   }
 
   std::vector<std::string> split_by(std::string const& input, char delimiter) {
+    return split_by(std::string_view(input), delimiter);
+  }
+
+  std::vector<std::string> split_by(std::string_view input, char delimiter) {
     auto tokens = std::vector<std::string>();
-    auto token = std::string();
-    auto token_stream = std::istringstream(input);
-    while(std::getline(token_stream, token, delimiter))
-      tokens.push_back(token);
+    for(auto const token : split_view(input, delimiter))
+      tokens.emplace_back(token);
     return tokens;
   }
 
-  std::vector<std::string> split_by(std::string_view input, char delimiter) {
-    auto str = std::string(input);
-    return split_by(str, delimiter);
+  std::size_t
+    find_first_of(std::string_view const input, std::string_view const chars, std::size_t const pos)
+      noexcept {
+    if(pos >= input.size() or chars.empty())
+      return std::string_view::npos;
+    auto const* data = reinterpret_cast<u8 const*>(input.data()) + pos;  // NOLINT
+    auto const size = input.size() - pos;
+    if(chars.size() == 1) {
+      auto const* found = static_cast<u8 const*>(std::memchr(data, chars.front(), size));
+      return found == nullptr ? std::string_view::npos
+                              : pos + static_cast<std::size_t>(found - data);
+    }
+    auto const found = find_first_of_dispatch(data, size, chars);
+    return found == std::string_view::npos ? found : pos + found;
   }
 
-  std::string to_lower(std::string_view input) {
-    auto str = std::string(input);
-    std::transform(str.begin(), str.end(), str.begin(), ::tolower);
+  std::size_t count(std::string_view const input, char const c) noexcept {
+    return active_scan_kernels().count(
+      reinterpret_cast<u8 const*>(input.data()),  // NOLINT(*-reinterpret-cast)
+      input.size(),
+      static_cast<u8>(c)
+    );
+  }
+
+  std::vector<std::size_t> line_offsets(std::string_view const input, std::size_t threads) {
+    auto const find_all = active_scan_kernels().find_all;
+    auto const* data = reinterpret_cast<u8 const*>(input.data());  // NOLINT(*-reinterpret-cast)
+    auto res = std::vector<std::size_t>();
+    if(threads == 0)  // hardware_concurrency is a system call on some platforms
+      threads = input.size() < 2 * min_bytes_per_thread ? 1 : std::thread::hardware_concurrency();
+    threads = std::max(std::size_t(1), std::min(threads, input.size() / min_bytes_per_thread));
+    if(threads == 1) {
+      find_all(data, input.size(), '\n', 0, res);
+      return res;
+    }
+
+    // every thread indexes its own slice; the slices are concatenated in order
+    auto const slice = (input.size() + threads - 1) / threads;
+    auto parts = std::vector<std::vector<std::size_t>>(threads);
+    auto errors = std::vector<std::exception_ptr>(threads);
+    auto const work = [&](std::size_t const t) noexcept {
+      try {
+        auto const begin = std::min(input.size(), t * slice);
+        auto const end = std::min(input.size(), begin + slice);
+        find_all(data + begin, end - begin, '\n', begin, parts[t]);  // NOLINT(*-pointer-arithmetic)
+      } catch(...) {
+        errors[t] = std::current_exception();
+      }
+    };
+    {
+      auto pool = std::vector<std::thread>();
+      auto const joiner = join_guard(pool);
+      pool.reserve(threads - 1);
+      auto started = std::size_t(1);
+      try {
+        for(; started < threads; started++)
+          pool.emplace_back(work, started);
+      } catch(std::system_error const&) {  // NOLINT(*-empty-catch)
+        // out of threads: the remaining slices are indexed here
+      }
+      work(0);
+      for(auto t = started; t < threads; t++)
+        work(t);
+    }
+    for(auto const& failure : errors)
+      if(failure)
+        std::rethrow_exception(failure);
+
+    auto total = std::size_t(0);
+    for(auto const& part : parts)
+      total += part.size();
+    res.reserve(total);
+    for(auto const& part : parts)
+      res.insert(res.end(), part.begin(), part.end());
+    return res;
+  }
+
+  std::string to_lower(std::string_view const input) {
+    auto str = std::string(input.size(), '\0');
+    flip_case(input, str.data(), 'A');
     return str;
   }
+
+  std::string to_upper(std::string_view const input) {
+    auto str = std::string(input.size(), '\0');
+    flip_case(input, str.data(), 'a');
+    return str;
+  }
+
+  char* to_lower(std::string_view const input, char* out) noexcept {
+    flip_case(input, out, 'A');
+    return out + input.size();  // NOLINT(*-pointer-arithmetic)
+  }
+
+  char* to_upper(std::string_view const input, char* out) noexcept {
+    flip_case(input, out, 'a');
+    return out + input.size();  // NOLINT(*-pointer-arithmetic)
+  }
+
+  void to_lower_in_place(std::string& str) noexcept { flip_case(str, str.data(), 'A'); }
+
+  void to_upper_in_place(std::string& str) noexcept { flip_case(str, str.data(), 'a'); }
+
+  bool iequals(std::string_view const a, std::string_view const b) noexcept {
+    // NOLINTBEGIN(*-reinterpret-cast)
+    return a.size() == b.size()
+       and active_scan_kernels().iequals(
+             reinterpret_cast<u8 const*>(a.data()),
+             reinterpret_cast<u8 const*>(b.data()),
+             a.size()
+       );
+    // NOLINTEND(*-reinterpret-cast)
+  }
+
+  std::size_t ihash::operator()(std::string_view input) const noexcept {
+    // lowered in chunks on the stack, each chunk seeding the hash of the next
+    constexpr auto chunk = std::size_t(64);
+    char buffer[chunk];  // NOLINT(*-avoid-c-arrays)
+    auto hash = u64(0);
+    do {  // NOLINT(*-avoid-do-while)
+      auto const part = input.substr(0, chunk);
+      flip_case(part, buffer, 'A');
+      hash = crypto::fast_hash64(std::string_view(buffer, part.size()), hash);
+      input.remove_prefix(part.size());
+    } while(not input.empty());
+    return static_cast<std::size_t>(hash);
+  }
 }  // namespace rll
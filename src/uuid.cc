@@ -1,110 +1,418 @@
 #include <rll/uuid.h>
 
 #include <cstring>
-#include <iomanip>
 #include <iostream>
+#include <rll/uuid_generator.h>
 
-#if defined(RLL_OS_LINUX)
-#  include <uuid/uuid.h>
-#elif defined(RLL_OS_ANDROID)
-#  include "oslayer/android/guid.h"
-#elif defined(RLL_OS_WINDOWS)
-#  include <objbase.h>
+#include "oslayer/cpu.h"
+
+#if defined(RLL_ARCH_X86_64)
+#  include <immintrin.h>
+#  define RLL_UUID_X86
 #endif
 
+namespace {
+  using namespace rll;
+
+  // offsets of the sixteen hex pairs in `xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx`
+  constexpr u8 pair_offsets[16] = {0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34};
+  constexpr u8 dash_offsets[4] = {8, 13, 18, 23};
+  constexpr char hex_digits[] = "0123456789abcdef";
+
+  constexpr std::array<u8, 256> make_hex_values() noexcept {
+    auto res = std::array<u8, 256>();
+    for(auto& v : res)
+      v = 0xFF;
+    for(auto c = 0; c < 10; c++)
+      res[static_cast<std::size_t>('0' + c)] = static_cast<u8>(c);
+    for(auto c = 0; c < 6; c++) {
+      res[static_cast<std::size_t>('a' + c)] = static_cast<u8>(10 + c);
+      res[static_cast<std::size_t>('A' + c)] = static_cast<u8>(10 + c);
+    }
+    return res;
+  }
+
+  constexpr auto hex_values = make_hex_values();
+
+  // NOLINTBEGIN(*-pointer-arithmetic, *-constant-array-index)
+  void format_portable(u8 const* in, char* out) noexcept {
+    for(auto i = 0; i < 16; i++) {
+      out[pair_offsets[i]] = hex_digits[in[i] >> 4U];
+      out[pair_offsets[i] + 1] = hex_digits[in[i] & 0x0FU];
+    }
+    for(auto const d : dash_offsets)
+      out[d] = '-';
+  }
+
+  bool parse_portable(char const* in, u8* out) noexcept {
+    auto invalid = 0U;
+    for(auto i = 0; i < 16; i++) {
+      auto const hi = hex_values[static_cast<u8>(in[pair_offsets[i]])];
+      auto const lo = hex_values[static_cast<u8>(in[pair_offsets[i] + 1])];
+      invalid |= hi | lo;
+      out[i] = static_cast<u8>((hi << 4U) | (lo & 0x0FU));
+    }
+    for(auto const d : dash_offsets)
+      invalid |= static_cast<unsigned>(in[d] != '-') << 7U;
+    return (invalid & 0xF0U) == 0;
+  }
+
+#if defined(RLL_UUID_X86)
+  // Spreads the 16 bytes into 32 nibbles, maps them to ascii with a pshufb lookup and shuffles
+  // the hyphens in.
+  ___target___("ssse3") void format_ssse3(u8 const* in, char* out) noexcept {
+    auto const v = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in));
+    auto const nibble = _mm_set1_epi8(0x0F);
+    auto const hi = _mm_and_si128(_mm_srli_epi16(v, 4), nibble);
+    auto const lo = _mm_and_si128(v, nibble);
+    auto const digits =
+      _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    auto const a = _mm_shuffle_epi8(digits, _mm_unpacklo_epi8(hi, lo));  // digits 0..15
+    auto const b = _mm_shuffle_epi8(digits, _mm_unpackhi_epi8(hi, lo));  // digits 16..31
+    auto const head = _mm_or_si128(
+      _mm_shuffle_epi8(a, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1, 12, 13)),
+      _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, '-', 0, 0, 0, 0, '-', 0, 0)
+    );
+    auto const middle = _mm_or_si128(
+      _mm_shuffle_epi8(
+        _mm_alignr_epi8(b, a, 14),
+        _mm_setr_epi8(0, 1, -1, 2, 3, 4, 5, -1, 6, 7, 8, 9, 10, 11, 12, 13)
+      ),
+      _mm_setr_epi8(0, 0, '-', 0, 0, 0, 0, '-', 0, 0, 0, 0, 0, 0, 0, 0)
+    );
+    auto const tail = _mm_cvtsi128_si32(_mm_srli_si128(b, 12));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), head);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16), middle);
+    std::memcpy(out + 32, &tail, 4);
+  }
+
+  // Converts 16 ascii hex digits to nibbles; `valid` is set to 0xFF for every hex digit.
+  ___target___("ssse3") __m128i hex_nibbles_ssse3(__m128i const c, __m128i& valid) noexcept {
+    auto const digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+    auto const letter = _mm_sub_epi8(_mm_or_si128(c, _mm_set1_epi8(0x20)), _mm_set1_epi8('a'));
+    auto const is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, _mm_set1_epi8(9)), digit);
+    auto const is_letter = _mm_cmpeq_epi8(_mm_min_epu8(letter, _mm_set1_epi8(5)), letter);
+    valid = _mm_or_si128(is_digit, is_letter);
+    return _mm_or_si128(
+      _mm_and_si128(is_digit, digit),
+      _mm_and_si128(is_letter, _mm_add_epi8(letter, _mm_set1_epi8(10)))
+    );
+  }
+
+  // Gathers the 32 hex digits into two registers, decodes them and joins nibble pairs with
+  // pmaddubsw. Never reads past the 36 characters.
+  ___target___("ssse3") bool parse_ssse3(char const* in, u8* out) noexcept {
+    auto const l = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in));
+    auto const m = _mm_loadu_si128(reinterpret_cast<__m128i const*>(in + 16));
+    auto t = 0;
+    std::memcpy(&t, in + 32, 4);
+    auto const a = _mm_or_si128(
+      _mm_shuffle_epi8(l, _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 14, 15, -1, -1)),
+      _mm_shuffle_epi8(
+        m,
+        _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 1)
+      )
+    );
+    auto const b = _mm_or_si128(
+      _mm_shuffle_epi8(m, _mm_setr_epi8(3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1)),
+      _mm_slli_si128(_mm_cvtsi32_si128(t), 12)
+    );
+    auto valid_a = __m128i();
+    auto valid_b = __m128i();
+    auto const na = hex_nibbles_ssse3(a, valid_a);
+    auto const nb = hex_nibbles_ssse3(b, valid_b);
+    auto const weights = _mm_set1_epi16(0x0110);
+    auto const bytes =
+      _mm_packus_epi16(_mm_maddubs_epi16(na, weights), _mm_maddubs_epi16(nb, weights));
+    auto const dash = _mm_set1_epi8('-');
+    auto const dashes = (_mm_movemask_epi8(_mm_cmpeq_epi8(l, dash)) & 0x2100)
+                      | (_mm_movemask_epi8(_mm_cmpeq_epi8(m, dash)) & 0x0084) << 16;
+    auto const digits = _mm_movemask_epi8(_mm_and_si128(valid_a, valid_b));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), bytes);
+    return digits == 0xFFFF and dashes == 0x00842100;
+  }
+
+  // Two uuids at once, one per 128-bit lane; same steps as the ssse3 kernels.
+  ___target___("avx2") __m256i load_pair(void const* lo, void const* hi) noexcept {
+    return _mm256_inserti128_si256(
+      _mm256_castsi128_si256(_mm_loadu_si128(static_cast<__m128i const*>(lo))),
+      _mm_loadu_si128(static_cast<__m128i const*>(hi)),
+      1
+    );
+  }
+
+  ___target___("avx2") void format_pair_avx2(u8 const* in0, u8 const* in1, char* out0, char* out1)
+    noexcept {
+    auto const v = load_pair(in0, in1);
+    auto const nibble = _mm256_set1_epi8(0x0F);
+    auto const hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble);
+    auto const lo = _mm256_and_si256(v, nibble);
+    auto const digits = _mm256_broadcastsi128_si256(
+      _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f')
+    );
+    auto const a = _mm256_shuffle_epi8(digits, _mm256_unpacklo_epi8(hi, lo));
+    auto const b = _mm256_shuffle_epi8(digits, _mm256_unpackhi_epi8(hi, lo));
+    auto const head = _mm256_or_si256(
+      _mm256_shuffle_epi8(
+        a,
+        _mm256_broadcastsi128_si256(
+          _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, -1, 8, 9, 10, 11, -1, 12, 13)
+        )
+      ),
+      _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, '-', 0, 0, 0, 0, '-', 0, 0)
+      )
+    );
+    auto const middle = _mm256_or_si256(
+      _mm256_shuffle_epi8(
+        _mm256_alignr_epi8(b, a, 14),
+        _mm256_broadcastsi128_si256(
+          _mm_setr_epi8(0, 1, -1, 2, 3, 4, 5, -1, 6, 7, 8, 9, 10, 11, 12, 13)
+        )
+      ),
+      _mm256_broadcastsi128_si256(
+        _mm_setr_epi8(0, 0, '-', 0, 0, 0, 0, '-', 0, 0, 0, 0, 0, 0, 0, 0)
+      )
+    );
+    auto const tail = _mm256_srli_si256(b, 12);
+    auto const tail0 = _mm_cvtsi128_si32(_mm256_castsi256_si128(tail));
+    auto const tail1 = _mm_cvtsi128_si32(_mm256_extracti128_si256(tail, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out0), _mm256_castsi256_si128(head));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out0 + 16), _mm256_castsi256_si128(middle));
+    std::memcpy(out0 + 32, &tail0, 4);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out1), _mm256_extracti128_si256(head, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out1 + 16), _mm256_extracti128_si256(middle, 1));
+    std::memcpy(out1 + 32, &tail1, 4);
+  }
+
+  ___target___("avx2") __m256i hex_nibbles_avx2(__m256i const c, __m256i& valid) noexcept {
+    auto const digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+    auto const letter =
+      _mm256_sub_epi8(_mm256_or_si256(c, _mm256_set1_epi8(0x20)), _mm256_set1_epi8('a'));
+    auto const is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, _mm256_set1_epi8(9)), digit);
+    auto const is_letter =
+      _mm256_cmpeq_epi8(_mm256_min_epu8(letter, _mm256_set1_epi8(5)), letter);
+    valid = _mm256_or_si256(is_digit, is_letter);
+    return _mm256_or_si256(
+      _mm256_and_si256(is_digit, digit),
+      _mm256_and_si256(is_letter, _mm256_add_epi8(letter, _mm256_set1_epi8(10)))
+    );
+  }
+
+  // Returns a two-bit mask of the valid strings; bytes are stored for both.
+  ___target___("avx2") unsigned
+    parse_pair_avx2(char const* in0, char const* in1, u8* out0, u8* out1) noexcept {
+    auto const l = load_pair(in0, in1);
+    auto const m = load_pair(in0 + 16, in1 + 16);
+    auto t0 = 0;
+    auto t1 = 0;
+    std::memcpy(&t0, in0 + 32, 4);
+    std::memcpy(&t1, in1 + 32, 4);
+    auto const a = _mm256_or_si256(
+      _mm256_shuffle_epi8(
+        l,
+        _mm256_broadcastsi128_si256(
+          _mm_setr_epi8(0, 1, 2, 3, 4, 5, 6, 7, 9, 10, 11, 12, 14, 15, -1, -1)
+        )
+      ),
+      _mm256_shuffle_epi8(
+        m,
+        _mm256_broadcastsi128_si256(
+          _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, 0, 1)
+        )
+      )
+    );
+    auto const b = _mm256_or_si256(
+      _mm256_shuffle_epi8(
+        m,
+        _mm256_broadcastsi128_si256(
+          _mm_setr_epi8(3, 4, 5, 6, 8, 9, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1)
+        )
+      ),
+      _mm256_setr_epi32(0, 0, 0, t0, 0, 0, 0, t1)
+    );
+    auto valid_a = __m256i();
+    auto valid_b = __m256i();
+    auto const na = hex_nibbles_avx2(a, valid_a);
+    auto const nb = hex_nibbles_avx2(b, valid_b);
+    auto const weights = _mm256_set1_epi16(0x0110);
+    auto const bytes =
+      _mm256_packus_epi16(_mm256_maddubs_epi16(na, weights), _mm256_maddubs_epi16(nb, weights));
+    auto const dash = _mm256_set1_epi8('-');
+    auto const dashes_l = static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(l, dash)));
+    auto const dashes_m = static_cast<u32>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(m, dash)));
+    auto const digits =
+      static_cast<u32>(_mm256_movemask_epi8(_mm256_and_si256(valid_a, valid_b)));
+    auto const ok = [&](unsigned const lane) {
+      auto const shift = 16 * lane;
+      return static_cast<unsigned>(
+        ((digits >> shift) & 0xFFFFU) == 0xFFFFU and ((dashes_l >> shift) & 0x2100U) == 0x2100U
+        and ((dashes_m >> shift) & 0x0084U) == 0x0084U
+      );
+    };
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out0), _mm256_castsi256_si128(bytes));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out1), _mm256_extracti128_si256(bytes, 1));
+    return ok(0) | (ok(1) << 1U);
+  }
+
+  void format_n_avx2(uuid const* ids, std::size_t const count, char* out, std::size_t const stride)
+    noexcept {
+    auto i = std::size_t(0);
+    for(; i + 2 <= count; i += 2, out += 2 * stride)
+      format_pair_avx2(ids[i].bytes().data(), ids[i + 1].bytes().data(), out, out + stride);
+    if(i < count)
+      format_ssse3(ids[i].bytes().data(), out);
+  }
+
+  std::size_t
+    parse_n_avx2(char const* in, std::size_t const count, uuid* out, std::size_t const stride)
+      noexcept {
+    auto i = std::size_t(0);
+    for(; i + 2 <= count; i += 2, in += 2 * stride) {
+      auto parsed = std::array<uuid, 2>();
+      auto const valid = parse_pair_avx2(
+        in,
+        in + stride,
+        parsed[0].bytes_mut().data(),
+        parsed[1].bytes_mut().data()
+      );
+      if(valid & 1U)
+        out[i] = parsed[0];
+      if(valid != 3U)
+        return i + (valid & 1U);
+      out[i + 1] = parsed[1];
+    }
+    if(i < count) {
+      auto parsed = uuid();
+      if(parse_ssse3(in, parsed.bytes_mut().data()))
+        out[i++] = parsed;
+    }
+    return i;
+  }
+#endif
+
+  template <void (*Format)(u8 const*, char*) noexcept>
+  void format_n(uuid const* ids, std::size_t const count, char* out, std::size_t const stride)
+    noexcept {
+    for(auto i = std::size_t(0); i < count; i++, out += stride)
+      Format(ids[i].bytes().data(), out);
+  }
+
+  template <bool (*Parse)(char const*, u8*) noexcept>
+  std::size_t parse_n(char const* in, std::size_t const count, uuid* out, std::size_t const stride)
+    noexcept {
+    auto i = std::size_t(0);
+    for(auto parsed = uuid(); i < count; i++, in += stride) {
+      if(not Parse(in, parsed.bytes_mut().data()))
+        break;
+      out[i] = parsed;
+    }
+    return i;
+  }
+
+  struct uuid_codec {
+    void (*format)(u8 const*, char*) noexcept;
+    bool (*parse)(char const*, u8*) noexcept;
+    void (*format_n)(uuid const*, std::size_t, char*, std::size_t) noexcept;
+    std::size_t (*parse_n)(char const*, std::size_t, uuid*, std::size_t) noexcept;
+  };
+
+  template <void (*Format)(u8 const*, char*) noexcept, bool (*Parse)(char const*, u8*) noexcept>
+  constexpr uuid_codec make_codec() noexcept {
+    return {Format, Parse, format_n<Format>, parse_n<Parse>};
+  }
+
+  uuid_codec select_codec() noexcept {
+#if defined(RLL_UUID_X86)
+    if(oslayer::cpu().avx2)
+      return {format_ssse3, parse_ssse3, format_n_avx2, parse_n_avx2};
+    if(oslayer::cpu().ssse3)
+      return make_codec<format_ssse3, parse_ssse3>();
+#endif
+    return make_codec<format_portable, parse_portable>();
+  }
+
+  uuid_codec const& active_codec() noexcept {
+    static auto const codec = select_codec();
+    return codec;
+  }
+  // NOLINTEND(*-pointer-arithmetic, *-constant-array-index)
+}  // namespace
+
 namespace rll {
   uuid::uuid(std::array<std::byte, 16> const& bytes) {
     std::memcpy(this->bytes_.data(), bytes.data(), 16);
   }
 
   std::string uuid::to_string() const {
-    return fmt::format(
-      "{:02x}{:02x}{:02x}{:02x}-{:02x}{:02x}-{:02x}{:02x}-{:02x}{:02x}-{:02x}{:02x}{:02x}{:02x}{:"
-      "02x}{:02x}",
-      this->bytes_[0],
-      this->bytes_[1],
-      this->bytes_[2],
-      this->bytes_[3],
-      this->bytes_[4],
-      this->bytes_[5],
-      this->bytes_[6],
-      this->bytes_[7],
-      this->bytes_[8],
-      this->bytes_[9],
-      this->bytes_[10],
-      this->bytes_[11],
-      this->bytes_[12],
-      this->bytes_[13],
-      this->bytes_[14],
-      this->bytes_[15]
-    );
+    auto res = std::string(uuid::short_guid_string_length, '\0');
+    this->to_chars(res.data());
+    return res;
   }
 
   std::ostream& operator<<(std::ostream& os, uuid const& guid) {
-    auto flags = os.flags();
-    os << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(guid.bytes()[0])
-       << std::setw(2) << static_cast<int>(guid.bytes()[1]) << std::setw(2)
-       << static_cast<int>(guid.bytes()[2]) << std::setw(2) << static_cast<int>(guid.bytes()[3])
-       << "-" << std::setw(2) << static_cast<int>(guid.bytes()[4]) << std::setw(2)
-       << static_cast<int>(guid.bytes()[5]) << "-" << std::setw(2)
-       << static_cast<int>(guid.bytes()[6]) << std::setw(2) << static_cast<int>(guid.bytes()[7])
-       << "-" << std::setw(2) << static_cast<int>(guid.bytes()[8]) << std::setw(2)
-       << static_cast<int>(guid.bytes()[9]) << "-" << std::setw(2)
-       << static_cast<int>(guid.bytes()[10]) << std::setw(2) << static_cast<int>(guid.bytes()[11])
-       << std::setw(2) << static_cast<int>(guid.bytes()[12]) << std::setw(2)
-       << static_cast<int>(guid.bytes()[13]) << std::setw(2) << static_cast<int>(guid.bytes()[14])
-       << std::setw(2) << static_cast<int>(guid.bytes()[15]);
-    os.flags(flags);
-    return os;
-  }
-
-  uuid uuid::random() noexcept {
-#if defined(RLL_OS_LINUX)
-    static_assert(
-      std::is_same_v<unsigned char[16], uuid_t>,
-      "rll::uuid: uuid_t is not unsigned char[16]"
-    );  // NOLINT(*-avoid-c-arrays)
-
-    auto data = std::array<u8, 16>();
-    ::uuid_generate(data.data());
-    return uuid(data);
-#elif defined(RLL_OS_ANDROID)
-#  warning "rll::uuid::random() is currently not implemented for Android"
-    return uuid({0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0});
-#elif defined(RLL_OS_WINDOWS)
-    auto new_id = GUID();
-    ::CoCreateGuid(&new_id);
-    auto data = std::array<u8, 16> {
-      static_cast<u8>(new_id.Data1 >> 24 & 0xFF),
-      static_cast<u8>(new_id.Data1 >> 16 & 0xFF),
-      static_cast<u8>(new_id.Data1 >> 8 & 0xFF),
-      static_cast<u8>(new_id.Data1 & 0xFF),
-      static_cast<u8>(new_id.Data2 >> 8 & 0xFF),
-      static_cast<u8>(new_id.Data2 & 0xFF),
-      static_cast<u8>(new_id.Data3 >> 8 & 0xFF),
-      static_cast<u8>(new_id.Data3 & 0xFF),
-      static_cast<u8>(new_id.Data4[0]),
-      static_cast<u8>(new_id.Data4[1]),
-      static_cast<u8>(new_id.Data4[2]),
-      static_cast<u8>(new_id.Data4[3]),
-      static_cast<u8>(new_id.Data4[4]),
-      static_cast<u8>(new_id.Data4[5]),
-      static_cast<u8>(new_id.Data4[6]),
-      static_cast<u8>(new_id.Data4[7])
-    };
-    return uuid(data);
-#endif  // RLL_OS_LINUX
+    char buf[uuid::short_guid_string_length];  // NOLINT(*-avoid-c-arrays)
+    guid.to_chars(buf);
+    return os.write(buf, sizeof(buf));
   }
 
-  result<uuid> uuid::try_parse(std::string_view str) noexcept {
-    try {
-      return uuid(str);
-    } catch (std::exception const& e) {
-      return error("rll::uuid::try_parse: {}", e.what());
+  char* uuid::to_chars(char* out) const noexcept {
+    active_codec().format(this->bytes_.data(), out);
+    return out + uuid::short_guid_string_length;  // NOLINT(*-pointer-arithmetic)
+  }
+
+  void uuid::to_chars_n(
+    uuid const* ids,
+    std::size_t const count,
+    char* out,
+    std::size_t const stride
+  ) noexcept {
+    active_codec().format_n(ids, count, out, stride);
+  }
+
+  bool uuid::from_chars(std::string_view str, uuid& out) noexcept {
+    if(str.size() == uuid::long_guid_string_length) {
+      if(str.front() != '{' or str.back() != '}')
+        return false;
+      str = str.substr(1, uuid::short_guid_string_length);
     }
+    if(str.size() != uuid::short_guid_string_length)
+      return false;
+    auto parsed = uuid();
+    if(not active_codec().parse(str.data(), parsed.bytes_.data()))
+      return false;
+    out = parsed;
+    return true;
+  }
+
+  std::size_t uuid::from_chars_n(
+    char const* in,
+    std::size_t const count,
+    uuid* out,
+    std::size_t const stride
+  ) noexcept {
+    return active_codec().parse_n(in, count, out, stride);
   }
 
-  u64 uuid::to_u64() const noexcept {
-    return detail::hash<rll::u64, rll::u64> {}(bytes()[0], bytes()[1]);
+  uuid uuid::random() noexcept { return uuid_generator::local()(); }
+
+  uuid uuid::v7() noexcept { return uuid_generator::local().v7(); }
+
+  std::chrono::system_clock::time_point uuid::timestamp() const noexcept {
+    auto ms = u64();
+    for(auto i = std::size_t(0); i < 6; i++)
+      ms = (ms << 8U) | this->bytes_[i];
+    return std::chrono::system_clock::time_point(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+        std::chrono::milliseconds(ms)
+      )
+    );
+  }
+
+  result<uuid> uuid::try_parse(std::string_view str) noexcept {
+    auto res = uuid();
+    if(not uuid::from_chars(str, res))
+      return error("rll::uuid::try_parse: invalid uuid string '{}'", str);
+    return res;
   }
 }  // namespace rll
@@ -0,0 +1,299 @@
+#include <rll/uuid_generator.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <thread>
+
+#include "oslayer/random.h"
+
+#if not defined(RLL_OS_WINDOWS)
+#  include <pthread.h>
+#endif
+#if defined(RLL_ARCH_X86_64)
+#  include <emmintrin.h>
+#endif
+
+namespace {
+  using namespace rll;
+
+  constexpr auto lanes = std::size_t(4);
+
+  /**
+   * Writes `lanes` consecutive ChaCha20 blocks (64-bit block counter, zero nonce) to `out`. The
+   * lanes are computed side by side, each state word of all blocks in one vector register.
+   */
+#if defined(RLL_ARCH_X86_64)
+  // SSE2 is part of the x86-64 baseline, so no runtime dispatch is needed
+  void chacha20_blocks(std::array<u32, 8> const& key, u64 const counter, u8* out) noexcept {
+    auto const word = [](u64 const v) { return static_cast<int>(static_cast<u32>(v)); };
+    __m128i x[16];  // NOLINT(*-avoid-c-arrays)
+    x[0] = _mm_set1_epi32(0x61707865);
+    x[1] = _mm_set1_epi32(0x3320646e);
+    x[2] = _mm_set1_epi32(0x79622d32);
+    x[3] = _mm_set1_epi32(0x6b206574);
+    for(auto i = std::size_t(0); i < key.size(); i++)
+      x[4 + i] = _mm_set1_epi32(static_cast<int>(key[i]));
+    x[12] = _mm_set_epi32(word(counter + 3), word(counter + 2), word(counter + 1), word(counter));
+    x[13] = _mm_set_epi32(
+      word((counter + 3) >> 32),
+      word((counter + 2) >> 32),
+      word((counter + 1) >> 32),
+      word(counter >> 32)
+    );
+    x[14] = _mm_setzero_si128();
+    x[15] = _mm_setzero_si128();
+    __m128i s[16];  // NOLINT(*-avoid-c-arrays)
+    for(auto i = 0; i < 16; i++)
+      s[i] = x[i];
+
+    auto const quarter = [&x](int const a, int const b, int const c, int const d) {
+      auto const rotl = [](__m128i const v, int const n) {
+        return _mm_or_si128(_mm_slli_epi32(v, n), _mm_srli_epi32(v, 32 - n));
+      };
+      x[a] = _mm_add_epi32(x[a], x[b]);
+      x[d] = rotl(_mm_xor_si128(x[d], x[a]), 16);
+      x[c] = _mm_add_epi32(x[c], x[d]);
+      x[b] = rotl(_mm_xor_si128(x[b], x[c]), 12);
+      x[a] = _mm_add_epi32(x[a], x[b]);
+      x[d] = rotl(_mm_xor_si128(x[d], x[a]), 8);
+      x[c] = _mm_add_epi32(x[c], x[d]);
+      x[b] = rotl(_mm_xor_si128(x[b], x[c]), 7);
+    };
+    for(auto round = 0; round < 10; round++) {
+      quarter(0, 4, 8, 12);
+      quarter(1, 5, 9, 13);
+      quarter(2, 6, 10, 14);
+      quarter(3, 7, 11, 15);
+      quarter(0, 5, 10, 15);
+      quarter(1, 6, 11, 12);
+      quarter(2, 7, 8, 13);
+      quarter(3, 4, 9, 14);
+    }
+
+    // transpose 4x4 groups of words so that each lane becomes one contiguous block
+    for(auto i = 0; i < 16; i += 4) {
+      auto const a = _mm_add_epi32(x[i], s[i]);
+      auto const b = _mm_add_epi32(x[i + 1], s[i + 1]);
+      auto const c = _mm_add_epi32(x[i + 2], s[i + 2]);
+      auto const d = _mm_add_epi32(x[i + 3], s[i + 3]);
+      auto const ab_lo = _mm_unpacklo_epi32(a, b);
+      auto const ab_hi = _mm_unpackhi_epi32(a, b);
+      auto const cd_lo = _mm_unpacklo_epi32(c, d);
+      auto const cd_hi = _mm_unpackhi_epi32(c, d);
+      // NOLINTBEGIN(*-pointer-arithmetic, *-reinterpret-cast)
+      auto* dst = out + 4 * i;
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_unpacklo_epi64(ab_lo, cd_lo));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 64), _mm_unpackhi_epi64(ab_lo, cd_lo));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 128), _mm_unpacklo_epi64(ab_hi, cd_hi));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 192), _mm_unpackhi_epi64(ab_hi, cd_hi));
+      // NOLINTEND(*-pointer-arithmetic, *-reinterpret-cast)
+    }
+  }
+#else
+  void chacha20_blocks(std::array<u32, 8> const& key, u64 const counter, u8* out) noexcept {
+    u32 x[16][lanes];  // NOLINT(*-avoid-c-arrays)
+    for(auto l = std::size_t(0); l < lanes; l++) {
+      x[0][l] = 0x61707865;
+      x[1][l] = 0x3320646e;
+      x[2][l] = 0x79622d32;
+      x[3][l] = 0x6b206574;
+      for(auto i = std::size_t(0); i < key.size(); i++)
+        x[4 + i][l] = key[i];
+      x[12][l] = static_cast<u32>(counter + l);
+      x[13][l] = static_cast<u32>((counter + l) >> 32);
+      x[14][l] = 0;
+      x[15][l] = 0;
+    }
+    u32 s[16][lanes];  // NOLINT(*-avoid-c-arrays)
+    std::memcpy(s, x, sizeof(x));
+
+    auto const quarter = [&x](int const a, int const b, int const c, int const d) {
+      auto const rotl = [](u32 const v, int const n) { return (v << n) | (v >> (32 - n)); };
+      for(auto l = std::size_t(0); l < lanes; l++) {
+        x[a][l] += x[b][l];
+        x[d][l] = rotl(x[d][l] ^ x[a][l], 16);
+        x[c][l] += x[d][l];
+        x[b][l] = rotl(x[b][l] ^ x[c][l], 12);
+        x[a][l] += x[b][l];
+        x[d][l] = rotl(x[d][l] ^ x[a][l], 8);
+        x[c][l] += x[d][l];
+        x[b][l] = rotl(x[b][l] ^ x[c][l], 7);
+      }
+    };
+    for(auto round = 0; round < 10; round++) {
+      quarter(0, 4, 8, 12);
+      quarter(1, 5, 9, 13);
+      quarter(2, 6, 10, 14);
+      quarter(3, 7, 11, 15);
+      quarter(0, 5, 10, 15);
+      quarter(1, 6, 11, 12);
+      quarter(2, 7, 8, 13);
+      quarter(3, 4, 9, 14);
+    }
+
+    for(auto l = std::size_t(0); l < lanes; l++)
+      for(auto i = std::size_t(0); i < 16; i++) {
+        auto const word = x[i][l] + s[i][l];
+        auto* p = out + 64 * l + 4 * i;  // NOLINT(*-pointer-arithmetic)
+        p[0] = static_cast<u8>(word);
+        p[1] = static_cast<u8>(word >> 8);
+        p[2] = static_cast<u8>(word >> 16);
+        p[3] = static_cast<u8>(word >> 24);
+      }
+  }
+#endif
+
+  /// Sets the RFC 4122 version 4 and variant bits.
+  void stamp_v4(u8* bytes) noexcept {
+    bytes[6] = static_cast<u8>((bytes[6] & 0x0F) | 0x40);
+    bytes[8] = static_cast<u8>((bytes[8] & 0x3F) | 0x80);  // NOLINT(*-pointer-arithmetic)
+  }
+
+  // incremented in the child after every fork(), so generators notice the copied key
+  std::atomic<u64> fork_generation {0};
+
+#if not defined(RLL_OS_WINDOWS)
+  void on_fork_child() noexcept { fork_generation.fetch_add(1, std::memory_order_relaxed); }
+
+  [[maybe_unused]] bool const fork_handler_registered = [] {
+    return ::pthread_atfork(nullptr, nullptr, on_fork_child) == 0;
+  }();
+#endif
+}  // namespace
+
+namespace rll {
+  uuid_generator::uuid_generator() noexcept
+    : system_seeded_(true) {
+    this->reseed();
+  }
+
+  uuid_generator::uuid_generator(std::array<u8, 32> const& seed) noexcept {
+    for(auto i = std::size_t(0); i < this->key_.size(); i++)
+      this->key_[i] = static_cast<u32>(seed[4 * i]) | (static_cast<u32>(seed[4 * i + 1]) << 8)
+                    | (static_cast<u32>(seed[4 * i + 2]) << 16)
+                    | (static_cast<u32>(seed[4 * i + 3]) << 24);
+  }
+
+  uuid uuid_generator::operator()() noexcept {
+    if(this->next_ == buffered or this->forked())
+      this->refill();
+    auto res = uuid();
+    std::memcpy(res.bytes_mut().data(), this->buffer_.data() + 16 * this->next_++, 16);  // NOLINT
+    return res;
+  }
+
+  uuid uuid_generator::v7() noexcept {
+    if(this->forked()) {
+      this->refill();
+      this->last_ms_ = 0;
+    }
+    auto const random = (*this)();
+    auto const& r = random.bytes();
+    auto const now = static_cast<u64>(
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()
+      )
+        .count()
+    );
+    constexpr auto sequence_bits = 42U;
+    if(now > this->last_ms_) {
+      // random start in the lower half leaves room for at least 2^41 ids in this millisecond
+      this->last_ms_ = now;
+      this->sequence_ = 0;
+      for(auto i = std::size_t(0); i < 6; i++)
+        this->sequence_ = (this->sequence_ << 8U) | r[i];
+      this->sequence_ &= (u64(1) << (sequence_bits - 1)) - 1;
+    } else if(++this->sequence_ == (u64(1) << sequence_bits)) {
+      // same millisecond (or the clock stepped back) and the counter is exhausted
+      ++this->last_ms_;
+      this->sequence_ = 0;
+    }
+
+    auto res = uuid();
+    auto& bytes = res.bytes_mut();
+    for(auto i = std::size_t(0); i < 6; i++)
+      bytes[i] = static_cast<u8>(this->last_ms_ >> (8 * (5 - i)));
+    auto const seq = this->sequence_;
+    bytes[6] = static_cast<u8>(0x70U | ((seq >> 38U) & 0x0FU));
+    bytes[7] = static_cast<u8>(seq >> 30U);
+    bytes[8] = static_cast<u8>(0x80U | ((seq >> 24U) & 0x3FU));
+    bytes[9] = static_cast<u8>(seq >> 16U);
+    bytes[10] = static_cast<u8>(seq >> 8U);
+    bytes[11] = static_cast<u8>(seq);
+    for(auto i = std::size_t(12); i < 16; i++)
+      bytes[i] = r[i];
+    return res;
+  }
+
+  void uuid_generator::generate_n(uuid* out, std::size_t count) noexcept {
+    if(this->forked())
+      this->refill();
+    // NOLINTBEGIN(*-pointer-arithmetic)
+    for(; count > 0 and this->next_ < buffered; --count)
+      *out++ = (*this)();
+    auto block = std::array<u8, 64 * lanes>();
+    for(; count >= buffered; count -= buffered) {
+      chacha20_blocks(this->key_, this->counter_, block.data());
+      this->counter_ += lanes;
+      for(auto i = std::size_t(0); i < buffered; i++) {
+        stamp_v4(block.data() + 16 * i);
+        std::memcpy(out++->bytes_mut().data(), block.data() + 16 * i, 16);
+      }
+    }
+    for(; count > 0; --count)
+      *out++ = (*this)();
+    // NOLINTEND(*-pointer-arithmetic)
+  }
+
+  std::vector<uuid> uuid_generator::generate_n(std::size_t const count) {
+    auto res = std::vector<uuid>(count);
+    this->generate_n(res.data(), res.size());
+    return res;
+  }
+
+  uuid_generator& uuid_generator::local() noexcept {
+    thread_local auto generator = uuid_generator();
+    return generator;
+  }
+
+  void uuid_generator::reseed() noexcept {
+    this->fork_generation_ = fork_generation.load(std::memory_order_relaxed);
+    this->counter_ = 0;
+    this->next_ = buffered;
+    if(oslayer::system_random(this->key_.data(), sizeof(this->key_)))
+      return;
+
+    // no operating system source: the best effort left is the standard library device mixed with
+    // the clock and the thread id
+    auto seed = std::seed_seq {
+      static_cast<u32>(std::chrono::high_resolution_clock::now().time_since_epoch().count()),
+      static_cast<u32>(std::hash<std::thread::id> {}(std::this_thread::get_id())),
+      static_cast<u32>(reinterpret_cast<std::uintptr_t>(this)),  // NOLINT
+      static_cast<u32>([] {
+        try {
+          return std::random_device {}();
+        } catch(...) {
+          return 0U;
+        }
+      }())
+    };
+    seed.generate(this->key_.begin(), this->key_.end());
+  }
+
+  void uuid_generator::refill() noexcept {
+    if(this->forked())
+      this->reseed();
+    chacha20_blocks(this->key_, this->counter_, this->buffer_.data());
+    this->counter_ += lanes;
+    for(auto i = std::size_t(0); i < buffered; i++)
+      stamp_v4(this->buffer_.data() + 16 * i);  // NOLINT(*-pointer-arithmetic)
+    this->next_ = 0;
+  }
+
+  bool uuid_generator::forked() const noexcept {
+    return this->system_seeded_
+       and this->fork_generation_ != fork_generation.load(std::memory_order_relaxed);
+  }
+}  // namespace rll
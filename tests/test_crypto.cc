@@ -1,5 +1,8 @@
 #include <catch2/catch_all.hpp>
+#include <set>
 #include <rll/crypto.h>
+#include <rll/fixed_string.h>
+#include <rll/io/filedevice.h>
 
 using namespace rll;
 using namespace std::string_literals;
@@ -9,12 +12,338 @@ TEST_CASE("Crypto", "[crypto]") {
     auto const test_string = "123123"s;
     auto hasher = crypto::md5();
     hasher << test_string;
-    REQUIRE(hasher.hash_string() == "d3c8ce0ea199ba5b1f9f80a3f3dd5ab2");
-    REQUIRE(hasher.hash_string() == "d3c8ce0ea199ba5b1f9f80a3f3dd5ab2");
-    REQUIRE(hasher.hash_uuid() == "{d3c8ce0e-a199-ba5b-1f9f-80a3f3dd5ab2}"_uuid);
+    REQUIRE(hasher.hash_string() == "4297f44b13955235245b2497399d7a93");
+    REQUIRE(hasher.hash_string() == "4297f44b13955235245b2497399d7a93");
+    REQUIRE(hasher.hash_uuid() == "{4297f44b-1395-5235-245b-2497399d7a93}"_uuid);
     hasher << 32;
-    REQUIRE(hasher.hash_string() == "c917288ccbb30ecc5935710c30774e0c");
-    REQUIRE(hasher.hash_string() == "c917288ccbb30ecc5935710c30774e0c");
-    REQUIRE(hasher.hash_uuid() == "{c917288c-cbb3-0ecc-5935-710c30774e0c}"_uuid);
+    REQUIRE(hasher.hash_string() == "ae626a028d3b8818f85c77d1de4dca8b");
+    REQUIRE(hasher.hash_string() == "ae626a028d3b8818f85c77d1de4dca8b");
+    REQUIRE(hasher.hash_uuid() == "{ae626a02-8d3b-8818-f85c-77d1de4dca8b}"_uuid);
   }  // MD5
+
+  SECTION("MD5 batch") {
+    auto storage = std::vector<std::string>();
+    for(auto i = 0; i < 300; i++)
+      storage.emplace_back(static_cast<std::size_t>(i * 7 % 211), static_cast<char>('a' + i % 26));
+    auto const messages = std::vector<std::string_view>(storage.begin(), storage.end());
+    auto const digests = crypto::md5_batch(messages);
+
+    REQUIRE(crypto::md5_batch_lanes() >= 1);
+    REQUIRE(digests.size() == messages.size());
+    for(auto i = std::size_t(0); i < messages.size(); i++) {
+      auto hasher = crypto::md5();
+      hasher << messages[i];
+      REQUIRE(digests[i] == hasher.hash());
+    }
+    REQUIRE(crypto::md5_batch({}).empty());
+  }  // MD5 batch
+
+  SECTION("SHA1") {
+    auto hasher = crypto::sha1();
+    REQUIRE(hasher.hash_string() == "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+    hasher << "abc"s;
+    REQUIRE(hasher.hash_string() == "a9993e364706816aba3e25717850c26c9cd0d89d");
+    hasher.reset();
+    hasher << "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"s;
+    REQUIRE(hasher.hash_string() == "84983e441c3bd26ebaae4aa1f95129e5e54670f1");
+
+    auto const message = std::string(1000, 'a');
+    auto chunked = crypto::sha1();
+    for(auto i = std::size_t(0); i < message.size(); i += 37)
+      chunked.append(std::string_view(message).substr(i, 37));
+    hasher.reset();
+    hasher << message;
+    REQUIRE(chunked.hash() == hasher.hash());
+  }  // SHA1
+
+  SECTION("SHA256") {
+    auto hasher = crypto::sha256();
+    REQUIRE(hasher.hash_string() == "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855");
+    hasher << "abc"s;
+    REQUIRE(hasher.hash_string() == "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad");
+    hasher.reset();
+    hasher << "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"s;
+    REQUIRE(hasher.hash_string() == "248d6a61d20638b8e5c026930c3e6039a33ce45964ff2167f6ecedd419db06c1");
+
+    auto const message = std::string(1000, 'a');
+    auto chunked = crypto::sha256();
+    for(auto i = std::size_t(0); i < message.size(); i += 37)
+      chunked.append(std::string_view(message).substr(i, 37));
+    hasher.reset();
+    hasher << message;
+    REQUIRE(chunked.hash() == hasher.hash());
+  }  // SHA256
+
+  SECTION("Fast hash") {
+    static_assert(crypto::fast_hash64("rolly") != crypto::fast_hash64("rollz"));
+    static_assert(crypto::fast_hash128("rolly").lower() == crypto::fast_hash64("rolly"));
+
+    auto data = std::string(1000, '\0');
+    for(auto i = std::size_t(0); i < data.size(); i++)
+      data[i] = static_cast<char>(i * 131 + (i >> 7));
+    auto seen = std::set<u64>();
+    for(auto len = std::size_t(0); len <= 300; len++) {
+      auto const sv = std::string_view(data).substr(0, len);
+      auto const expected = crypto::fast_hash64(sv);
+      seen.insert(expected);
+      for(auto const chunk : {1, 15, 64, 65}) {
+        auto hasher = crypto::fast_hasher();
+        for(auto i = std::size_t(0); i < len; i += chunk)
+          hasher.append(sv.substr(i, chunk));
+        REQUIRE(hasher.hash() == expected);
+        REQUIRE(hasher.hash128() == crypto::fast_hash128(sv));
+      }
+    }
+    REQUIRE(seen.size() == 301);
+    REQUIRE(crypto::fast_hash64(data, 1) != crypto::fast_hash64(data, 2));
+
+    auto hasher = crypto::fast_hasher(7);
+    hasher << data;
+    hasher.reset();
+    REQUIRE(hasher.hash() == crypto::fast_hash64("", 7));
+    REQUIRE(std::hash<fixed_string<5>>()(fixed_string<5>("rolly")) == crypto::fast_hash64("rolly"));
+  }  // Fast hash
+
+  SECTION("Static hashers") {
+    struct field {
+      u32 id;
+      u16 kind;
+      f64 weight;
+    };
+
+    auto md5 = crypto::md5();
+    auto sha1 = crypto::sha1();
+    auto sha256 = crypto::sha256();
+    auto md5_engine = crypto::md5_engine();
+    auto sha1_engine = crypto::sha1_engine();
+    auto sha256_engine = crypto::sha256_engine();
+    for(auto i = 0U; i < 500; i++) {
+      auto const f = field {i, static_cast<u16>(i * 3), i * 0.5};
+      md5 << f.id << f.kind << f.weight;
+      sha1 << f.id << f.kind << f.weight;
+      sha256 << f.id << f.kind << f.weight;
+      md5_engine << f.id << f.kind << f.weight;
+      sha1_engine << f.id << f.kind << f.weight;
+      sha256_engine << f.id << f.kind << f.weight;
+    }
+    REQUIRE(md5_engine.hash() == md5.hash());
+    REQUIRE(md5_engine.hash_uuid() == md5.hash_uuid());
+    REQUIRE(sha1_engine.hash() == sha1.hash());
+    REQUIRE(sha256_engine.hash() == sha256.hash());
+
+    sha256_engine.reset();
+    sha256_engine << "abc";
+    REQUIRE(sha256_engine.hash() == crypto::sha256_engine().append("abc").hash());
+  }  // Static hashers
+
+  SECTION("Hash file") {
+    auto const path = std::filesystem::temp_directory_path() / "rolly-test-hash-file.bin";
+    auto content = std::string(3 * crypto::hash_file_chunk_size + 12'345, '\0');
+    for(auto i = std::size_t(0); i < content.size(); i++)
+      content[i] = static_cast<char>(i * 7 + (i >> 11));
+    io::filedevice(path).write(content);
+
+    auto md5 = crypto::md5();
+    md5 << std::string_view(content);
+    auto const md5_file = crypto::hash_file(path, crypto::hash_algorithm::md5);
+    REQUIRE(md5_file);
+    REQUIRE(md5_file->to_string() == md5.hash_string());
+    REQUIRE(md5_file->size == content.size());
+
+    auto sha256 = crypto::sha256();
+    sha256 << std::string_view(content);
+    auto const sha256_file = crypto::hash_file(path, crypto::hash_algorithm::sha256);
+    REQUIRE(sha256_file->to_string() == sha256.hash_string());
+
+    auto const single = crypto::hash_file(path, crypto::hash_algorithm::fast_tree, 1);
+    auto const multi = crypto::hash_file(path, crypto::hash_algorithm::fast_tree, 3);
+    REQUIRE(single);
+    REQUIRE(multi);
+    REQUIRE(single->threads == 1);
+    REQUIRE(multi->threads == 3);
+    REQUIRE(single->digest.size() == 16);
+    REQUIRE(single->digest == multi->digest);
+
+    auto const crc_single = crypto::hash_file(path, crypto::hash_algorithm::crc32c, 1);
+    auto const crc_multi = crypto::hash_file(path, crypto::hash_algorithm::crc32c, 4);
+    REQUIRE(crc_single->digest == crc_multi->digest);
+    REQUIRE(crc_multi->to_string()
+            == crypto::crc32c(crypto::crc32c::compute(content)).hash_string());
+    REQUIRE(crypto::hash_file(path, crypto::hash_algorithm::crc64, 2)->to_string()
+            == crypto::crc64(crypto::crc64::compute(content)).hash_string());
+
+    io::filedevice(path).write("");
+    REQUIRE(crypto::hash_file(path, crypto::hash_algorithm::sha1)->to_string()
+            == "da39a3ee5e6b4b0d3255bfef95601890afd80709");
+    std::filesystem::remove(path);
+    REQUIRE_FALSE(crypto::hash_file(path, crypto::hash_algorithm::md5));
+  }  // Hash file
+
+  SECTION("Constexpr MD5") {
+    static_assert(crypto::md5_uuid("") == "{d41d8cd9-8f00-b204-e980-0998ecf8427e}"_uuid);
+    static_assert("123123"_md5 == "{4297f44b-1395-5235-245b-2497399d7a93}"_uuid);
+    static_assert(crypto::md5_uuid(fixed_string<6>("123123")) == "123123"_md5);
+    static_assert(crypto::md5_u64("a") != crypto::md5_u64("b"));
+
+    auto const classify = [](std::string_view const name) {
+      switch(crypto::md5_u64(name)) {
+        case crypto::md5_u64("telemetry.frame"): return 1;
+        case crypto::md5_u64("telemetry.status"): return 2;
+        default: return 0;
+      }
+    };
+    REQUIRE(classify("telemetry.status") == 2);
+    REQUIRE(classify("telemetry") == 0);
+    switch(crypto::fast_hash64("telemetry.frame")) {
+      case "telemetry.frame"_hash64: break;
+      default: FAIL();
+    }
+
+    for(auto len = std::size_t(0); len < 200; len++) {
+      auto const message = std::string(len, static_cast<char>('a' + len % 26));
+      auto hasher = crypto::md5();
+      hasher << message;
+      REQUIRE(crypto::md5_digest(message) == hasher.hash());
+    }
+  }  // Constexpr MD5
+
+  SECTION("CRC") {
+    REQUIRE(crypto::crc32c::compute("") == 0);
+    REQUIRE(crypto::crc32c::compute("123456789") == 0xE3069283);
+    REQUIRE(crypto::crc32c(0xE3069283).hash_string() == "e3069283");
+    REQUIRE(crypto::crc64::compute("123456789") == 0x995DC9BBDF1939FA);
+    REQUIRE(crypto::crc64(0x995DC9BBDF1939FA).hash_string() == "995dc9bbdf1939fa");
+
+    // long enough for the interleaved hardware streams, with unaligned starts
+    auto data = std::string(100'003, '\0');
+    for(auto i = std::size_t(0); i < data.size(); i++)
+      data[i] = static_cast<char>(i * 31 + (i >> 9));
+    auto bytewise32 = ~u32();
+    auto bytewise64 = ~u64();
+    for(auto const c : data) {
+      bytewise32 ^= static_cast<u8>(c);
+      bytewise64 ^= static_cast<u8>(c);
+      for(auto k = 0; k < 8; k++) {
+        bytewise32 = (bytewise32 >> 1) ^ (0x82F63B78U & (0U - (bytewise32 & 1U)));
+        bytewise64 = (bytewise64 >> 1) ^ (0xC96C5795D7870F42ULL & (0ULL - (bytewise64 & 1ULL)));
+      }
+    }
+    auto const view = std::string_view(data);
+    REQUIRE(crypto::crc32c::compute(view) == ~bytewise32);
+    REQUIRE(crypto::crc64::compute(view) == ~bytewise64);
+    REQUIRE(crypto::crc32c::compute(view.substr(3)) == crypto::crc32c::compute(data.substr(3)));
+
+    auto crc32 = crypto::crc32c();
+    auto crc64 = crypto::crc64();
+    auto step = std::size_t(1);
+    for(auto pos = std::size_t(0); pos < data.size(); pos += step, step *= 3) {
+      crc32 << view.substr(pos, step);
+      crc64 << view.substr(pos, step);
+    }
+    REQUIRE(crc32.hash() == ~bytewise32);
+    REQUIRE(crc64.hash() == ~bytewise64);
+    crc32.reset();
+    REQUIRE(crc32.hash() == 0);
+
+    for(auto const split : {std::size_t(0), std::size_t(1), std::size_t(777), data.size()}) {
+      auto const a = view.substr(0, split);
+      auto const b = view.substr(split);
+      auto const crc_a = crypto::crc32c::compute(a);
+      REQUIRE(crypto::crc32c::combine(crc_a, crypto::crc32c::compute(b), b.size()) == ~bytewise32);
+      REQUIRE(crypto::crc64::combine(crypto::crc64::compute(a), crypto::crc64::compute(b), b.size())
+              == ~bytewise64);
+    }
+  }  // CRC
+
+  SECTION("HMAC") {
+    auto const hi_there = crypto::hmac_md5(std::string(16, '\x0b')) << std::string_view("Hi There");
+    REQUIRE(hi_there.hash_string() == "9294727a3638bb1c13f48ef8158bfc9d");
+    REQUIRE(crypto::hmac_sha1("Jefe").append("what do ya want for nothing?").hash_string()
+            == "effcdf6ae5eb2fa2d27416d5f184df9c259a7c79");
+
+    auto const jefe = crypto::hmac_sha256("Jefe");
+    auto mac = jefe;
+    mac << std::string_view("what do ya ") << std::string_view("want for nothing?");
+    REQUIRE(mac.hash_string()
+            == "5bdcc146bf60754e6a042426089575c75a003f089d2739839dec58b964ec3843");
+    REQUIRE(mac.hash() == jefe.sign("what do ya want for nothing?"));
+    REQUIRE(jefe.verify("what do ya want for nothing?", mac.hash()));
+    REQUIRE_FALSE(jefe.verify("what do ya want for nothing!", mac.hash()));
+    mac.reset();
+    REQUIRE(mac.hash() == jefe.sign(""));
+
+    auto long_key = crypto::hmac_sha256(std::string(131, '\xaa'));
+    REQUIRE(long_key.append("Test Using Larger Than Block-Size Key - Hash Key First").hash_string()
+            == "60e431591ee0b67f0d8a26aacbf5b77f8e0bc6213728c5140546040f0ee37f54");
+
+    auto const block = std::string(1000, 'x');
+    auto const packets = std::vector<std::string_view> {"", "a", block, "abc"};
+    auto const tags = jefe.sign_many(packets);
+    REQUIRE(tags.size() == packets.size());
+    for(auto i = std::size_t(0); i < packets.size(); i++)
+      REQUIRE(tags[i] == jefe.sign(packets[i]));
+  }  // HMAC
+
+  SECTION("Prefix fork") {
+    static_assert(std::is_trivially_copyable_v<crypto::md5_engine>);
+    static_assert(std::is_trivially_copyable_v<crypto::sha1_engine>);
+    static_assert(std::is_trivially_copyable_v<crypto::sha256_engine>);
+    static_assert(std::is_trivially_copyable_v<crypto::hmac_sha256>);
+    static_assert(std::is_copy_constructible_v<crypto::md5>);
+
+    auto const header = std::string(200, 'h');
+    auto prefix = crypto::md5();
+    prefix << header;
+    auto prefix_engine = crypto::sha256_engine();
+    prefix_engine << std::string_view(header);
+    auto const records = {"", "a", "record", "a longer record spanning the block boundary....."};
+    for(auto const* record : records) {
+      auto forked = prefix;
+      forked << std::string_view(record);
+      auto fresh = crypto::md5();
+      fresh << header << std::string_view(record);
+      REQUIRE(forked.hash() == fresh.hash());
+
+      auto forked_engine = prefix_engine;
+      forked_engine << std::string_view(record);
+      REQUIRE(forked_engine.hash() == crypto::sha256_engine().append(header + record).hash());
+    }
+    REQUIRE(prefix.hash() == crypto::md5_digest(header));
+    REQUIRE(prefix.engine().hash() == prefix.hash());
+  }  // Prefix fork
+}
+
+TEST_CASE("Crypto per-field hashing", "[.][benchmark][crypto]") {
+  struct record {
+    u32 id;
+    u16 kind;
+    u8 flags;
+    f64 weight;
+  };
+
+  auto records = std::vector<record>();
+  for(auto i = 0U; i < 10'000; i++)
+    records.push_back({i, static_cast<u16>(i % 7), static_cast<u8>(i % 3), i * 0.25});
+
+  BENCHMARK("md5 through basic_hasher") {
+    auto hasher = crypto::md5();
+    auto& erased = static_cast<crypto::basic_hasher&>(hasher);
+    for(auto const& r : records)
+      erased << r.id << r.kind << r.flags << r.weight;
+    return hasher.hash();
+  };
+
+  BENCHMARK("md5_engine through static_hasher") {
+    auto hasher = crypto::md5_engine();
+    for(auto const& r : records)
+      hasher << r.id << r.kind << r.flags << r.weight;
+    return hasher.hash();
+  };
+
+  BENCHMARK("fast_hasher through static_hasher") {
+    auto hasher = crypto::fast_hasher();
+    for(auto const& r : records)
+      hasher << r.id << r.kind << r.flags << r.weight;
+    return hasher.hash();
+  };
 }
@@ -0,0 +1,254 @@
+#include <rll/io/async_file.h>
+#include <rll/io/buffered_file.h>
+#include <rll/io/filedevice.h>
+#include <rll/io/mapped_file.h>
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <catch2/catch_all.hpp>
+
+using namespace rll;
+namespace fs = std::filesystem;
+
+namespace {
+  struct temp_dir {
+    fs::path path = fs::temp_directory_path() / "rll_test_io";
+
+    temp_dir() {
+      fs::remove_all(this->path);
+      fs::create_directories(this->path);
+    }
+
+    ~temp_dir() { fs::remove_all(this->path); }
+  };
+
+  std::string pattern(std::size_t const size) {
+    auto res = std::string(size, '\0');
+    for(auto i = std::size_t(0); i < size; i++)
+      res[i] = static_cast<char>('a' + (i * 7) % 26);
+    return res;
+  }
+}  // namespace
+
+TEST_CASE("IO", "[io]") {
+  auto const dir = temp_dir();
+
+  SECTION("Read") {
+    for(auto const size : {0UL, 1UL, 65'536UL, 1UL << 20U}) {
+      auto const path = dir.path / "read.bin";
+      auto const content = pattern(size);
+      {
+        auto out = std::ofstream(path, std::ios::binary);
+        out << content;
+      }
+      REQUIRE(io::filedevice(path).read() == content);
+      auto const read = io::filedevice::try_read_from(path);
+      REQUIRE(read);
+      REQUIRE(*read == content);
+    }
+    REQUIRE_THROWS(io::filedevice(dir.path / "missing").read());
+    REQUIRE_FALSE(io::filedevice(dir.path / "missing").try_read());
+
+#if defined(__linux__)
+    // reports a size of zero, so it is read in blocks
+    REQUIRE(io::filedevice::read_from("/proc/self/status").find("Name:") == 0);
+#endif
+  }
+
+  SECTION("Map") {
+    auto const path = dir.path / "map.bin";
+    auto const content = pattern(300'000);
+    io::filedevice(path).write(content);
+
+    for(auto const hint : {io::access_hint::normal,
+                           io::access_hint::sequential,
+                           io::access_hint::random,
+                           io::access_hint::will_need}) {
+      auto const file = io::filedevice(path).map(hint);
+      REQUIRE(file);
+      REQUIRE(file->size() == content.size());
+      REQUIRE(file->view() == content);
+      REQUIRE(static_cast<std::size_t>(file->end() - file->begin()) == content.size());
+      file->advise(io::access_hint::random);
+    }
+
+    auto file = io::mapped_file::open(path).value();
+    auto moved = std::move(file);
+    REQUIRE(file.empty());  // NOLINT(*-use-after-move)
+    REQUIRE(moved.view() == content);
+
+    io::filedevice(path).write("");
+    auto const empty = io::filedevice(path).map();
+    REQUIRE(empty);
+    REQUIRE(empty->empty());
+    REQUIRE(empty->view().empty());
+
+    REQUIRE_FALSE(io::filedevice(dir.path / "missing").map());
+  }
+
+  SECTION("Atomic write") {
+    auto const path = dir.path / "nested" / "atomic.txt";
+    for(auto const level : {io::durability::none, io::durability::data, io::durability::full}) {
+      auto const content = pattern(100'000 + static_cast<std::size_t>(level));
+      REQUIRE(io::filedevice::try_write_atomic_to(path, content, level));
+      REQUIRE(io::filedevice::read_from(path) == content);
+    }
+    io::filedevice(path).write_atomic("");
+    REQUIRE(io::filedevice(path).read().empty());
+
+    // only the target is left behind
+    auto entries = std::size_t(0);
+    for([[maybe_unused]] auto const& entry : fs::directory_iterator(path.parent_path()))
+      ++entries;
+    REQUIRE(entries == 1);
+
+    auto const perms = fs::perms::owner_read | fs::perms::owner_write | fs::perms::group_read;
+    fs::permissions(path, perms);
+    REQUIRE(io::filedevice(path).try_write_atomic("kept"));
+    REQUIRE(fs::status(path).permissions() == perms);
+    REQUIRE(io::filedevice(path).read() == "kept");
+
+    auto const created = dir.path / "created.txt";
+    io::filedevice(created).write_atomic("new");
+    REQUIRE(fs::status(created).permissions() == io::filedevice::write_permissions);
+
+    REQUIRE_FALSE(io::filedevice::try_write_atomic_to(path / "file", "x"));
+    REQUIRE_THROWS(io::filedevice::write_atomic_to(dir.path, "x"));
+  }
+
+  SECTION("Async") {
+    auto const path = dir.path / "async.bin";
+    constexpr auto block = std::size_t(4'096);
+    constexpr auto blocks = std::size_t(64);
+    auto const content = pattern(block * blocks);
+
+    for(auto const use_io_uring : {true, false}) {
+      auto options = io::async_options();
+      options.queue_depth = 8;
+      options.io_uring = use_io_uring;
+      fs::remove(path);
+      auto file = io::async_file::open(path, io::open_mode::read_write, options).value();
+      if(not use_io_uring)
+        REQUIRE(file.backend() == io::async_backend::thread_pool);
+
+      // more operations than the queue holds, in one batch
+      auto written = std::atomic<std::size_t>(0);
+      auto batch = std::vector<io::async_file::operation>();
+      for(auto i = std::size_t(0); i < blocks; ++i)
+        batch.push_back(io::async_file::operation::write(
+          i * block,
+          content.data() + i * block,
+          block,
+          [&](result<std::size_t> res) { written += res.value_or(0); }
+        ));
+      REQUIRE(file.submit(std::move(batch)));
+      file.drain();
+      REQUIRE(written == content.size());
+      REQUIRE(file.size().value() == content.size());
+      REQUIRE(io::filedevice::read_from(path) == content);
+
+      auto buffer = std::string(content.size(), '\0');
+      auto read = file.read(0, buffer.data(), buffer.size());
+      REQUIRE(read.get().value() == content.size());
+      REQUIRE(buffer == content);
+
+      // reads stop at the end of the file
+      auto tail = std::string(2 * block, '\0');
+      REQUIRE(file.read(content.size() - block, tail.data(), tail.size()).get().value() == block);
+      REQUIRE(tail.substr(0, block) == content.substr(content.size() - block));
+
+      // callbacks may chain further operations
+      auto chained = std::promise<result<std::size_t>>();
+      REQUIRE(file.write(0, "head", 4, [&](result<std::size_t> const& res) {
+        auto const next = [&](result<std::size_t> r) { chained.set_value(std::move(r)); };
+        if(not res or not file.write(4, "tail", 4, next))
+          chained.set_value(unexpected<std::string>("chained write failed"));
+      }));
+      REQUIRE(chained.get_future().get().value() == 4);
+      file.drain();
+      REQUIRE(io::filedevice::read_from(path).substr(0, 8) == "headtail");
+
+      // registering may fail under a low RLIMIT_MEMLOCK; plain buffers keep working then
+      auto registered = std::string(2 * block, '\0');
+      if(file.register_buffers({{registered.data(), registered.size()}})) {
+        REQUIRE(file.read(block, registered.data() + block, block).get().value() == block);
+        REQUIRE(registered.substr(block) == content.substr(block, block));
+        file.unregister_buffers();
+      }
+    }
+    REQUIRE_FALSE(io::async_file::open(dir.path / "missing", io::open_mode::read));
+  }
+
+  SECTION("Buffered") {
+    auto const path = dir.path / "stream" / "lines.txt";
+    auto options = io::stream_options();
+    options.buffer_size = 4'096;
+    options.drop_behind = true;
+
+    auto lines = std::vector<std::string>();
+    for(auto i = std::size_t(0); i < 2'000; ++i)
+      lines.push_back(pattern(i % 97));
+    lines.push_back(pattern(10'000));  // longer than the buffer
+    lines.emplace_back();
+    lines.push_back("last");
+
+    auto expected = std::string();
+    {
+      auto writer = io::file_writer::open(path, io::write_mode::truncate, options).value();
+      for(auto const& line : lines) {
+        REQUIRE(writer.write(line));
+        REQUIRE(writer.write("\n", 1));
+        expected += line + '\n';
+      }
+      REQUIRE(writer.position() == expected.size());
+      REQUIRE(writer.sync());
+      REQUIRE(writer.close());
+      REQUIRE_FALSE(writer.write("x"));
+    }
+    {
+      auto writer = io::file_writer::open(path, io::write_mode::append, options).value();
+      REQUIRE(writer.position() == expected.size());
+      REQUIRE(writer.write("tail"));
+      expected += "tail";
+    }  // flushed by the destructor
+    REQUIRE(io::filedevice::read_from(path) == expected);
+
+    auto reader = io::file_reader::open(path, options).value();
+    REQUIRE(reader.size().value() == expected.size());
+    auto index = std::size_t(0);
+    while(auto const line = reader.next_line().value()) {
+      auto const& want = index < lines.size() ? lines[index] : std::string("tail");
+      REQUIRE(*line == want);
+      ++index;
+    }
+    REQUIRE(index == lines.size() + 1);
+    REQUIRE(reader.position() == expected.size());
+    REQUIRE(reader.next_chunk().value().empty());
+
+    REQUIRE(reader.seek(0));
+    auto chunks = std::string();
+    while(true) {
+      auto const chunk = reader.next_chunk().value();
+      if(chunk.empty())
+        break;
+      chunks += chunk;
+    }
+    REQUIRE(chunks == expected);
+
+    REQUIRE(reader.seek(10));
+    auto small = std::string(100, '\0');
+    REQUIRE(reader.read_chunk(small.data(), small.size()).value() == small.size());
+    REQUIRE(small == expected.substr(10, 100));
+    REQUIRE(reader.position() == 110);
+    auto rest = std::string(expected.size(), '\0');
+    REQUIRE(reader.read_chunk(rest.data(), rest.size()).value() == expected.size() - 110);
+    REQUIRE(rest.substr(0, expected.size() - 110) == expected.substr(110));
+
+    REQUIRE_FALSE(io::file_reader::open(dir.path / "missing"));
+  }
+}
@@ -173,5 +173,34 @@ TEST_CASE("Serialization & filesystem") {
 
       fs::remove_all(fs::current_path() / "test-save");
     }
+
+    SECTION("Dirty tracking") {
+      {
+        auto save =
+          savefile<format::toml, DummyConfiguration>("test.toml", fs::current_path() / "test-save");
+        REQUIRE(save.valid());
+        REQUIRE_FALSE(save.dirty());
+
+        // unchanged values are not written again
+        fs::remove(save.backing_path());
+        REQUIRE(save.save());
+        REQUIRE_FALSE(save.has_backup());
+
+        save().test = 7;
+        REQUIRE(save.dirty());
+        REQUIRE(save.save());
+        REQUIRE(save.has_backup());
+        REQUIRE_FALSE(save.dirty());
+        save().test = 8;
+      }
+      {
+        auto save =
+          savefile<format::toml, DummyConfiguration>("test.toml", fs::current_path() / "test-save");
+        REQUIRE(save().test == 8);
+        REQUIRE_FALSE(save.dirty());
+      }
+
+      fs::remove_all(fs::current_path() / "test-save");
+    }
   }
 }
@@ -0,0 +1,280 @@
+#include <rll/io/filedevice.h>
+#include <rll/string_pool.h>
+#include <rll/string_util.h>
+
+#include <filesystem>
+#include <iterator>
+#include <list>
+#include <memory_resource>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+#include <catch2/catch_all.hpp>
+
+using namespace rll;
+using namespace std::string_view_literals;
+
+namespace {
+  template <typename Range>
+  std::vector<std::string_view> collect(Range const& range) {
+    return {range.begin(), range.end()};
+  }
+}  // namespace
+
+TEST_CASE("String", "[string]") {
+  SECTION("Split view") {
+    using tokens = std::vector<std::string_view>;
+    REQUIRE(collect(split_view("a,b,c", ',')) == tokens {"a", "b", "c"});
+    REQUIRE(collect(split_view("a,,b", ',')) == tokens {"a", "", "b"});
+    REQUIRE(collect(split_view(",a", ',')) == tokens {"", "a"});
+    REQUIRE(collect(split_view("a,b,", ',')) == tokens {"a", "b"});
+    REQUIRE(collect(split_view(",", ',')) == tokens {""});
+    REQUIRE(collect(split_view("abc", ',')) == tokens {"abc"});
+    REQUIRE(collect(split_view("", ',')).empty());
+
+    auto const input = "ts;lat;lon"sv;
+    for(auto const token : split_view(input, ';')) {
+      REQUIRE(token.data() >= input.data());
+      REQUIRE(token.data() + token.size() <= input.data() + input.size());
+    }
+
+    REQUIRE(collect(whitespace_split_view("  a b\t\tc\n")) == tokens {"a", "b", "c"});
+    REQUIRE(collect(whitespace_split_view("word")) == tokens {"word"});
+    REQUIRE(collect(whitespace_split_view(" \r\n\v\f ")).empty());
+    REQUIRE(collect(whitespace_split_view("")).empty());
+  }
+
+  SECTION("Scan") {
+    // lengths around the vector widths, with matches in the vector body and in the tail
+    auto text = std::string();
+    for(auto i = 0; i < 300; i++)
+      text.push_back("ab c,d;\nefgh\t\x80ijk"[(i * 7) % 18]);
+    for(auto const set : {","sv, ",;"sv, " \t\n"sv, "\x80\xff"sv, "0123456789:;<=>?@"sv, "#"sv}) {
+      for(auto const size : {0, 1, 15, 16, 17, 31, 32, 33, 63, 64, 65, 300}) {
+        auto const input = std::string_view(text).substr(0, static_cast<std::size_t>(size));
+        for(auto const pos : {std::size_t(0), std::size_t(5), input.size(), input.size() + 1})
+          REQUIRE(find_first_of(input, set, pos) == input.find_first_of(set, pos));
+      }
+    }
+
+    auto lines = std::string();
+    for(auto i = 0; i < 5000; i++)
+      lines += std::string(static_cast<std::size_t>(i % 97), 'x') + '\n';
+    lines += "tail";
+    auto expected = std::vector<std::size_t>();
+    for(auto i = std::size_t(0); i < lines.size(); i++)
+      if(lines[i] == '\n')
+        expected.push_back(i);
+    REQUIRE(count(lines, '\n') == expected.size());
+    REQUIRE(count(lines, 'x') == lines.size() - expected.size() - 4);
+    REQUIRE(count("", '\n') == 0);
+    REQUIRE(line_offsets(lines) == expected);
+    REQUIRE(line_offsets(lines, 0) == expected);
+    REQUIRE(line_offsets("").empty());
+
+    // large enough to be split, with newlines on and next to the slice boundaries
+    auto big = std::string((std::size_t(4) << 20U) + 123, 'y');
+    for(auto i = std::size_t(0); i < big.size(); i += 4'099)
+      big[i] = '\n';
+    for(auto threads = std::size_t(2); threads <= 8; threads++) {
+      auto const slice = (big.size() + threads - 1) / threads;
+      for(auto t = std::size_t(1); t < threads; t++)
+        for(auto const at : {t * slice - 2, t * slice - 1, t * slice + 1})
+          big[at] = '\n';
+    }
+    auto const single = line_offsets(big, 1);
+    auto big_expected = std::vector<std::size_t>();
+    for(auto i = std::size_t(0); i < big.size(); i++)
+      if(big[i] == '\n')
+        big_expected.push_back(i);
+    REQUIRE(single == big_expected);
+    REQUIRE(line_offsets(big, 4) == single);
+    REQUIRE(line_offsets(big, 3) == single);
+    REQUIRE(line_offsets(big, 0) == single);
+  }
+
+  SECTION("Case") {
+    auto all = std::string();
+    for(auto i = 0; i < 256; i++)
+      all.push_back(static_cast<char>(i));
+    auto lower = all;
+    auto upper = all;
+    for(auto& c : lower)
+      c = c >= 'A' and c <= 'Z' ? static_cast<char>(c + 32) : c;
+    for(auto& c : upper)
+      c = c >= 'a' and c <= 'z' ? static_cast<char>(c - 32) : c;
+    for(auto const size : {0, 1, 15, 16, 17, 31, 32, 33, 65, 100, 256}) {
+      auto const n = static_cast<std::size_t>(size);
+      auto const input = std::string_view(all).substr(256 - n);
+      REQUIRE(to_lower(input) == std::string_view(lower).substr(256 - n));
+      REQUIRE(to_upper(input) == std::string_view(upper).substr(256 - n));
+
+      auto buffer = std::string(input);
+      to_lower_in_place(buffer);
+      REQUIRE(buffer == std::string_view(lower).substr(256 - n));
+      to_upper_in_place(buffer);
+      REQUIRE(buffer == std::string_view(upper).substr(256 - n));
+      REQUIRE(to_lower(input, buffer.data()) == buffer.data() + n);
+      REQUIRE(buffer == std::string_view(lower).substr(256 - n));
+
+      REQUIRE(iequals(lower.substr(256 - n), upper.substr(256 - n)));
+      REQUIRE(ihash()(lower.substr(256 - n)) == ihash()(upper.substr(256 - n)));
+      if(n > 0) {
+        // a difference in any position, including case-like pairs that are not letters
+        for(auto const at : {std::size_t(0), n / 2, n - 1}) {
+          auto other = upper.substr(256 - n);
+          other[at] = static_cast<char>(other[at] ^ 0x20);
+          auto const letter = (other[at] | 0x20) >= 'a' and (other[at] | 0x20) <= 'z';
+          REQUIRE(iequals(lower.substr(256 - n), other) == letter);
+        }
+      }
+    }
+    REQUIRE(iequals("Content-Length", "content-length"));
+    REQUIRE_FALSE(iequals("Content-Length", "content-length "));
+    REQUIRE_FALSE(iequals("@", "`"));
+    REQUIRE(iequal_to()("KEEP-ALIVE", "keep-alive"));
+    REQUIRE(ihash()("GET") != ihash()("PUT"));
+  }
+
+  SECTION("Pool") {
+    auto pool = string_pool();
+    auto const unit = pool.intern("m/s");
+    REQUIRE(unit.view() == "m/s");
+    REQUIRE(std::string_view(unit.c_str()) == "m/s");
+    REQUIRE(unit == pool.intern(std::string("m/s")));
+    REQUIRE(unit != pool.intern("m/s2"));
+    REQUIRE(pool.at(unit.id()) == unit);
+    REQUIRE(pool.find("m/s") == unit);
+    REQUIRE_FALSE(pool.find("km/h").has_value());
+    REQUIRE(pool.size() == 2);
+    REQUIRE_THROWS_AS(pool.at(0xFFFFFFF0U), std::out_of_range);
+
+    REQUIRE(pool.intern("") == interned_string());
+    REQUIRE(pool.intern("").empty());
+    REQUIRE(interned_string().view().empty());
+    REQUIRE(interned_string().id() == 0);
+    REQUIRE(pool.at(0) == interned_string());
+    REQUIRE(fmt::format("{}", unit) == "m/s");
+
+    auto other = string_pool();
+    REQUIRE(other.intern("m/s") != unit);
+
+    // strings stay in place while the pool grows, and a long one gets a block of its own
+    auto const long_name = std::string(200'000, 'x');
+    REQUIRE(pool.intern(long_name).view() == long_name);
+    for(auto i = 0; i < 20'000; i++)
+      static_cast<void>(pool.intern(fmt::format("sensor-{}", i)));
+    REQUIRE(pool.intern("m/s") == unit);
+    REQUIRE(unit.view() == "m/s");
+    REQUIRE(pool.size() == 20'003);
+    REQUIRE(pool.memory_usage() >= long_name.size());
+
+    // concurrent inserts of overlapping names give a single copy of every name
+    auto shared = string_pool();
+    auto results = std::vector<std::vector<interned_string>>(4);
+    auto threads = std::vector<std::thread>();
+    for(auto t = std::size_t(0); t < results.size(); t++)
+      threads.emplace_back([&, t] {
+        for(auto i = 0; i < 5000; i++)
+          results[t].push_back(shared.intern(fmt::format("channel-{}", (i * (t + 1)) % 3000)));
+      });
+    for(auto& thread : threads)
+      thread.join();
+    REQUIRE(shared.size() == 3000);
+    auto ids = std::unordered_set<u32>();
+    for(auto i = 0; i < 3000; i++) {
+      auto const name = shared.find(fmt::format("channel-{}", i));
+      REQUIRE(name.has_value());
+      REQUIRE(shared.at(name->id()) == *name);
+      ids.insert(name->id());
+    }
+    REQUIRE(ids.size() == 3000);
+    for(auto const& result : results)
+      for(auto const name : result)
+        REQUIRE(shared.find(name.view()) == name);
+  }
+
+  SECTION("Builder") {
+    auto row = string_builder();
+    REQUIRE(row.empty());
+    row.append("ts").append(',').append(3, '-') += "x";
+    row += ';';
+    REQUIRE(row.view() == "ts,---x;");
+    row.format_to("{}|{:.2f}|{:>4}", 42, 1.5, "ab");
+    REQUIRE(row.str() == "ts,---x;42|1.50|  ab");
+
+    row.clear();
+    REQUIRE(row.empty());
+    auto const fields = std::vector<std::string> {"sensor-1", "21.5", "", "m/s"};
+    REQUIRE(row.join(fields, ",").view() == "sensor-1,21.5,,m/s");
+    REQUIRE(row.capacity() >= row.size());
+    row.clear();
+    REQUIRE(row.join(std::vector<int> {1, 2, 3}, ", ").view() == "1, 2, 3");
+    row.clear();
+    REQUIRE(row.join(std::vector<std::string_view>(), ",").empty());
+    REQUIRE(row.join(split_view("a;b;c", ';'), "+").view() == "a+b+c");
+
+    // grows past the inline capacity and stays usable after clear
+    row.clear();
+    for(auto i = 0; i < 1000; i++)
+      row.format_to("{},", i);
+    REQUIRE(row.size() == 3890);
+    REQUIRE(row.view().substr(0, 8) == "0,1,2,3,");
+    auto const capacity = row.capacity();
+    row.clear();
+    row += "again";
+    REQUIRE(row.view() == "again");
+    REQUIRE(row.capacity() == capacity);
+
+    // caller-provided arena
+    auto arena = std::pmr::monotonic_buffer_resource();
+    auto pooled = basic_string_builder<std::pmr::polymorphic_allocator<char>>(&arena);
+    pooled.append(std::string(2000, 'z'));
+    REQUIRE(pooled.size() == 2000);
+
+    REQUIRE(join(fields, ", ") == "sensor-1, 21.5, , m/s");
+    REQUIRE(join(std::list<char const*> {"a", "b"}, "") == "ab");
+    REQUIRE(join(std::vector<std::string>(), ",").empty());
+    REQUIRE(join(std::vector<double> {0.5, 2}, ";") == "0.5;2");
+
+    auto const path = std::filesystem::temp_directory_path() / "rll_string_builder.csv";
+    row.clear();
+    row.join(fields, ",").append('\n');
+    io::filedevice(path).write(row);
+    REQUIRE(io::filedevice(path).read() == "sensor-1,21.5,,m/s\n");
+    std::filesystem::remove(path);
+  }
+
+  SECTION("Split") {
+    // same results as the stream-based extraction the functions used to do
+    auto const inputs = std::vector<std::string> {
+      "",
+      ",",
+      ",,",
+      "a",
+      "a,",
+      ",a",
+      " a, b ,c,, d ",
+      "1.5,2.5\n3.5,\t4.5\n",
+      "\tx  y\n\nz ",
+    };
+    for(auto const& input : inputs) {
+      auto stream = std::istringstream(input);
+      auto const words =
+        std::vector<std::string>(std::istream_iterator<std::string>(stream), {});
+      REQUIRE(split(input) == words);
+      REQUIRE(split(std::string_view(input)) == words);
+
+      auto fields = std::vector<std::string>();
+      auto field = std::string();
+      auto field_stream = std::istringstream(input);
+      while(std::getline(field_stream, field, ','))
+        fields.push_back(field);
+      REQUIRE(split_by(input, ',') == fields);
+      REQUIRE(split_by(std::string_view(input), ',') == fields);
+    }
+  }
+}
@@ -1,14 +1,22 @@
 #include <rll/all.h>
 
+#include <cstring>
 #include <sstream>
 #include <type_traits>
 #include <vector>
 #include <string>
 #include <numeric>
+#include <map>
+#include <set>
 #include <iomanip>
 #include <catch2/catch_all.hpp>
 #include <catch2/catch_test_macros.hpp>
 
+#if not defined(RLL_OS_WINDOWS)
+#  include <sys/wait.h>
+#  include <unistd.h>
+#endif
+
 using namespace rll;
 using Catch::Matchers::WithinRel;
 using Catch::Matchers::WithinAbs;
@@ -388,6 +396,67 @@ TEST_CASE("Types", "[types]") {
     }
   }  // Fixed string
 
+  SECTION("Inline string") {
+    static_assert(std::is_trivially_copyable_v<inline_string<15>>);
+    static_assert(sizeof(inline_string<15>) == 17);
+    static_assert(sizeof(inline_string<300>) == 304);
+    static_assert(std::has_unique_object_representations_v<inline_string<15>>);
+    static_assert(std::has_unique_object_representations_v<inline_string<256>>);
+    static_assert(std::has_unique_object_representations_v<inline_string<70'000>>);
+
+    constexpr auto literal = inline_string<8>("abc");
+    static_assert(literal.size() == 3 and literal == "abc");
+    constexpr auto deduced = inline_string("sensor");
+    static_assert(deduced.capacity() == 6);
+    constexpr inline_string none = "";
+    static_assert(none.empty() and none.capacity() == 0);
+
+    auto str = inline_string<8>();
+    REQUIRE(str.empty());
+    REQUIRE(str.c_str()[0] == '\0');
+    str += "temp";
+    str += '-';
+    str.append("01");
+    REQUIRE(str == "temp-01");
+    REQUIRE(str.view() == "temp-01");
+    REQUIRE(std::string_view(str.c_str()) == "temp-01");
+    REQUIRE(str.back() == '1');
+    REQUIRE_THROWS_AS(str.append("xx"), std::length_error);
+    REQUIRE(str == "temp-01");
+    str.push_back('x');
+    REQUIRE(str.size() == 8);
+    REQUIRE_THROWS_AS(str.push_back('y'), std::length_error);
+    str.pop_back();
+    REQUIRE(str == "temp-01");
+    REQUIRE_THROWS_AS(str.assign("too long for it"), std::length_error);
+    REQUIRE_THROWS_AS(inline_string<2>(std::string_view("abc")), std::length_error);
+
+    // the bytes past the end stay zero, so equal strings are bitwise equal
+    str.assign("rh");
+    auto const fresh = inline_string<8>(std::string_view("rh"));
+    REQUIRE(std::memcmp(&str, &fresh, sizeof(str)) == 0);
+    auto copy = inline_string<8>();
+    std::memcpy(&copy, &str, sizeof(str));
+    REQUIRE(copy == str);
+    str.clear();
+    auto const empty = inline_string<8>();
+    REQUIRE(std::memcmp(&str, &empty, sizeof(str)) == 0);
+
+    REQUIRE(inline_string<4>("ab") == inline_string<16>("ab"));
+    REQUIRE(inline_string<4>("ab") < inline_string<16>("abc"));
+    REQUIRE(inline_string<4>("b") > inline_string<16>("abc"));
+    REQUIRE(inline_string<4>("ab") != std::string("abc"));
+    REQUIRE(inline_string<4>("ab").compare("ab") == 0);
+    REQUIRE(std::hash<inline_string<16>>()("sensor") == std::hash<fixed_string<6>>()("sensor"));
+    REQUIRE(fmt::format("{:>5}", inline_string<4>("ab")) == "   ab");
+
+    auto a = inline_string<8>("left");
+    auto b = inline_string<8>("right");
+    a.swap(b);
+    REQUIRE(a == "right");
+    REQUIRE(b == "left");
+  }  // Inline string
+
   SECTION("U128") {
     SECTION("Constexpr") {
       constexpr u128 value1 = {1, 0};
@@ -927,6 +996,75 @@ TEST_CASE("Types", "[types]") {
       REQUIRE(r1 != r2);
       REQUIRE(r1 != r3);
       REQUIRE(r2 != r3);
+      REQUIRE(r1.bytes()[6] >> 4 == 4);
+      REQUIRE((r1.bytes()[8] & 0xC0) == 0x80);
+    }
+
+    SECTION("Generator") {
+      // the first ChaCha20 block for an all-zero key is the RFC 8439 test vector 76b8e0ad...
+      auto seeded = uuid_generator(std::array<u8, 32>());
+      REQUIRE(seeded() == "76b8e0ad-a0f1-4d90-805d-6ae55386bd28"_uuid);
+
+      auto a = uuid_generator(std::array<u8, 32> {1});
+      auto b = uuid_generator(std::array<u8, 32> {1});
+      auto one_by_one = std::vector<uuid>();
+      for(auto i = 0; i < 100; i++)
+        one_by_one.push_back(a());
+      auto batch = std::vector<uuid>(3);
+      b.generate_n(batch.data(), batch.size());
+      auto const rest = b.generate_n(97);
+      batch.insert(batch.end(), rest.begin(), rest.end());
+      REQUIRE(batch == one_by_one);
+
+      auto const ids = uuid_generator::local().generate_n(1000);
+      auto const unique = std::set<uuid>(ids.begin(), ids.end());
+      REQUIRE(unique.size() == ids.size());
+      for(auto const& id : ids) {
+        REQUIRE(id.bytes()[6] >> 4 == 4);
+        REQUIRE((id.bytes()[8] & 0xC0) == 0x80);
+      }
+
+#if not defined(RLL_OS_WINDOWS)
+      auto pipe_fds = std::array<int, 2>();
+      REQUIRE(::pipe(pipe_fds.data()) == 0);
+      static_cast<void>(uuid::random());
+      auto const pid = ::fork();
+      REQUIRE(pid >= 0);
+      if(pid == 0) {
+        auto const child = uuid::random();
+        auto const written = ::write(pipe_fds[1], child.bytes().data(), child.bytes().size());
+        ::_exit(written == 16 ? 0 : 1);
+      }
+      auto const parent = uuid::random();
+      auto child = uuid();
+      REQUIRE(::read(pipe_fds[0], child.bytes_mut().data(), 16) == 16);
+      auto status = 0;
+      ::waitpid(pid, &status, 0);
+      ::close(pipe_fds[0]);
+      ::close(pipe_fds[1]);
+      REQUIRE(child.valid());
+      REQUIRE(child != parent);
+#endif
+    }
+
+    SECTION("V7") {
+      auto const example = "017f22e2-79b0-7cc3-98c4-dc0c0c07398f"_uuid;
+      REQUIRE(example.version() == 7);
+      REQUIRE(example.timestamp().time_since_epoch() == std::chrono::milliseconds(1645557742000));
+
+      auto const before = std::chrono::system_clock::now();
+      auto ids = std::vector<uuid>();
+      for(auto i = 0; i < 10'000; i++)
+        ids.push_back(uuid::v7());
+      auto const after = std::chrono::system_clock::now();
+      for(auto i = std::size_t(1); i < ids.size(); i++)
+        REQUIRE(ids[i - 1] < ids[i]);
+      for(auto const& id : {ids.front(), ids.back()}) {
+        REQUIRE(id.version() == 7);
+        REQUIRE((id.bytes()[8] & 0xC0) == 0x80);
+        REQUIRE(id.timestamp() >= std::chrono::time_point_cast<std::chrono::milliseconds>(before));
+        REQUIRE(id.timestamp() <= after);
+      }
     }
 
     auto const s1 = uuid("7bcd757f-5b10-4f9b-af69-1a1f226f3b3e");
@@ -953,6 +1091,119 @@ TEST_CASE("Types", "[types]") {
 
     SECTION("Format") { REQUIRE(fmt::format("{}", s1) == "7bcd757f-5b10-4f9b-af69-1a1f226f3b3e"); }
 
+    SECTION("Chars") {
+      char buf[uuid::short_guid_string_length + 1] = {};
+      REQUIRE(s1.to_chars(buf) == buf + uuid::short_guid_string_length);
+      REQUIRE(std::string_view(buf) == "7bcd757f-5b10-4f9b-af69-1a1f226f3b3e");
+      REQUIRE(uuid::empty().to_string() == "00000000-0000-0000-0000-000000000000");
+      REQUIRE(fmt::format("{:>37}", s1) == " 7bcd757f-5b10-4f9b-af69-1a1f226f3b3e");
+
+      auto parsed = uuid();
+      REQUIRE(uuid::from_chars("7BCD757F-5B10-4F9B-AF69-1A1F226F3B3E", parsed));
+      REQUIRE(parsed == s1);
+      REQUIRE(uuid::from_chars("{16d1bd03-09a5-47d3-944b-5e326fd52d27}", parsed));
+      REQUIRE(parsed == s2);
+      REQUIRE_FALSE(uuid::from_chars("7bcd757f-5b10-4f9b-af69-1a1f226f3b3", parsed));
+      REQUIRE_FALSE(uuid::from_chars("7bcd757f-5b10-4f9b-af69-1a1f226f3b3g", parsed));
+      REQUIRE_FALSE(uuid::from_chars("7bcd757f-5b10-4f9b-af69_1a1f226f3b3e", parsed));
+      REQUIRE_FALSE(uuid::from_chars("(7bcd757f-5b10-4f9b-af69-1a1f226f3b3e)", parsed));
+      REQUIRE(parsed == s2);
+      REQUIRE(uuid::try_parse("fdaba646-e07e-49de-9529-4499a5580c75").value() == s3);
+      REQUIRE_FALSE(uuid::try_parse("fdaba646-e07e-49de-9529-4499a5580c7"));
+
+      // every generated id round-trips through the batch functions, whatever the count
+      auto gen = uuid_generator(std::array<u8, 32>());
+      for(auto const count : {0, 1, 2, 7, 64}) {
+        auto const ids = gen.generate_n(static_cast<std::size_t>(count));
+        auto text = std::string(ids.size() * 37, ',');
+        uuid::to_chars_n(ids.data(), ids.size(), text.data(), 37);
+        for(auto i = std::size_t(0); i < ids.size(); i++) {
+          REQUIRE(text.substr(i * 37, 36) == ids[i].to_string());
+          REQUIRE(text[i * 37 + 36] == ',');
+        }
+        auto back = std::vector<uuid>(ids.size());
+        REQUIRE(uuid::from_chars_n(text.data(), ids.size(), back.data(), 37) == ids.size());
+        REQUIRE(back == ids);
+        if(ids.size() > 1) {
+          text[37 + 20] = 'x';
+          REQUIRE(uuid::from_chars_n(text.data(), ids.size(), back.data(), 37) == 1);
+        }
+      }
+    }
+
+    SECTION("Hash") {
+      // every byte takes part in the hash
+      auto hashes = std::set<std::size_t>();
+      for(auto i = std::size_t(0); i < 16; i++) {
+        auto id = uuid();
+        id.bytes_mut()[i] = 1;
+        hashes.insert(std::hash<uuid>()(id));
+      }
+      REQUIRE(hashes.size() == 16);
+      REQUIRE(std::hash<uuid>()(s1) == std::hash<uuid>()(s4));
+      REQUIRE(s1.to_u64() != s5.to_u64());
+    }
+
+    SECTION("Map") {
+      auto map = uuid_map<std::string>();
+      REQUIRE(map.empty());
+      REQUIRE(map.find(s1) == map.end());
+      map[s1] = "one";
+      REQUIRE(map.try_emplace(s2, "two").second);
+      REQUIRE_FALSE(map.try_emplace(s2, "zwei").second);
+      REQUIRE_FALSE(map.insert_or_assign(s2, "deux").second);
+      REQUIRE(map.size() == 2);
+      REQUIRE(map.at(s1) == "one");
+      REQUIRE(map.at(s2) == "deux");
+      REQUIRE(map.contains(s4));
+      REQUIRE_FALSE(map.contains(s3));
+      REQUIRE_THROWS_AS(map.at(s3), std::out_of_range);
+
+      // random inserts and erases agree with std::map, also across growth and copies
+      auto gen = uuid_generator(std::array<u8, 32>());
+      auto const keys = gen.generate_n(3000);
+      auto table = uuid_map<std::size_t>();
+      auto reference = std::map<uuid, std::size_t>();
+      for(auto i = std::size_t(0); i < 20'000; i++) {
+        auto const& key = keys[(i * 7919) % (i < 10'000 ? keys.size() : 500)];
+        if(i % 3 == 0)
+          REQUIRE(table.erase(key) == reference.erase(key));
+        else {
+          table[key] += i;
+          reference[key] += i;
+        }
+      }
+      auto const copy = table;
+      REQUIRE(copy.size() == reference.size());
+      for(auto const& [key, value] : reference)
+        REQUIRE(copy.at(key) == value);
+      auto visited = std::size_t(0);
+      for(auto const& [key, value] : copy) {
+        REQUIRE(reference.at(key) == value);
+        visited++;
+      }
+      REQUIRE(visited == reference.size());
+
+      for(auto it = table.begin(); it != table.end();)
+        it = (it->second % 2 == 0) ? table.erase(it) : std::next(it);
+      for(auto const& [key, value] : reference)
+        REQUIRE(table.contains(key) == (value % 2 == 1));
+      table.clear();
+      REQUIRE(table.empty());
+      REQUIRE(table.begin() == table.end());
+    }
+
+    SECTION("Set") {
+      auto set = uuid_set {s1, s2, s4};
+      REQUIRE(set.size() == 2);
+      REQUIRE(set.contains(s1));
+      REQUIRE_FALSE(set.insert(s2).second);
+      REQUIRE(set.insert(s3).second);
+      REQUIRE(set.erase(s1) == 1);
+      REQUIRE(set.count(s1) == 0);
+      REQUIRE(*set.find(s3) == s3);
+    }
+
     SECTION("ParseFail") { REQUIRE_THROWS(uuid("7bcd757f-5b10-4f9b-af69-1a1f226f3baskdfmsadf3e")); }
 
     SECTION("Literal") { REQUIRE(s1 == "7bcd757f-5b10-4f9b-af69-1a1f226f3b3e"_uuid); }